@@ -36,7 +36,7 @@ public:
     std::vector<std::string> tables;
     // update 的set 值
     std::vector<SetClause> set_clauses;
-    //insert 的values值
+    //insert 的values值，多行时按行依次存放
     std::vector<Value> values;
 
     Query() {
@@ -0,0 +1,100 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "common/config.h"
+
+/*
+Arena是语句级的bump分配器：从固定大小的内存块中顺序分配，不支持单独释放，Arena析构时一次性释放所有内存块。
+mark()记录当前的分配位置，rewind()回到该位置，之后分配的内存可以被重新使用，内存块本身保留下来继续使用。
+rewind要求按栈的顺序进行：回到某个位置时，该位置之后分配的内存都不能再被使用。
+Arena不是线程安全的，每条语句的Context持有一个。
+*/
+class Arena {
+   public:
+    struct Mark {
+        size_t chunk;   // 当前内存块的下标
+        size_t offset;  // 当前内存块中已分配的字节数
+    };
+
+    explicit Arena(size_t chunk_size = ARENA_CHUNK_SIZE) : chunk_size_(chunk_size) {}
+
+    Arena(const Arena &) = delete;
+    Arena &operator=(const Arena &) = delete;
+
+    /**
+     * @description: 分配size字节的内存，内容未初始化
+     * @return {char*} 分配的内存的首地址，在Arena析构或rewind到更早的位置之前有效
+     * @param {size_t} size 分配的字节数
+     * @param {size_t} align 对齐要求，不能超过alignof(std::max_align_t)
+     */
+    char *allocate(size_t size, size_t align = alignof(std::max_align_t)) {
+        size_t begin = (offset_ + align - 1) & ~(align - 1);
+        if (cur_ >= chunks_.size() || begin + size > chunks_[cur_].size) {
+            // 当前内存块放不下，使用下一个内存块；下一个内存块不够大或者不存在时插入一个新的
+            size_t next = chunks_.empty() ? 0 : cur_ + 1;
+            if (next >= chunks_.size() || chunks_[next].size < size) {
+                size_t chunk_size = std::max(chunk_size_, size);
+                chunks_.insert(chunks_.begin() + next, Chunk{std::unique_ptr<char[]>(new char[chunk_size]), chunk_size});
+                bytes_reserved_ += chunk_size;
+            }
+            cur_ = next;
+            begin = 0;
+        }
+        offset_ = begin + size;
+        return chunks_[cur_].data.get() + begin;
+    }
+
+    Mark mark() const { return Mark{cur_, offset_}; }
+
+    void rewind(const Mark &mark) {
+        cur_ = mark.chunk;
+        offset_ = mark.offset;
+    }
+
+    /* 回到最开始的位置，保留已申请的内存块 */
+    void reset() { rewind(Mark{0, 0}); }
+
+    /* 已经向系统申请的内存总量 */
+    size_t bytes_reserved() const { return bytes_reserved_; }
+
+   private:
+    struct Chunk {
+        std::unique_ptr<char[]> data;
+        size_t size;
+    };
+
+    size_t chunk_size_;
+    std::vector<Chunk> chunks_;
+    size_t cur_ = 0;            // 正在分配的内存块
+    size_t offset_ = 0;         // 当前内存块中已分配的字节数
+    size_t bytes_reserved_ = 0;
+};
+
+/* 作用域结束时将Arena回退到作用域开始时的位置，用于逐行处理时复用同一段内存 */
+class ArenaScope {
+   public:
+    explicit ArenaScope(Arena &arena) : arena_(arena), mark_(arena.mark()) {}
+
+    ~ArenaScope() { arena_.rewind(mark_); }
+
+    ArenaScope(const ArenaScope &) = delete;
+    ArenaScope &operator=(const ArenaScope &) = delete;
+
+   private:
+    Arena &arena_;
+    Arena::Mark mark_;
+};
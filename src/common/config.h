@@ -23,19 +23,29 @@ extern std::chrono::milliseconds cycle_detection_interval;
 /** True if logging should be enabled, false otherwise. */
 extern std::atomic<bool> enable_logging;
 
-/** If ENABLE_LOGGING is true, the log should be flushed to disk every LOG_TIMEOUT. */
-extern std::chrono::duration<int64_t> log_timeout;
+/** Group commit: after the first commit asks for a flush, the log flusher waits up to LOG_TIMEOUT for more commits. */
+extern std::chrono::microseconds log_timeout;
+
+/** Group commit: the log flusher stops waiting once this many commits are waiting, defaults to GROUP_COMMIT_BATCH_SIZE. */
+extern size_t group_commit_batch_size;
 
 static constexpr int INVALID_FRAME_ID = -1;                                   // invalid frame id
 static constexpr int INVALID_PAGE_ID = -1;                                    // invalid page id
 static constexpr int INVALID_TXN_ID = -1;                                     // invalid transaction id
 static constexpr int INVALID_TIMESTAMP = -1;                                  // invalid transaction timestamp
 static constexpr int INVALID_LSN = -1;                                        // invalid log sequence number
+static constexpr int INVALID_OID = 0;                                         // invalid object id, valid ones start at 1
 static constexpr int HEADER_PAGE_ID = 0;                                      // the header page id
 static constexpr int PAGE_SIZE = 4096;                                        // size of a data page in byte  4KB
 static constexpr int BUFFER_POOL_SIZE = 65536;                                // size of buffer pool 256MB
 // static constexpr int BUFFER_POOL_SIZE = 262144;                                // size of buffer pool 1GB
+// the buffer pool size can be changed at startup or by SET buffer_pool_size, up to BUFFER_POOL_MAX_SIZE frames;
+// only address space is reserved for the frames beyond the current size
+static constexpr size_t BUFFER_POOL_MAX_SIZE = 16777216;                       // 64GB
+static constexpr int BUFFER_POOL_RESIZE_TIMEOUT_MS = 1000;                     // shrinking gives up on frames still pinned by then
+static constexpr int BUFFER_POOL_PARTITIONS = 16;                             // number of buffer pool partitions
 static constexpr int LOG_BUFFER_SIZE = (1024 * PAGE_SIZE);                    // size of a log buffer in byte
+static constexpr size_t GROUP_COMMIT_BATCH_SIZE = 32;                          // default of group_commit_batch_size
 static constexpr int BUCKET_SIZE = 50;                                        // size of extendible hash bucket
 
 using frame_id_t = int32_t;  // frame id type, 帧页ID, 页在BufferPool中的存储单元称为帧,一帧对应一页
@@ -49,7 +59,48 @@ using timestamp_t = int32_t;  // timestamp type, used for transaction concurrenc
 // log file
 static const std::string LOG_FILE_NAME = "db.log";
 
-// replacer
-static const std::string REPLACER_TYPE = "LRU";
+// replacer, one of "LRU", "LRU-K", "CLOCK"
+static const std::string REPLACER_TYPE = "LRU-K";
+
+// page data of the buffer pool lives in one PAGE_SIZE-aligned arena, backed by one of
+// "none": normal pages, "thp": transparent huge pages (madvise MADV_HUGEPAGE),
+// "hugetlb": MAP_HUGETLB, reserves the whole arena up to the max pool size and falls back to "thp" when
+// not enough huge pages are configured in /proc/sys/vm/nr_hugepages
+static const std::string BUFFER_POOL_HUGE_PAGES = "thp";
+static constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+static constexpr size_t LRUK_REPLACER_K = 2;                                 // K of the LRU-K replacer
+
+// async I/O engine, one of "io_uring", "thread_pool", "none"; falls back to "thread_pool" if io_uring is unavailable
+static const std::string ASYNC_IO_ENGINE = "io_uring";
+static constexpr size_t ASYNC_IO_QUEUE_DEPTH = 64;                           // max number of in-flight async page I/Os
+static constexpr size_t ASYNC_IO_THREADS = 4;                                // worker threads of the thread pool engine
+
+// background flusher: keeps FLUSHER_CLEAN_TARGET frames at the eviction end of the buffer pool clean
+static constexpr size_t FLUSHER_CLEAN_TARGET = 4096;
+static constexpr int FLUSHER_INTERVAL_MS = 10;                               // the flusher runs every FLUSHER_INTERVAL_MS ms
+
+// sequential read-ahead: the window starts at READ_AHEAD_MIN_PAGES and doubles up to READ_AHEAD_MAX_PAGES
+static constexpr int READ_AHEAD_MIN_PAGES = 4;
+static constexpr int READ_AHEAD_MAX_PAGES = 64;
+
+// ring buffers of the bulk access strategy, used by scans and bulk deletes touching more than 1/4 of the buffer pool
+static constexpr size_t BULK_READ_RING_SIZE = 256;                          // frames of the ring for bulk reads
+static constexpr size_t BULK_WRITE_RING_SIZE = 2048;                        // frames of the ring for bulk writes
+
+// table and index files grow by FILE_EXTENT_PAGES pages at a time, preallocated with fallocate
+static constexpr int FILE_EXTENT_PAGES = 256;
+
+// open table and index files with O_DIRECT so that their pages are cached only in the buffer pool;
+// the log file is always buffered. Falls back to buffered I/O on file systems without O_DIRECT support
+static constexpr bool DIRECT_IO = false;
+
+// buffer pool warm-up: resident pages are saved on clean shutdown and prefetched after restart,
+// WARMUP_BATCH_PAGES pages at a time and at most WARMUP_PAGES_PER_SECOND pages per second
+static constexpr size_t WARMUP_BATCH_PAGES = 64;
+static constexpr size_t WARMUP_PAGES_PER_SECOND = 16384;
+
+// per-statement arena used for tuple buffers and temporary keys, grows ARENA_CHUNK_SIZE bytes at a time
+static constexpr size_t ARENA_CHUNK_SIZE = 64 * 1024;
 
 static const std::string DB_META_NAME = "db.meta";
+static const std::string WARMUP_SNAPSHOT_NAME = "warmup.snapshot";
@@ -10,6 +10,7 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include "common/arena.h"
 #include "transaction/transaction.h"
 #include "transaction/concurrency/lock_manager.h"
 #include "recovery/log_manager.h"
@@ -35,4 +36,5 @@ public:
     char *data_send_;
     int *offset_;
     bool ellipsis_;
+    Arena arena_;       // 语句执行期间的元组和临时key从这里分配，语句结束时随Context一起释放
 };
\ No newline at end of file
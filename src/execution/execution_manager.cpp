@@ -31,6 +31,7 @@ const char *help_info = "Supported SQL syntax:\n"
                         "  DELETE FROM table_name [WHERE where_clause]\n"
                         "  UPDATE table_name SET column_name = value [, column_name = value ...] [WHERE where_clause]\n"
                         "  SELECT selector FROM table_name [WHERE where_clause]\n"
+                        "  SET buffer_pool_size = {pages | 'size{K|M|G}'}\n"
                         "type:\n"
                         "  {INT | FLOAT | CHAR(n)}\n"
                         "where_clause:\n"
@@ -92,6 +93,11 @@ void QlManager::run_cmd_utility(std::shared_ptr<Plan> plan, txn_id_t *txn_id, Co
                 sm_manager_->show_index(x->tab_name_, context);
                 break;
             }
+            case T_SetKnob: {
+                auto knob = std::static_pointer_cast<SetKnobPlan>(x);
+                sm_manager_->set_knob(knob->knob_name_, knob->value_, context);
+                break;
+            }
             case T_DescTable: {
                 sm_manager_->desc_table(x->tab_name_, context);
                 break;
@@ -152,6 +158,8 @@ void QlManager::select_from(std::unique_ptr<AbstractExecutor> executorTreeRoot,
     size_t num_rec = 0;
     // 执行query_plan
     for (executorTreeRoot->beginTuple(); !executorTreeRoot->is_end(); executorTreeRoot->nextTuple()) {
+        // 输出之后记录就不再需要，每一行都复用同一段arena空间
+        ArenaScope scope(context->arena_);
         auto Tuple = executorTreeRoot->Next();
         std::vector<std::string> columns;
         for (auto &col: executorTreeRoot->cols()) {
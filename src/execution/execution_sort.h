@@ -26,12 +26,13 @@ private:
     size_t tuple_num;
     int used_tuple;
     std::unique_ptr<RmRecord> current_tuple;
-    std::vector<RmRecord> records;
+    std::vector<char *> records;        // 排序缓冲，记录拷贝在context_->arena_中，排序只交换指针
     int limit_;
 
 public:
-    SortExecutor(std::unique_ptr<AbstractExecutor> prev, std::vector<TabCol> &key_cols, int limit) {
+    SortExecutor(std::unique_ptr<AbstractExecutor> prev, std::vector<TabCol> &key_cols, int limit, Context *context) {
         prev_ = std::move(prev);
+        context_ = context;
 
         auto &cols = prev_->cols();
         for (auto key_col: key_cols) {
@@ -49,16 +50,21 @@ public:
     void beginTuple() override {
         if (limit_ < 0) limit_ = INT_MAX;
         size_t count = 0;
+        size_t len = prev_->tupleLen();
         for (prev_->beginTuple(); !prev_->is_end(); prev_->nextTuple()) {
-            records.push_back(*(prev_->Next()));
+            // 先分配排序缓冲中的位置，儿子节点返回的记录拷贝进来之后就可以回收
+            char *data = context_->arena_.allocate(len);
+            ArenaScope scope(context_->arena_);
+            memcpy(data, prev_->Next()->data, len);
+            records.push_back(data);
             count++;
         }
         if (!key_cols_.empty())
-            std::sort(records.begin(), records.end(), [&](const RmRecord &l, const RmRecord &r) {
+            std::sort(records.begin(), records.end(), [&](char *l, char *r) {
                 for (const auto &tab_col: key_cols_) {
                     auto col_meta = cols_map[tab_col.col_name];
                     auto &is_desc = tab_col.is_desc;
-                    int cmp = Filter::compare(l.data + col_meta.offset, r.data + col_meta.offset, col_meta.len,
+                    int cmp = Filter::compare(l + col_meta.offset, r + col_meta.offset, col_meta.len,
                                               col_meta.type);
                     if (cmp != 0) return (is_desc) ? cmp > 0 : cmp < 0;
                 }
@@ -74,7 +80,11 @@ public:
 
     std::unique_ptr<RmRecord> Next() override {
         if (is_end()) return nullptr;
-        return std::make_unique<RmRecord>(records[used_tuple]);
+        // 排序缓冲在语句结束前一直有效，直接返回指向它的记录
+        auto rec = std::make_unique<RmRecord>();
+        rec->size = prev_->tupleLen();
+        rec->data = records[used_tuple];
+        return rec;
     }
 
     bool is_end() override { return used_tuple >= limit_ || used_tuple >= records.size(); }
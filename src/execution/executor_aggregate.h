@@ -88,8 +88,10 @@ private:
     bool is_end_;
 
 public:
-    AggregateExecutor(std::unique_ptr<AbstractExecutor> prev, const std::vector<TabCol> &sel_cols) {
+    AggregateExecutor(std::unique_ptr<AbstractExecutor> prev, const std::vector<TabCol> &sel_cols,
+                      Context *context) {
         prev_ = std::move(prev);
+        context_ = context;
         is_end_ = true;
 
         size_t curr_offset = 0;
@@ -126,8 +128,10 @@ public:
     std::unique_ptr<RmRecord> Next() override {
         if (is_end()) return nullptr;
 
-        auto proj_rec = std::make_unique<RmRecord>(len_);
+        auto proj_rec = std::make_unique<RmRecord>(len_, &context_->arena_);
         for (; !prev_->is_end(); prev_->nextTuple()) {
+            // 聚合函数的结果不引用输入的记录，每条记录处理完后回收它占用的arena空间
+            ArenaScope scope(context_->arena_);
             auto prev_rec = prev_->Next();
             auto &prev_cols = prev_->cols();
             for (size_t idx = 0; idx < cols_.size(); idx++) {
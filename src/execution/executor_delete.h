@@ -23,6 +23,7 @@ class DeleteExecutor : public AbstractExecutor {
     std::vector<Rid> rids_;         // 需要删除的记录的位置
     std::string tab_name_;          // 表名称
     SmManager *sm_manager_;
+    std::unique_ptr<BufferAccessStrategy> strategy_;    // 删除涉及大量页面时使用的缓冲池访问策略
 
    public:
     DeleteExecutor(SmManager *sm_manager, const std::string &tab_name, std::vector<Condition> conds,
@@ -34,6 +35,12 @@ class DeleteExecutor : public AbstractExecutor {
         conds_ = conds;
         rids_ = rids;
         context_ = context;
+        // rids_按扫描顺序排列，同一页面上的记录相邻
+        size_t num_pages = 0;
+        for (size_t i = 0; i < rids_.size(); i++) {
+            if (i == 0 || rids_[i].page_no != rids_[i - 1].page_no) num_pages++;
+        }
+        strategy_ = sm_manager_->get_bpm()->make_access_strategy(num_pages, BULK_WRITE_RING_SIZE);
         if (!context->lock_mgr_->lock_exclusive_on_table(context->txn_, fh_->GetFd()))
             throw TransactionAbortException(context->txn_->get_transaction_id(), AbortReason::DEADLOCK_PREVENTION);
     }
@@ -42,33 +49,38 @@ class DeleteExecutor : public AbstractExecutor {
         fh_ = sm_manager_->fhs_.at(tab_name_).get();
 
         for (auto rid: rids_) {
-            auto old_rec = fh_->get_record(rid, context_);
+            // 每条记录用到的key和记录拷贝都从arena中分配，处理完后回收
+            ArenaScope scope(context_->arena_);
+            // 在页面上直接提取索引键，记录只为日志和写集合拷贝一次
+            auto old_view = fh_->get_record_view(rid, context_, strategy_.get());
 
             // 尝试更新索引
             for (auto& index: tab_.indexes) {
                 auto ih = sm_manager_->ihs_.at(sm_manager_->get_ix_manager()->get_index_name(tab_name_, index.cols)).get();
-                char *old_key = new char[index.col_tot_len];
+                char *old_key = context_->arena_.allocate(index.col_tot_len);
                 int offset = 0;
                 for (auto & col : index.cols) {
-                    memcpy(old_key + offset, old_rec->data + col.offset, col.len);
+                    memcpy(old_key + offset, old_view.data() + col.offset, col.len);
                     offset += col.len;
                 }
 
                 auto ok = ih->delete_entry(old_key, context_);
                 if (!ok) throw InternalError("UpdateExecutor: delete old_key failed\n");
 //                ih->flush();
-                delete[] old_key;
             }
 
+            RmRecord old_rec(old_view.size(), old_view.data(), &context_->arena_);
+            old_view.release();
+
 //            context_->txn_->add_idx_log(context_->log_mgr_);
-            fh_->delete_record(rid, context_);
+            fh_->delete_record(rid, context_, strategy_.get());
 
             // 事务相关操作
             auto log_rec = DeleteLogRecord(context_->txn_->get_transaction_id(), context_->txn_->get_prev_lsn(),
-                                           *old_rec, rid, tab_name_);
+                                           old_rec, rid, fh_->get_oid());
             auto lsn = context_->log_mgr_->add_log_to_buffer(&log_rec);
             context_->txn_->set_prev_lsn(lsn);
-            WriteRecord write_record(WType::DELETE_TUPLE, tab_name_, rid, *old_rec, lsn);
+            WriteRecord write_record(WType::DELETE_TUPLE, tab_name_, rid, old_rec, lsn);
             context_->txn_->append_write_record(&write_record);
         }
         return nullptr;
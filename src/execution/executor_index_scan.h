@@ -40,6 +40,9 @@ private:
 
     Filter *filter_;
 
+    char *lower_key_;                           // 扫描范围的下界，从context_->arena_中分配
+    char *upper_key_;                           // 扫描范围的上界
+
     static void fill(char *val, ColType type, int len, bool min_or_max) {
         switch (type) {
             case TYPE_INT: {
@@ -101,6 +104,9 @@ public:
 
         filter_ = new Filter(fed_conds_);
 
+        lower_key_ = context_->arena_.allocate(index_meta_.col_tot_len);
+        upper_key_ = context_->arena_.allocate(index_meta_.col_tot_len);
+
         if (!context->lock_mgr_->lock_shared_on_table(context->txn_, fh_->GetFd()))
             throw TransactionAbortException(context->txn_->get_transaction_id(), AbortReason::DEADLOCK_PREVENTION);
     }
@@ -110,7 +116,8 @@ public:
                 sm_manager_->get_ix_manager()->get_index_name(tab_name_, index_col_names_)).get();
         auto lower = ih->leaf_begin(), upper = ih->leaf_end();
         auto lower_unmatched_idx = 0, upper_unmatched_idx = 0, lOffset = 0, rOffset = 0;
-        char *lKey = new char[index_meta_.col_tot_len], *rKey = new char[index_meta_.col_tot_len];
+        // 作为join的右表时每个左表分块都会重新调用beginTuple，上下界的key在构造时一次性分配
+        char *lKey = lower_key_, *rKey = upper_key_;
         // TODO 条件里出现多个关于一个列的条件时，只会使用一个条件，比如 where id>2 and id>3
         for (size_t idx = 0; idx < index_col_names_.size(); idx++) {
             auto &col_name = index_col_names_[idx];
@@ -148,9 +155,7 @@ public:
             // 填充左key, 用最小值填充
             for (size_t idx = lower_unmatched_idx; idx < index_col_names_.size(); idx++) {
                 const auto col = tab_.get_col(index_col_names_[idx]);
-                char *temp = new char[col->len];
-                fill(temp, col->type, col->len, true);
-                memmove(lKey + lOffset, temp, col->len);
+                fill(lKey + lOffset, col->type, col->len, true);
                 lOffset += col->len;
             }
             lower = ih->lower_bound(lKey);
@@ -159,9 +164,7 @@ public:
             // 用最大值填充右key
             for (size_t idx = upper_unmatched_idx; idx < index_col_names_.size(); idx++) {
                 const auto col = tab_.get_col(index_col_names_[idx]);
-                char *temp = new char[col->len];
-                fill(temp, col->type, col->len, false);
-                memmove(rKey + rOffset, temp, col->len);
+                fill(rKey + rOffset, col->type, col->len, false);
                 rOffset += col->len;
             }
             upper = ih->upper_bound(rKey);
@@ -170,8 +173,7 @@ public:
         scan_ = std::make_unique<IxScan>(ih, lower, upper, sm_manager_->get_bpm());
         while (!scan_->is_end()) {
             rid_ = scan_->rid();
-            auto rec = fh_->get_record(rid_, context_);
-            if (filter_->filter(cols_, rec.get())) break;
+            if (match()) break;
             scan_->next();
         }
     }
@@ -181,16 +183,15 @@ public:
 
         for (scan_->next(); !scan_->is_end(); scan_->next()) {  // 用TableIterator遍历TableHeap中的所有Tuple
             rid_ = scan_->rid();
-
-            auto rec = fh_->get_record(rid_, context_);
-            if (filter_->filter(cols_, rec.get())) break;
+            if (match()) break;
         }
 
     }
 
     std::unique_ptr<RmRecord> Next() override {
         if (is_end()) throw InternalError("IndexScanExecutor::Next is_end() is true");
-        return fh_->get_record(rid_, context_);
+        auto view = fh_->get_record_view(rid_, context_);
+        return std::make_unique<RmRecord>(view.size(), view.data(), &context_->arena_);
     }
 
     size_t tupleLen() override {
@@ -206,4 +207,11 @@ public:
     Rid &rid() override { return rid_; }
 
     bool is_end() override { return scan_->is_end(); }
+
+private:
+    // 在缓冲池页面上直接判断rid_对应的记录是否满足条件，只有满足条件的记录在Next()中才会被拷贝
+    bool match() {
+        auto view = fh_->get_record_view(rid_, context_);
+        return filter_->filter(cols_, view.data());
+    }
 };
\ No newline at end of file
@@ -20,10 +20,10 @@ See the Mulan PSL v2 for more details. */
 class InsertExecutor : public AbstractExecutor {
 private:
     TabMeta tab_;                   // 表的元数据
-    std::vector<Value> values_;     // 需要插入的数据
+    std::vector<Value> values_;     // 需要插入的数据，多行时按行依次存放
     RmFileHandle *fh_;              // 表的数据文件句柄
     std::string tab_name_;          // 表名称
-    Rid rid_;                       // 插入的位置，由于系统默认插入时不指定位置，因此当前rid_在插入后才赋值
+    Rid rid_;                       // 插入的位置，由于系统默认插入时不指定位置，因此当前rid_在插入后才赋值；多行时为最后一行的位置
     SmManager *sm_manager_;
 
 public:
@@ -32,7 +32,7 @@ public:
         tab_ = sm_manager_->db_.get_table(tab_name);
         values_ = values;
         tab_name_ = tab_name;
-        if (values.size() != tab_.cols.size()) {
+        if (values.empty() || values.size() % tab_.cols.size() != 0) {
             throw InvalidValueCountError();
         }
         try {
@@ -47,11 +47,50 @@ public:
     };
 
     std::unique_ptr<RmRecord> Next() override {
-        // 生成 RmRecord，并提供尽力的类型转换
-        RmRecord rec(fh_->get_file_hdr().record_size);
-        for (size_t i = 0; i < values_.size(); i++) {
+        // 生成每一行的记录，多行时通过批量接口插入表
+        size_t num_cols = tab_.cols.size();
+        size_t num_rows = values_.size() / num_cols;
+        std::vector<RmRecord> recs;
+        recs.reserve(num_rows);     // 记录的数据在arena中，预留空间避免扩容时拷贝
+        std::vector<char *> bufs;
+        for (size_t row = 0; row < num_rows; row++) {
+            recs.emplace_back(fh_->get_file_hdr().record_size, &context_->arena_);
+            fill_record(recs.back().data, row * num_cols);
+            bufs.push_back(recs.back().data);
+        }
+        std::vector<Rid> rids;
+        if (num_rows == 1) {
+            rids.push_back(fh_->insert_record(bufs[0], context_));
+        } else {
+            rids = fh_->insert_records(bufs, context_);
+        }
+
+        for (size_t row = 0; row < num_rows; row++) {
+            rid_ = rids[row];
+            insert_index(recs[row], row, rids);
+            // 写入事务
+            auto log_rec = InsertLogRecord(context_->txn_->get_transaction_id(), context_->txn_->get_prev_lsn(),
+                                           recs[row], rid_, fh_->get_oid());
+            auto lsn = context_->log_mgr_->add_log_to_buffer(&log_rec);
+            context_->txn_->set_prev_lsn(lsn);
+            WriteRecord write_record(WType::INSERT_TUPLE, tab_name_, rid_, lsn);
+            context_->txn_->append_write_record(&write_record);
+        }
+        return nullptr;
+    }
+
+    Rid &rid() override { return rid_; }
+
+private:
+    /**
+     * @description: 生成一行记录，并提供尽力的类型转换
+     * @param {char*} data 记录的数据
+     * @param {size_t} begin 该行的第一个值在values_中的下标
+     */
+    void fill_record(char *data, size_t begin) {
+        for (size_t i = 0; i < tab_.cols.size(); i++) {
             auto &col = tab_.cols[i];
-            auto val = values_[i];
+            auto val = values_[begin + i];
             if (col.type != val.type) {
                 if (col.type == TYPE_BIGINT && val.type == TYPE_INT) {
                     val.set_bigint(val.int_val);
@@ -60,16 +99,17 @@ public:
                 } else throw IncompatibleTypeError(coltype2str(col.type), coltype2str(val.type));
             }
             val.init_raw(col.len);
-            memcpy(rec.data + col.offset, val.raw->data, col.len);
+            memcpy(data + col.offset, val.raw->data, col.len);
         }
+    }
 
-        // 插入表
-        rid_ = fh_->insert_record(rec.data, context_);
-
-        // 插入索引
+    /**
+     * @description: 将第row行记录插入各个索引，唯一索引冲突时删除该行及之后尚未写入事务的各行
+     */
+    void insert_index(const RmRecord &rec, size_t row, const std::vector<Rid> &rids) {
         for (auto &index: tab_.indexes) {
             auto ih = sm_manager_->ihs_.at(sm_manager_->get_ix_manager()->get_index_name(tab_name_, index.cols)).get();
-            char *key = new char[index.col_tot_len];
+            char *key = context_->arena_.allocate(index.col_tot_len);
             int offset = 0;
             for (auto &col: index.cols) {
                 memcpy(key + offset, rec.data + col.offset, col.len);
@@ -78,22 +118,13 @@ public:
             auto page_no = ih->insert_entry(key, rid_, context_);
             if (page_no == INVALID_PAGE_ID) {
                 // TODO 插入失败回滚
-                fh_->delete_record(rid_, context_);
+                for (size_t i = row; i < rids.size(); i++) {
+                    fh_->delete_record(rids[i], context_);
+                }
                 throw InternalError("unique index key exit");
             }
 //            ih->flush();
-            delete[] key;
         }
 //        context_->txn_->add_idx_log(context_->log_mgr_);
-        // 写入事务
-        auto log_rec = InsertLogRecord(context_->txn_->get_transaction_id(), context_->txn_->get_prev_lsn(),
-                                       rec, rid_, tab_name_);
-        auto lsn = context_->log_mgr_->add_log_to_buffer(&log_rec);
-        context_->txn_->set_prev_lsn(lsn);
-        WriteRecord write_record(WType::INSERT_TUPLE, tab_name_, rid_, lsn);
-        context_->txn_->append_write_record(&write_record);
-        return nullptr;
     }
-
-    Rid &rid() override { return rid_; }
 };
\ No newline at end of file
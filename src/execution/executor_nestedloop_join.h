@@ -29,38 +29,45 @@ private:
     bool isend;
 
     Filter *filter_;
-    std::unique_ptr<RmRecord> cur_rec_;
 
+    // 以下缓冲区在构造时从context_->arena_中一次性分配，之后重复使用
     int buffer_size;
-    std::vector<std::unique_ptr<RmRecord>> l_records;
-    std::queue<std::unique_ptr<RmRecord>> buff;
+    size_t left_len_;
+    char *l_block_;                 // 左表的一个分块，最多buffer_size条记录
+    size_t l_num_;                  // 分块中的记录数
+    char *join_buf_;                // 拼接左右两条记录，右表记录只拷贝一次
+    char *out_buf_;                 // 满足条件的拼接结果，make_buff只在buff为空时调用，因此可以覆盖
+    std::queue<char *> buff;
 
     void make_buff() {
         if (isend) return;
         // 指向下一位
 
-        for (; !left_->is_end() || !l_records.empty(); ) {
-            if (l_records.empty())
-                for (size_t i = 0; i < buffer_size && !left_->is_end(); i++) {
-                    l_records.push_back(left_->Next());
-                    left_->nextTuple();
+        size_t right_len = len_ - left_len_;
+        for (; !left_->is_end() || l_num_ > 0; ) {
+            if (l_num_ == 0)
+                for (; l_num_ < buffer_size && !left_->is_end(); l_num_++, left_->nextTuple()) {
+                    // 儿子节点返回的记录拷贝到分块中后就可以回收
+                    ArenaScope scope(context_->arena_);
+                    memcpy(l_block_ + l_num_ * left_len_, left_->Next()->data, left_len_);
                 }
+            char *out = out_buf_;
             for (; !right_->is_end(); right_->nextTuple()) {
-                auto rrec = right_->Next();
-                auto data = new char[len_];
-                for (auto& lrec : l_records) {
-                    memset(data, 0, len_);
-                    memmove(data, lrec->data, lrec->size);
-                    memmove(data+lrec->size, rrec->data, rrec->size);
-                    cur_rec_ =  std::make_unique<RmRecord>(len_, data);
-                    if (filter_->filter(cols_, cur_rec_.get())) {
-                        buff.push(std::move(cur_rec_));
+                {
+                    ArenaScope scope(context_->arena_);
+                    memcpy(join_buf_ + left_len_, right_->Next()->data, right_len);
+                }
+                for (size_t i = 0; i < l_num_; i++) {
+                    memcpy(join_buf_, l_block_ + i * left_len_, left_len_);
+                    if (filter_->filter(cols_, join_buf_)) {
+                        memcpy(out, join_buf_, len_);
+                        buff.push(out);
+                        out += len_;
                     }
                 }
-                delete[] data;
                 if (!buff.empty()) return;
             }
-            l_records.clear();
+            l_num_ = 0;
             right_->beginTuple();
         }
         isend = true;
@@ -68,7 +75,8 @@ private:
 
 public:
     NestedLoopJoinExecutor(std::unique_ptr<AbstractExecutor> left, std::unique_ptr<AbstractExecutor> right,
-                           std::vector<Condition> conds) {
+                           std::vector<Condition> conds, Context *context) {
+        context_ = context;
         left_ = std::move(left);
         right_ = std::move(right);
         len_ = left_->tupleLen() + right_->tupleLen();
@@ -85,13 +93,18 @@ public:
         filter_ = new Filter(fed_conds_);
 
         buffer_size = std::max(64, int(4 * PAGE_SIZE / left_->tupleLen()));
+        left_len_ = left_->tupleLen();
+        l_num_ = 0;
+        l_block_ = context_->arena_.allocate(buffer_size * left_len_);
+        join_buf_ = context_->arena_.allocate(len_);
+        out_buf_ = context_->arena_.allocate(buffer_size * len_);
     }
 
     void beginTuple() override {
         left_->beginTuple();
         right_->beginTuple();
 
-        l_records.clear();
+        l_num_ = 0;
         while (!buff.empty()) buff.pop();
 
         make_buff();
@@ -107,7 +120,10 @@ public:
 
     std::unique_ptr<RmRecord> Next() override {
         if (buff.empty()) throw InternalError("NestedLoopJoinExecutor::Next buff is empty");
-        auto rec = std::move(buff.front());
+        // 返回的记录指向out_buf_，在下一次调用nextTuple之前有效
+        auto rec = std::make_unique<RmRecord>();
+        rec->size = len_;
+        rec->data = buff.front();
         buff.pop();
         return rec;
     }
@@ -23,8 +23,10 @@ class ProjectionExecutor : public AbstractExecutor {
     std::vector<size_t> sel_idxs_;                  
 
    public:
-    ProjectionExecutor(std::unique_ptr<AbstractExecutor> prev, const std::vector<TabCol> &sel_cols) {
+    ProjectionExecutor(std::unique_ptr<AbstractExecutor> prev, const std::vector<TabCol> &sel_cols,
+                       Context *context) {
         prev_ = std::move(prev);
+        context_ = context;
 
         size_t curr_offset = 0;
         auto &prev_cols = prev_->cols();
@@ -49,7 +51,7 @@ class ProjectionExecutor : public AbstractExecutor {
 
     std::unique_ptr<RmRecord> Next() override {
         if (is_end()) return nullptr;
-        auto proj_rec = std::make_unique<RmRecord>(len_);
+        auto proj_rec = std::make_unique<RmRecord>(len_, &context_->arena_);
         auto prev_rec = prev_->Next();
         auto &prev_cols = prev_->cols();
         for (size_t proj_idx = 0; proj_idx < cols_.size(); proj_idx++) {
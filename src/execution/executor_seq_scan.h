@@ -27,7 +27,8 @@ private:
     std::vector<Condition> fed_conds_;  // 同conds_，两个字段相同
 
     Rid rid_;
-    std::unique_ptr<RecScan> scan_;     // table_iterator
+    std::unique_ptr<RmScan> scan_;      // table_iterator，按页面读取记录，每个页面只访问一次缓冲池
+    std::unique_ptr<BufferAccessStrategy> strategy_;    // 大表的扫描只使用一个小的环形缓冲区，小表为nullptr
     Filter *filter_;
 
     SmManager *sm_manager_;
@@ -39,6 +40,7 @@ public:
         conds_ = std::move(conds);
         TabMeta tab = sm_manager_->db_.get_table(tab_name_);
         fh_ = sm_manager_->fhs_.at(tab_name_).get();
+        strategy_ = fh_->make_access_strategy(BULK_READ_RING_SIZE);
         cols_ = tab.cols;
         len_ = cols_.back().offset + cols_.back().len;
 
@@ -54,11 +56,10 @@ public:
     }
 
     void beginTuple() override {
-        scan_ = std::make_unique<RmScan>(fh_);
+        scan_ = std::make_unique<RmScan>(fh_, strategy_.get());
         for (; !scan_->is_end(); scan_->next()) {  // 用TableIterator遍历TableHeap中的所有Tuple
             rid_ = scan_->rid();
-            auto rec = fh_->get_record(rid_, context_);
-            if (filter_->filter(cols_,  rec.get()))
+            if (match())
                 break;
         }
     }
@@ -67,15 +68,14 @@ public:
         if (scan_->is_end()) return;
         for (scan_->next(); !scan_->is_end(); scan_->next()) {  // 用TableIterator遍历TableHeap中的所有Tuple
             rid_ = scan_->rid();
-            auto rec = fh_->get_record(rid_, context_);
-            if (filter_->filter(cols_, rec.get())) {
+            if (match()) {
                 break;
             }
         }
     }
 
     std::unique_ptr<RmRecord> Next() override {
-        return fh_->get_record(rid_, context_);
+        return std::make_unique<RmRecord>(scan_->record_size(), scan_->record(), &context_->arena_);
     }
 
     bool is_end() override {
@@ -91,4 +91,10 @@ public:
     }
 
     Rid &rid() override { return rid_; }
+
+private:
+    // 直接在扫描拷贝出的页面数据上判断当前记录是否满足条件，不再访问缓冲池；表上已加读锁，不需要再加记录锁
+    bool match() {
+        return filter_->filter(cols_, scan_->record());
+    }
 };
\ No newline at end of file
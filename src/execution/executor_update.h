@@ -48,9 +48,13 @@ public:
         fh_ = sm_manager_->fhs_.at(tab_name_).get();
 
         for (auto rid: rids_) {
+            // 每条记录用到的key和记录拷贝都从arena中分配，处理完后回收
+            ArenaScope scope(context_->arena_);
             // 加锁
-            auto old_rec = fh_->get_record(rid, nullptr); // 不要加锁
-            auto new_rec = *old_rec;
+            auto old_view = fh_->get_record_view(rid, nullptr); // 不要加锁
+            RmRecord old_rec(old_view.size(), old_view.data(), &context_->arena_);
+            old_view.release();
+            RmRecord new_rec(old_rec.size, old_rec.data, &context_->arena_);
             // 根据set条件，修改生成新的记录
             for (auto &set_clause: set_clauses_) {
                 auto lhs_col = tab_.get_col(set_clause.lhs.col_name);
@@ -71,10 +75,11 @@ public:
             for (auto &index: tab_.indexes) {
                 auto ih = sm_manager_->ihs_.at(
                         sm_manager_->get_ix_manager()->get_index_name(tab_name_, index.cols)).get();
-                char *old_key = new char[index.col_tot_len], *new_key = new char[index.col_tot_len];
+                char *old_key = context_->arena_.allocate(index.col_tot_len);
+                char *new_key = context_->arena_.allocate(index.col_tot_len);
                 int offset = 0;
                 for (auto &col: index.cols) {
-                    memcpy(old_key + offset, old_rec->data + col.offset, col.len);
+                    memcpy(old_key + offset, old_rec.data + col.offset, col.len);
                     memcpy(new_key + offset, new_rec.data + col.offset, col.len);
                     offset += col.len;
                 }
@@ -90,8 +95,6 @@ public:
                 assert(ih->get_rid(iid) == rid);
                 iid = ih->upper_bound(old_key);
                 assert(iid == ih->leaf_end());
-                delete[] old_key;
-                delete[] new_key;
 //                ih->flush();
             }
 
@@ -100,11 +103,11 @@ public:
 
             // 写入日志
             auto log_rec = UpdateLogRecord(context_->txn_->get_transaction_id(), context_->txn_->get_prev_lsn(),
-                                           new_rec,*old_rec, rid, tab_name_);
+                                           new_rec, old_rec, rid, fh_->get_oid());
             auto lsn = context_->log_mgr_->add_log_to_buffer(&log_rec);
             context_->txn_->set_prev_lsn(lsn);
 
-            WriteRecord write_record(WType::UPDATE_TUPLE, tab_name_, rid, *old_rec, lsn);
+            WriteRecord write_record(WType::UPDATE_TUPLE, tab_name_, rid, old_rec, lsn);
             context_->txn_->append_write_record(&write_record);
         }
         return nullptr;
@@ -97,8 +97,14 @@ public:
     }
 
     bool filter_single(std::vector<ColMeta> &rec_cols, Condition &cond, const RmRecord *rec) {
+        return filter_single(rec_cols, cond, rec->data);
+    }
+
+    // 直接在记录数据上判断单个条件，data可以指向缓冲池页面中的记录，不需要先拷贝出来
+    bool filter_single(std::vector<ColMeta> &rec_cols, Condition &cond, const char *data) {
+        auto rec_data = const_cast<char *>(data);
         auto lhs_col = get_col(rec_cols, cond.lhs_col);
-        char *lhs = rec->data + lhs_col->offset;
+        char *lhs = rec_data + lhs_col->offset;
         char *rhs;
         ColType rhs_type, lhs_type = lhs_col->type;
         if (cond.is_rhs_val) {
@@ -108,12 +114,15 @@ public:
             // rhs is a column
             auto rhs_col = get_col(rec_cols, cond.rhs_col);
             rhs_type = rhs_col->type;
-            rhs = rec->data + rhs_col->offset;
+            rhs = rec_data + rhs_col->offset;
         }
         if (rhs_type != lhs_type) {
             std::cerr << "type changed\n";
             if (rhs_type == ColType::TYPE_STRING || lhs_col->type == ColType::TYPE_STRING)
                 throw IncompatibleTypeError(coltype2str(lhs_col->type), coltype2str(rhs_type));
+            // 转换后的值放在栈上，不为每条记录分配内存
+            long double converted[2];
+            int num_converted = 0;
             for (auto& x : std::vector<std::pair<ColType, char**> >{
                 std::make_pair(lhs_type, &lhs),
                 std::make_pair(rhs_type, &rhs),
@@ -135,9 +144,9 @@ public:
                     res = fa;
                 }
 
-                auto dst = new char[sizeof (res)];
-                memcpy(dst, &res, sizeof (res));
-                *src = dst;
+                auto dst = &converted[num_converted++];
+                *dst = res;
+                *src = reinterpret_cast<char *>(dst);
             }
             lhs_type = rhs_type = TYPE_DOUBLE;
         }
@@ -154,22 +163,19 @@ public:
 
             ColType rhs_type = rhs_col->type, lhs_type = lhs_col->type;
             int len = lhs_col->len;
+            float lhs_float, rhs_float;     // 类型转换后的值
             if (rhs_type != lhs_type) {
                 std::cerr << "type changed\n";
                 if (rhs_type == ColType::TYPE_STRING || lhs_col->type == ColType::TYPE_STRING)
                     throw IncompatibleTypeError(coltype2str(lhs_col->type), coltype2str(rhs_type));
                 if (rhs_type == ColType::TYPE_INT) {
-                    float fa = *(int *)rhs;
-                    auto data = new char[sizeof(float )];
-                    memcpy(data, &fa, sizeof(fa));
-                    rhs = data;
+                    rhs_float = *(int *)rhs;
+                    rhs = reinterpret_cast<char *>(&rhs_float);
                     rhs_type = ColType::TYPE_FLOAT;
                 }
                 if (lhs_type == ColType::TYPE_INT || lhs_type == ColType::TYPE_BIGINT) {
-                    float fa = *(int *)lhs;
-                    auto data = new char[sizeof(float )];
-                    memcpy(data, &fa, sizeof(fa));
-                    lhs = data;
+                    lhs_float = *(int *)lhs;
+                    lhs = reinterpret_cast<char *>(&lhs_float);
                     lhs_type = ColType::TYPE_FLOAT;
                 }
                 len = sizeof (float );
@@ -180,8 +186,12 @@ public:
     }
 
     bool filter(std::vector<ColMeta> &rec_cols, RmRecord *rec) {
+        return filter(rec_cols, rec->data);
+    }
+
+    bool filter(std::vector<ColMeta> &rec_cols, const char *data) {
         return std::all_of(conds_.begin(), conds_.end(),[&](Condition &cond) {
-            return filter_single(rec_cols, cond, rec);
+            return filter_single(rec_cols, cond, data);
         });
     }
 };
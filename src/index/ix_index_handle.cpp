@@ -191,11 +191,11 @@ int IxNodeHandle::remove(const char *key) {
 IxIndexHandle::IxIndexHandle(DiskManager *disk_manager, BufferPoolManager *buffer_pool_manager, int fd)
         : disk_manager_(disk_manager), buffer_pool_manager_(buffer_pool_manager), fd_(fd) {
     // init file_hdr_
-    char *buf = new char[PAGE_SIZE];
-    memset(buf, 0, PAGE_SIZE);
-    disk_manager_->read_page(fd, IX_FILE_HDR_PAGE, buf, PAGE_SIZE);
+    auto buf = DiskManager::alloc_page_buffer();
+    memset(buf.get(), 0, PAGE_SIZE);
+    disk_manager_->read_page(fd, IX_FILE_HDR_PAGE, buf.get(), PAGE_SIZE);
     file_hdr_ = new IxFileHdr();
-    file_hdr_->deserialize(buf);
+    file_hdr_->deserialize(buf.get());
 
     // disk_manager管理的fd对应的文件中，设置从file_hdr_->num_pages开始分配page_no
     disk_manager_->set_fd2pageno(fd, file_hdr_->num_pages_);
@@ -667,6 +667,13 @@ IxNodeHandle *IxIndexHandle::fetch_node(int page_no) const {
  */
 IxNodeHandle *IxIndexHandle::create_node() {
     IxNodeHandle *node;
+    if (file_hdr_->first_free_page_no_ != IX_NO_PAGE) {
+        // 优先复用被删除的结点所在的页面，从空闲页面链表头部取出
+        node = fetch_node(file_hdr_->first_free_page_no_);
+        file_hdr_->first_free_page_no_ = node->page_hdr->next_free_page_no;
+        memset(node->page->get_data(), 0, PAGE_SIZE);
+        return node;
+    }
     file_hdr_->num_pages_++;
 
     PageId new_page_id = {.fd = fd_, .page_no = INVALID_PAGE_ID};
@@ -721,14 +728,15 @@ void IxIndexHandle::erase_leaf(IxNodeHandle *leaf, Context *context) {
 }
 
 /**
- * @brief 删除node时，更新file_hdr_.num_pages
+ * @brief 删除node时，将其所在页面放入空闲页面链表，之后create_node会复用该页面
+ * 结点的固定由获取它的调用者释放；有事务时页面加入index_latch_page_set，链表指针随文件头一起写入索引日志
  *
  * @param node
  */
 void IxIndexHandle::release_node_handle(IxNodeHandle &node, Context *context) {
-//    handle_dirty_page(context, &node);
-    context->txn_->get_index_deleted_page_set()->push_back(node.page);
-//    file_hdr_->num_pages_--;
+    node.page_hdr->next_free_page_no = file_hdr_->first_free_page_no_;
+    file_hdr_->first_free_page_no_ = node.get_page_no();
+    if (context != nullptr) context->txn_->append_index_latch_page_set(node.page);
 }
 
 /**
@@ -750,8 +758,7 @@ void IxIndexHandle::add_to_log(Context* context) {
     if (context->txn_->get_index_deleted_page_set()->size() + context->txn_->get_index_latch_page_set()->size() == 0)
         return;
 
-    auto idx_name = disk_manager_->get_file_name(fd_);
-    IndexPagesLogRecord rec(context->txn_->get_transaction_id(), context->txn_->get_prev_lsn(), idx_name);
+    IndexPagesLogRecord rec(context->txn_->get_transaction_id(), context->txn_->get_prev_lsn(), oid_);
 
     // 将索引维护写入redo log
     auto& txn = context->txn_;
@@ -185,12 +185,19 @@ private:
     DiskManager *disk_manager_;
     BufferPoolManager *buffer_pool_manager_;
     int fd_;                                    // 存储B+树的文件
+    oid_t oid_ = INVALID_OID;                   // 索引在目录中的对象ID，写日志时用它标识索引
     IxFileHdr *file_hdr_;                       // 存了root_page，但其初始化为2（第0页存FILE_HDR_PAGE，第1页存LEAF_HEADER_PAGE）
     std::mutex root_latch_;
 
 public:
     IxIndexHandle(DiskManager *disk_manager, BufferPoolManager *buffer_pool_manager, int fd);
 
+    int get_fd() { return fd_; }
+
+    oid_t get_oid() const { return oid_; }
+
+    void set_oid(oid_t oid) { oid_ = oid; }
+
     // for search
     bool get_value(const char *key, std::vector<Rid> *result, Context *context);
 
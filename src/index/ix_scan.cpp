@@ -19,6 +19,12 @@ void IxScan::next() {
     IxNodeHandle *node = ih_->fetch_node(iid_.page_no);
     assert(node->is_leaf_page());
     assert(iid_.slot_no < node->get_size());
+    if (iid_.slot_no == 0 && iid_.page_no != ih_->file_hdr_->last_leaf_) {
+        // 刚进入该叶子结点：叶子按页号连续分配时由缓冲池识别顺序访问并预读，
+        // 同时预读叶子链表中的下一个结点，使其读入与当前结点的遍历重叠
+        bpm_->read_ahead(PageId{ih_->fd_, iid_.page_no}, ih_->file_hdr_->num_pages_);
+        bpm_->prefetch_pages({PageId{ih_->fd_, node->get_next_leaf()}});
+    }
     // increment slot no
     iid_.slot_no++;
     if (iid_.page_no != ih_->file_hdr_->last_leaf_ && iid_.slot_no == node->get_size()) {
@@ -26,6 +32,8 @@ void IxScan::next() {
         iid_.slot_no = 0;
         iid_.page_no = node->get_next_leaf();
     }
+    bpm_->unpin_page(node->get_page_id(), false);
+    delete node;
 }
 
 Rid IxScan::rid() const {
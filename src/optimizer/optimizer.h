@@ -43,6 +43,14 @@ class Optimizer {
             return std::make_shared<OtherPlan>(T_DescTable, x->tab_name);
         } else if (auto x = std::dynamic_pointer_cast<ast::ShowIndex>(query->parse)) {
             return std::make_shared<OtherPlan>(T_ShowIndex, x->tab_name);
+        } else if (auto x = std::dynamic_pointer_cast<ast::SetKnob>(query->parse)) {
+            // set knob_name = value;
+            std::string value;
+            if (auto v = std::dynamic_pointer_cast<ast::IntLit>(x->val)) value = std::to_string(v->val);
+            else if (auto v = std::dynamic_pointer_cast<ast::BigintLit>(x->val)) value = std::to_string(v->val);
+            else if (auto v = std::dynamic_pointer_cast<ast::StringLit>(x->val)) value = v->val;
+            else throw InternalError("invalid value for " + x->knob_name);
+            return std::make_shared<SetKnobPlan>(x->knob_name, value);
         } else if (auto x = std::dynamic_pointer_cast<ast::TxnBegin>(query->parse)) {
             // begin;
             return std::make_shared<OtherPlan>(T_Transaction_begin, std::string());
@@ -29,6 +29,7 @@ typedef enum PlanTag {
     T_CreateIndex,
     T_DropIndex,
     T_ShowIndex,
+    T_SetKnob,
     T_Insert,
     T_Update,
     T_Delete,
@@ -202,6 +203,20 @@ public:
     std::string tab_name_;
 };
 
+// set knob_name = value语句对应的plan，值统一保存为字符串，由执行时按配置项解析
+class SetKnobPlan : public OtherPlan {
+public:
+    SetKnobPlan(std::string knob_name, std::string value) : OtherPlan(T_SetKnob, std::string()) {
+        knob_name_ = std::move(knob_name);
+        value_ = std::move(value);
+    }
+
+    ~SetKnobPlan() {}
+
+    std::string knob_name_;
+    std::string value_;
+};
+
 class plannerInfo {
 public:
     std::shared_ptr<ast::SelectStmt> parse;
@@ -306,7 +306,8 @@ std::shared_ptr<Plan> Planner::do_planner(std::shared_ptr<Query> query, Context
             if (auto sv_col_def = std::dynamic_pointer_cast<ast::ColDef>(field)) {
                 ColDef col_def = {.name = sv_col_def->col_name,
                         .type = interp_sv_type(sv_col_def->type_len->type),
-                        .len = sv_col_def->type_len->len};
+                        .len = sv_col_def->type_len->len,
+                        .var_len = sv_col_def->type_len->type == ast::SV_TYPE_VARCHAR};
                 col_defs.push_back(col_def);
             } else {
                 throw InternalError("Unexpected field type");
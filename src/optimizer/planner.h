@@ -58,7 +58,8 @@ private:
                 {ast::SV_TYPE_FLOAT,  TYPE_FLOAT},
                 {ast::SV_TYPE_STRING, TYPE_STRING},
                 {ast::SV_TYPE_BIGINT, TYPE_BIGINT},
-                {ast::SV_TYPE_DATETIME, TYPE_DATETIME}};
+                {ast::SV_TYPE_DATETIME, TYPE_DATETIME},
+                {ast::SV_TYPE_VARCHAR, TYPE_STRING}};
         return m.at(sv_type);
     }
 };
\ No newline at end of file
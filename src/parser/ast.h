@@ -20,7 +20,7 @@ enum JoinType {
 namespace ast {
 
     enum SvType {
-        SV_TYPE_INT, SV_TYPE_FLOAT, SV_TYPE_STRING, SV_TYPE_BIGINT, SV_TYPE_DATETIME
+        SV_TYPE_INT, SV_TYPE_FLOAT, SV_TYPE_STRING, SV_TYPE_BIGINT, SV_TYPE_DATETIME, SV_TYPE_VARCHAR
     };
 
     enum SvFunc {
@@ -166,6 +166,14 @@ namespace ast {
                 col_name(std::move(col_name_)), val(std::move(val_)) {}
     };
 
+    struct SetKnob : public TreeNode {
+        std::string knob_name;
+        std::shared_ptr<Value> val;
+
+        SetKnob(std::string knob_name_, std::shared_ptr<Value> val_) :
+                knob_name(std::move(knob_name_)), val(std::move(val_)) {}
+    };
+
     struct BinaryExpr : public TreeNode {
         std::shared_ptr<Col> lhs;
         SvCompOp op;
@@ -185,10 +193,10 @@ namespace ast {
 
     struct InsertStmt : public TreeNode {
         std::string tab_name;
-        std::vector<std::shared_ptr<Value>> vals;
+        std::vector<std::vector<std::shared_ptr<Value>>> rows;    // 每一行要插入的值
 
-        InsertStmt(std::string tab_name_, std::vector<std::shared_ptr<Value>> vals_) :
-                tab_name(std::move(tab_name_)), vals(std::move(vals_)) {}
+        InsertStmt(std::string tab_name_, std::vector<std::vector<std::shared_ptr<Value>>> rows_) :
+                tab_name(std::move(tab_name_)), rows(std::move(rows_)) {}
     };
 
     struct DeleteStmt : public TreeNode {
@@ -305,6 +313,8 @@ namespace ast {
 
         std::shared_ptr<Value> sv_val;
         std::vector<std::shared_ptr<Value>> sv_vals;
+        // 语法分析栈每次归约都会复制整个SemValue，多行VALUES通过指针共享，追加一行不必复制之前的所有行
+        std::shared_ptr<std::vector<std::vector<std::shared_ptr<Value>>>> sv_val_rows;
 
         std::shared_ptr<Col> sv_col;
         std::vector<std::shared_ptr<Col>> sv_cols;
@@ -46,6 +46,7 @@ private:
                 {SV_TYPE_INT,    "INT"},
                 {SV_TYPE_FLOAT,  "FLOAT"},
                 {SV_TYPE_STRING, "STRING"},
+                {SV_TYPE_VARCHAR, "VARCHAR"},
         };
         return m.at(type);
     }
@@ -126,6 +127,10 @@ private:
             std::cout << "SET_CLAUSE\n";
             print_val(x->col_name, offset);
             print_node(x->val, offset);
+        } else if (auto x = std::dynamic_pointer_cast<SetKnob>(node)) {
+            std::cout << "SET_KNOB\n";
+            print_val(x->knob_name, offset);
+            print_node(x->val, offset);
         } else if (auto x = std::dynamic_pointer_cast<BinaryExpr>(node)) {
             std::cout << "BINARY_EXPR\n";
             print_node(x->lhs, offset);
@@ -134,7 +139,9 @@ private:
         } else if (auto x = std::dynamic_pointer_cast<InsertStmt>(node)) {
             std::cout << "INSERT\n";
             print_val(x->tab_name, offset);
-            print_node_list(x->vals, offset);
+            for (auto &row : x->rows) {
+                print_node_list(row, offset);
+            }
         } else if (auto x = std::dynamic_pointer_cast<DeleteStmt>(node)) {
             std::cout << "DELETE\n";
             print_val(x->tab_name, offset);
@@ -71,6 +71,8 @@
 
 #include "ast.h"
 #include "yacc.tab.h"
+#include <strings.h>
+
 #include <iostream>
 #include <memory>
 
@@ -82,7 +84,7 @@ void yyerror(YYLTYPE *locp, const char* s) {
 
 using namespace ast;
 
-#line 86 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 88 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
 
 # ifndef YY_CAST
 #  ifdef __cplusplus
@@ -162,11 +164,11 @@ enum yysymbol_kind_t
   YYSYMBOL_VALUE_FLOAT = 49,               /* VALUE_FLOAT  */
   YYSYMBOL_VALUE_BIGINT = 50,              /* VALUE_BIGINT  */
   YYSYMBOL_51_ = 51,                       /* ';'  */
-  YYSYMBOL_52_ = 52,                       /* '('  */
-  YYSYMBOL_53_ = 53,                       /* ')'  */
-  YYSYMBOL_54_ = 54,                       /* ','  */
-  YYSYMBOL_55_ = 55,                       /* '.'  */
-  YYSYMBOL_56_ = 56,                       /* '='  */
+  YYSYMBOL_52_ = 52,                       /* '='  */
+  YYSYMBOL_53_ = 53,                       /* '('  */
+  YYSYMBOL_54_ = 54,                       /* ')'  */
+  YYSYMBOL_55_ = 55,                       /* ','  */
+  YYSYMBOL_56_ = 56,                       /* '.'  */
   YYSYMBOL_57_ = 57,                       /* '<'  */
   YYSYMBOL_58_ = 58,                       /* '>'  */
   YYSYMBOL_59_ = 59,                       /* '*'  */
@@ -182,26 +184,27 @@ enum yysymbol_kind_t
   YYSYMBOL_field = 69,                     /* field  */
   YYSYMBOL_type = 70,                      /* type  */
   YYSYMBOL_valueList = 71,                 /* valueList  */
-  YYSYMBOL_value = 72,                     /* value  */
-  YYSYMBOL_condition = 73,                 /* condition  */
-  YYSYMBOL_optWhereClause = 74,            /* optWhereClause  */
-  YYSYMBOL_whereClause = 75,               /* whereClause  */
-  YYSYMBOL_col = 76,                       /* col  */
-  YYSYMBOL_op = 77,                        /* op  */
-  YYSYMBOL_expr = 78,                      /* expr  */
-  YYSYMBOL_setClauses = 79,                /* setClauses  */
-  YYSYMBOL_setClause = 80,                 /* setClause  */
-  YYSYMBOL_selector = 81,                  /* selector  */
-  YYSYMBOL_tableList = 82,                 /* tableList  */
-  YYSYMBOL_order_clauses = 83,             /* order_clauses  */
-  YYSYMBOL_order_clause = 84,              /* order_clause  */
-  YYSYMBOL_opt_asc_desc = 85,              /* opt_asc_desc  */
-  YYSYMBOL_opt_limit = 86,                 /* opt_limit  */
-  YYSYMBOL_selectColList = 87,             /* selectColList  */
-  YYSYMBOL_selectCol = 88,                 /* selectCol  */
-  YYSYMBOL_aggregateFunc = 89,             /* aggregateFunc  */
-  YYSYMBOL_tbName = 90,                    /* tbName  */
-  YYSYMBOL_colName = 91                    /* colName  */
+  YYSYMBOL_valueRows = 72,                 /* valueRows  */
+  YYSYMBOL_value = 73,                     /* value  */
+  YYSYMBOL_condition = 74,                 /* condition  */
+  YYSYMBOL_optWhereClause = 75,            /* optWhereClause  */
+  YYSYMBOL_whereClause = 76,               /* whereClause  */
+  YYSYMBOL_col = 77,                       /* col  */
+  YYSYMBOL_op = 78,                        /* op  */
+  YYSYMBOL_expr = 79,                      /* expr  */
+  YYSYMBOL_setClauses = 80,                /* setClauses  */
+  YYSYMBOL_setClause = 81,                 /* setClause  */
+  YYSYMBOL_selector = 82,                  /* selector  */
+  YYSYMBOL_tableList = 83,                 /* tableList  */
+  YYSYMBOL_order_clauses = 84,             /* order_clauses  */
+  YYSYMBOL_order_clause = 85,              /* order_clause  */
+  YYSYMBOL_opt_asc_desc = 86,              /* opt_asc_desc  */
+  YYSYMBOL_opt_limit = 87,                 /* opt_limit  */
+  YYSYMBOL_selectColList = 88,             /* selectColList  */
+  YYSYMBOL_selectCol = 89,                 /* selectCol  */
+  YYSYMBOL_aggregateFunc = 90,             /* aggregateFunc  */
+  YYSYMBOL_tbName = 91,                    /* tbName  */
+  YYSYMBOL_colName = 92                    /* colName  */
 };
 typedef enum yysymbol_kind_t yysymbol_kind_t;
 
@@ -530,18 +533,18 @@ union yyalloc
 #endif /* !YYCOPY_NEEDED */
 
 /* YYFINAL -- State number of the termination state.  */
-#define YYFINAL  46
+#define YYFINAL  48
 /* YYLAST -- Last index in YYTABLE.  */
-#define YYLAST   141
+#define YYLAST   154
 
 /* YYNTOKENS -- Number of terminals.  */
 #define YYNTOKENS  60
 /* YYNNTS -- Number of nonterminals.  */
-#define YYNNTS  32
+#define YYNNTS  33
 /* YYNRULES -- Number of rules.  */
-#define YYNRULES  84
+#define YYNRULES  88
 /* YYNSTATES -- Number of states.  */
-#define YYNSTATES  153
+#define YYNSTATES  166
 
 /* YYMAXUTOK -- Last valid token kind.  */
 #define YYMAXUTOK   305
@@ -562,9 +565,9 @@ static const yytype_int8 yytranslate[] =
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-      52,    53,    59,     2,    54,     2,    55,     2,     2,     2,
+      53,    54,    59,     2,    55,     2,    56,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,    51,
-      57,    56,    58,     2,     2,     2,     2,     2,     2,     2,
+      57,    52,    58,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
@@ -595,15 +598,15 @@ static const yytype_int8 yytranslate[] =
 /* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
 static const yytype_int16 yyrline[] =
 {
-       0,    62,    62,    67,    72,    77,    85,    86,    87,    88,
-      92,    96,   100,   104,   111,   115,   122,   126,   130,   134,
-     138,   145,   149,   153,   157,   164,   168,   175,   179,   186,
-     193,   197,   201,   205,   209,   216,   220,   227,   231,   235,
-     239,   246,   253,   254,   261,   265,   272,   276,   294,   298,
-     302,   306,   310,   314,   321,   325,   332,   336,   343,   350,
-     354,   358,   362,   366,   373,   377,   381,   386,   393,   394,
-     395,   399,   400,   403,   407,   414,   418,   422,   426,   433,
-     434,   435,   436,   440,   442
+       0,    65,    65,    70,    75,    80,    88,    89,    90,    91,
+      95,    99,   103,   107,   114,   118,   122,   129,   133,   137,
+     141,   145,   152,   156,   160,   164,   171,   175,   182,   186,
+     193,   200,   204,   208,   212,   216,   220,   232,   236,   243,
+     248,   256,   260,   264,   268,   275,   282,   283,   290,   294,
+     301,   305,   323,   327,   331,   335,   339,   343,   350,   354,
+     361,   365,   372,   379,   383,   387,   391,   395,   402,   406,
+     410,   415,   422,   423,   424,   428,   429,   432,   436,   443,
+     447,   451,   455,   462,   463,   464,   465,   469,   471
 };
 #endif
 
@@ -626,11 +629,11 @@ static const char *const yytname[] =
   "BIGINT", "DATETIME", "INDEX", "AND", "JOIN", "EXIT", "HELP",
   "TXN_BEGIN", "TXN_COMMIT", "TXN_ABORT", "TXN_ROLLBACK", "ORDER_BY",
   "LEQ", "NEQ", "GEQ", "T_EOF", "IDENTIFIER", "VALUE_STRING", "VALUE_INT",
-  "VALUE_FLOAT", "VALUE_BIGINT", "';'", "'('", "')'", "','", "'.'", "'='",
+  "VALUE_FLOAT", "VALUE_BIGINT", "';'", "'='", "'('", "')'", "','", "'.'",
   "'<'", "'>'", "'*'", "$accept", "start", "stmt", "txnStmt", "dbStmt",
   "ddl", "dml", "fieldList", "colNameList", "field", "type", "valueList",
-  "value", "condition", "optWhereClause", "whereClause", "col", "op",
-  "expr", "setClauses", "setClause", "selector", "tableList",
+  "valueRows", "value", "condition", "optWhereClause", "whereClause",
+  "col", "op", "expr", "setClauses", "setClause", "selector", "tableList",
   "order_clauses", "order_clause", "opt_asc_desc", "opt_limit",
   "selectColList", "selectCol", "aggregateFunc", "tbName", "colName", YY_NULLPTR
 };
@@ -642,12 +645,12 @@ yysymbol_name (yysymbol_kind_t yysymbol)
 }
 #endif
 
-#define YYPACT_NINF (-88)
+#define YYPACT_NINF (-61)
 
 #define yypact_value_is_default(Yyn) \
   ((Yyn) == YYPACT_NINF)
 
-#define YYTABLE_NINF (-84)
+#define YYTABLE_NINF (-88)
 
 #define yytable_value_is_error(Yyn) \
   0
@@ -656,22 +659,23 @@ yysymbol_name (yysymbol_kind_t yysymbol)
    STATE-NUM.  */
 static const yytype_int8 yypact[] =
 {
-      66,     2,    18,    19,   -27,    30,    29,   -27,    -3,   -88,
-     -88,   -88,   -88,   -88,   -88,   -88,    47,    -2,   -88,   -88,
-     -88,   -88,   -88,    40,   -27,   -27,   -27,   -27,   -88,   -88,
-     -27,   -27,    43,   -88,   -88,   -88,   -88,    15,   -88,   -88,
-      59,    27,   -88,    39,    24,   -88,   -88,   -88,   -27,    48,
-      60,   -88,    68,   107,    96,    75,   -27,    11,   -11,    75,
-     -88,    75,    75,    75,    70,    77,   -88,   -88,   -13,   -88,
-      69,   -16,   -88,   -88,    71,    73,   -88,     6,   -88,    36,
-      35,   -88,    54,    46,   -88,    94,    41,    75,   -88,    46,
-     -27,   -27,   113,   108,   109,   -88,    75,   -88,    79,   -88,
-     -88,   -88,   -88,   -88,    75,   -88,   -88,   -88,   -88,   -88,
-      56,   -88,    77,   -88,   -88,   -88,   -88,   -88,   -88,    67,
-     -88,   -88,   -88,   -88,   116,   -18,    75,    75,   -88,    85,
-     -88,   -88,    46,   -88,   -88,   -88,   -88,    77,    86,    77,
-     -88,   -88,   -88,    82,   -88,    25,   -88,   -88,   -88,   -88,
-     -88,   -88,   -88
+      66,    15,     4,     8,   -40,    10,    12,   -40,    16,    -2,
+     -61,   -61,   -61,   -61,   -61,   -61,   -61,    56,    21,   -61,
+     -61,   -61,   -61,   -61,    52,   -40,   -40,   -40,   -40,   -61,
+     -61,   -40,   -40,    25,    27,   -61,   -61,   -61,   -61,    26,
+     -61,   -61,    70,    30,   -61,    34,    33,   -61,   -61,   -61,
+     -40,    40,    41,   -61,    57,   107,    96,    74,    50,   -40,
+      14,   -11,    74,   -61,    74,    74,    74,    68,    83,   -61,
+     -61,   -16,   -61,    80,   -61,   -61,   -61,   -61,   -61,     3,
+     -61,   -61,    76,    79,   -61,   -25,   -61,    85,    -1,   -61,
+       9,    50,    81,   -61,   101,    65,    74,   -61,    50,   -40,
+     -40,   120,   116,   117,   -61,    74,   -61,    86,   -61,   -61,
+     -61,    87,   -61,   -61,    74,   -61,    13,   -61,    88,    83,
+     -61,   -61,   -61,   -61,   -61,   -61,    78,   -61,   -61,   -61,
+     -61,   126,   -17,    74,    74,   -61,    95,    97,   -61,   -61,
+      50,    50,   -61,   -61,   -61,   -61,    83,    98,    83,   -61,
+     -61,   -61,    90,    93,   -61,    22,    37,   -61,   -61,   -61,
+     -61,   -61,   -61,   -61,   -61,   -61
 };
 
 /* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
@@ -679,40 +683,41 @@ static const yytype_int8 yypact[] =
    means the default is an error.  */
 static const yytype_int8 yydefact[] =
 {
-       0,     0,     0,     0,     0,     0,     0,     0,     0,     4,
-       3,    10,    11,    12,    13,     5,     0,     0,     9,     6,
-       7,     8,    14,     0,     0,     0,     0,     0,    83,    18,
-       0,     0,     0,    79,    80,    81,    82,    84,    59,    78,
-       0,    60,    73,     0,     0,    47,     1,     2,     0,     0,
-       0,    17,     0,     0,    42,     0,     0,     0,     0,     0,
-      15,     0,     0,     0,     0,     0,    22,    84,    42,    56,
-       0,    42,    61,    74,     0,     0,    46,     0,    25,     0,
-       0,    27,     0,     0,    44,    43,     0,     0,    23,     0,
-       0,     0,    66,     0,    77,    16,     0,    30,     0,    32,
-      33,    34,    29,    19,     0,    20,    39,    37,    38,    40,
-       0,    35,     0,    52,    51,    53,    48,    49,    50,     0,
-      57,    58,    63,    62,     0,    72,     0,     0,    26,     0,
-      28,    21,     0,    45,    54,    55,    41,     0,     0,     0,
-      24,    75,    76,     0,    36,    70,    64,    71,    65,    31,
-      69,    68,    67
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       4,     3,    10,    11,    12,    13,     5,     0,     0,     9,
+       6,     7,     8,    14,     0,     0,     0,     0,     0,    87,
+      19,     0,     0,     0,     0,    83,    84,    85,    86,    88,
+      63,    82,     0,    64,    77,     0,     0,    51,     1,     2,
+       0,     0,     0,    18,     0,     0,    46,     0,     0,     0,
+       0,     0,     0,    15,     0,     0,     0,     0,     0,    23,
+      88,    46,    60,     0,    43,    41,    42,    44,    16,    46,
+      65,    78,     0,     0,    50,     0,    26,     0,     0,    28,
+       0,     0,    22,    48,    47,     0,     0,    24,     0,     0,
+       0,    70,     0,    81,    17,     0,    31,     0,    33,    34,
+      35,     0,    30,    20,     0,    21,     0,    37,     0,     0,
+      56,    55,    57,    52,    53,    54,     0,    61,    62,    67,
+      66,     0,    76,     0,     0,    27,     0,     0,    29,    39,
+       0,     0,    49,    58,    59,    45,     0,     0,     0,    25,
+      79,    80,     0,     0,    38,     0,    74,    68,    75,    69,
+      32,    36,    40,    73,    72,    71
 };
 
 /* YYPGOTO[NTERM-NUM].  */
 static const yytype_int8 yypgoto[] =
 {
-     -88,   -88,   -88,   -88,   -88,   -88,   -88,   -88,    74,    42,
-     -88,   -88,   -87,    28,   -10,   -88,   -57,   -88,   -88,   -88,
-      49,   -88,   -88,   -88,     0,   -88,   -88,   -88,    84,   -88,
-      -4,   -50
+     -61,   -61,   -61,   -61,   -61,   -61,   -61,   -61,    82,    44,
+     -61,    11,   -61,   -56,    31,   -30,   -61,   -60,   -61,   -61,
+     -61,    55,   -61,   -61,   -61,     5,   -61,   -61,   -61,    94,
+     -61,    -4,   -53
 };
 
 /* YYDEFGOTO[NTERM-NUM].  */
 static const yytype_uint8 yydefgoto[] =
 {
-       0,    16,    17,    18,    19,    20,    21,    77,    80,    78,
-     102,   110,   111,    84,    66,    85,    39,   119,   136,    68,
-      69,    40,    71,   125,   146,   152,   140,    41,    42,    43,
-      44,    45
+       0,    17,    18,    19,    20,    21,    22,    85,    88,    86,
+     112,   116,    92,   117,    93,    69,    94,    41,   126,   145,
+      71,    72,    42,    79,   132,   157,   165,   149,    43,    44,
+      45,    46,    47
 };
 
 /* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
@@ -720,90 +725,93 @@ static const yytype_uint8 yydefgoto[] =
    number is the opposite.  If YYTABLE_NINF, syntax error.  */
 static const yytype_int16 yytable[] =
 {
-      29,    75,   121,    32,   138,    70,    22,    65,    86,    76,
-      65,    79,    81,    81,    33,    34,    35,    36,    90,    28,
-      49,    50,    51,    52,    24,    26,    53,    54,    33,    34,
-      35,    36,   134,   150,    23,    37,   139,    70,    91,   151,
-      30,    87,    31,    37,    60,   144,    79,    46,    74,    47,
-      25,    27,    72,    48,   130,    86,    38,    37,    88,    95,
-      96,    92,   135,    97,    98,    99,   100,   101,    55,     1,
-     -83,     2,    56,     3,     4,     5,   141,   142,     6,    59,
-     145,    57,   145,   113,   114,   115,   122,   123,   103,   104,
-       7,    58,     8,   106,   107,   108,   109,   116,   117,   118,
-      61,     9,    10,    11,    12,    13,    14,   105,   104,   131,
-     132,    15,    62,    37,   106,   107,   108,   109,    64,    65,
-      63,    67,    83,    37,    93,    89,    94,   112,   124,   126,
-     127,   129,   137,   143,   147,   149,   120,    82,   128,   148,
-     133,    73
+      30,    83,    78,    33,    73,   147,    29,    68,    95,    84,
+      25,    87,    89,    89,    27,    35,    36,    37,    38,    23,
+      31,    51,    52,    53,    54,    32,    68,    55,    56,   104,
+     105,    35,    36,    37,    38,    39,    26,    99,   148,    96,
+      28,    97,   128,    73,    39,   163,    63,    24,    82,   101,
+      57,   164,    87,   113,   114,    80,    48,    40,   100,    95,
+      39,   138,    34,   115,   114,    50,   144,   139,   140,     1,
+     143,     2,    49,     3,     4,     5,   162,   140,     6,    58,
+     150,   151,   -87,    59,   154,    60,   156,    61,   156,    62,
+       7,     8,     9,    64,    65,   129,   130,    74,    75,    76,
+      77,    10,    11,    12,    13,    14,    15,   120,   121,   122,
+      66,    16,   106,   107,   108,   109,   110,   123,    67,    68,
+      70,    91,   124,   125,    39,    74,    75,    76,    77,    39,
+     102,   111,    98,   103,   119,   131,   118,   133,   134,   136,
+     137,   141,   146,   152,   160,   153,   158,   161,    90,   135,
+     142,   127,   155,   159,    81
 };
 
 static const yytype_uint8 yycheck[] =
 {
-       4,    58,    89,     7,    22,    55,     4,    23,    65,    59,
-      23,    61,    62,    63,    17,    18,    19,    20,    34,    46,
-      24,    25,    26,    27,     6,     6,    30,    31,    17,    18,
-      19,    20,   119,     8,    32,    46,    54,    87,    54,    14,
-      10,    54,    13,    46,    48,   132,    96,     0,    59,    51,
-      32,    32,    56,    13,   104,   112,    59,    46,    68,    53,
-      54,    71,   119,    27,    28,    29,    30,    31,    25,     3,
-      55,     5,    13,     7,     8,     9,   126,   127,    12,    55,
-     137,    54,   139,    42,    43,    44,    90,    91,    53,    54,
-      24,    52,    26,    47,    48,    49,    50,    56,    57,    58,
-      52,    35,    36,    37,    38,    39,    40,    53,    54,    53,
-      54,    45,    52,    46,    47,    48,    49,    50,    11,    23,
-      52,    46,    52,    46,    53,    56,    53,    33,    15,    21,
-      21,    52,    16,    48,    48,    53,    87,    63,    96,   139,
-     112,    57
+       4,    61,    58,     7,    57,    22,    46,    23,    68,    62,
+       6,    64,    65,    66,     6,    17,    18,    19,    20,     4,
+      10,    25,    26,    27,    28,    13,    23,    31,    32,    54,
+      55,    17,    18,    19,    20,    46,    32,    34,    55,    55,
+      32,    71,    98,    96,    46,     8,    50,    32,    59,    79,
+      25,    14,   105,    54,    55,    59,     0,    59,    55,   119,
+      46,   114,    46,    54,    55,    13,   126,    54,    55,     3,
+     126,     5,    51,     7,     8,     9,    54,    55,    12,    52,
+     133,   134,    56,    13,   140,    55,   146,    53,   148,    56,
+      24,    25,    26,    53,    53,    99,   100,    47,    48,    49,
+      50,    35,    36,    37,    38,    39,    40,    42,    43,    44,
+      53,    45,    27,    28,    29,    30,    31,    52,    11,    23,
+      46,    53,    57,    58,    46,    47,    48,    49,    50,    46,
+      54,    46,    52,    54,    33,    15,    55,    21,    21,    53,
+      53,    53,    16,    48,    54,    48,    48,    54,    66,   105,
+     119,    96,   141,   148,    60
 };
 
 /* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
    state STATE-NUM.  */
 static const yytype_int8 yystos[] =
 {
-       0,     3,     5,     7,     8,     9,    12,    24,    26,    35,
-      36,    37,    38,    39,    40,    45,    61,    62,    63,    64,
-      65,    66,     4,    32,     6,    32,     6,    32,    46,    90,
-      10,    13,    90,    17,    18,    19,    20,    46,    59,    76,
-      81,    87,    88,    89,    90,    91,     0,    51,    13,    90,
-      90,    90,    90,    90,    90,    25,    13,    54,    52,    55,
-      90,    52,    52,    52,    11,    23,    74,    46,    79,    80,
-      91,    82,    90,    88,    59,    76,    91,    67,    69,    91,
-      68,    91,    68,    52,    73,    75,    76,    54,    74,    56,
-      34,    54,    74,    53,    53,    53,    54,    27,    28,    29,
-      30,    31,    70,    53,    54,    53,    47,    48,    49,    50,
-      71,    72,    33,    42,    43,    44,    56,    57,    58,    77,
-      80,    72,    90,    90,    15,    83,    21,    21,    69,    52,
-      91,    53,    54,    73,    72,    76,    78,    16,    22,    54,
-      86,    91,    91,    48,    72,    76,    84,    48,    84,    53,
-       8,    14,    85
+       0,     3,     5,     7,     8,     9,    12,    24,    25,    26,
+      35,    36,    37,    38,    39,    40,    45,    61,    62,    63,
+      64,    65,    66,     4,    32,     6,    32,     6,    32,    46,
+      91,    10,    13,    91,    46,    17,    18,    19,    20,    46,
+      59,    77,    82,    88,    89,    90,    91,    92,     0,    51,
+      13,    91,    91,    91,    91,    91,    91,    25,    52,    13,
+      55,    53,    56,    91,    53,    53,    53,    11,    23,    75,
+      46,    80,    81,    92,    47,    48,    49,    50,    73,    83,
+      91,    89,    59,    77,    92,    67,    69,    92,    68,    92,
+      68,    53,    72,    74,    76,    77,    55,    75,    52,    34,
+      55,    75,    54,    54,    54,    55,    27,    28,    29,    30,
+      31,    46,    70,    54,    55,    54,    71,    73,    55,    33,
+      42,    43,    44,    52,    57,    58,    78,    81,    73,    91,
+      91,    15,    84,    21,    21,    69,    53,    53,    92,    54,
+      55,    53,    74,    73,    77,    79,    16,    22,    55,    87,
+      92,    92,    48,    48,    73,    71,    77,    85,    48,    85,
+      54,    54,    54,     8,    14,    86
 };
 
 /* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
 static const yytype_int8 yyr1[] =
 {
        0,    60,    61,    61,    61,    61,    62,    62,    62,    62,
-      63,    63,    63,    63,    64,    64,    65,    65,    65,    65,
-      65,    66,    66,    66,    66,    67,    67,    68,    68,    69,
-      70,    70,    70,    70,    70,    71,    71,    72,    72,    72,
-      72,    73,    74,    74,    75,    75,    76,    76,    77,    77,
-      77,    77,    77,    77,    78,    78,    79,    79,    80,    81,
-      81,    82,    82,    82,    83,    83,    83,    84,    85,    85,
-      85,    86,    86,    87,    87,    88,    88,    88,    88,    89,
-      89,    89,    89,    90,    91
+      63,    63,    63,    63,    64,    64,    64,    65,    65,    65,
+      65,    65,    66,    66,    66,    66,    67,    67,    68,    68,
+      69,    70,    70,    70,    70,    70,    70,    71,    71,    72,
+      72,    73,    73,    73,    73,    74,    75,    75,    76,    76,
+      77,    77,    78,    78,    78,    78,    78,    78,    79,    79,
+      80,    80,    81,    82,    82,    83,    83,    83,    84,    84,
+      84,    85,    86,    86,    86,    87,    87,    88,    88,    89,
+      89,    89,    89,    90,    90,    90,    90,    91,    92
 };
 
 /* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
 static const yytype_int8 yyr2[] =
 {
        0,     2,     2,     1,     1,     1,     1,     1,     1,     1,
-       1,     1,     1,     1,     2,     4,     6,     3,     2,     6,
-       6,     7,     4,     5,     7,     1,     3,     1,     3,     2,
-       1,     4,     1,     1,     1,     1,     3,     1,     1,     1,
-       1,     3,     0,     2,     1,     3,     3,     1,     1,     1,
-       1,     1,     1,     1,     1,     1,     1,     3,     3,     1,
-       1,     1,     3,     3,     3,     3,     0,     2,     1,     1,
-       0,     2,     0,     1,     3,     6,     6,     4,     1,     1,
-       1,     1,     1,     1,     1
+       1,     1,     1,     1,     2,     4,     4,     6,     3,     2,
+       6,     6,     5,     4,     5,     7,     1,     3,     1,     3,
+       2,     1,     4,     1,     1,     1,     4,     1,     3,     3,
+       5,     1,     1,     1,     1,     3,     0,     2,     1,     3,
+       3,     1,     1,     1,     1,     1,     1,     1,     1,     1,
+       1,     3,     3,     1,     1,     1,     3,     3,     3,     3,
+       0,     2,     1,     1,     0,     2,     0,     1,     3,     6,
+       6,     4,     1,     1,     1,     1,     1,     1,     1
 };
 
 
@@ -1659,599 +1667,638 @@ yyreduce:
   switch (yyn)
     {
   case 2: /* start: stmt ';'  */
-#line 63 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+#line 66 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
     {
         parse_tree = (yyvsp[-1].sv_node);
         YYACCEPT;
     }
-#line 1668 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 1676 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
   case 3: /* start: HELP  */
-#line 68 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+#line 71 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
     {
         parse_tree = std::make_shared<Help>();
         YYACCEPT;
     }
-#line 1677 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 1685 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
   case 4: /* start: EXIT  */
-#line 73 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+#line 76 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
     {
         parse_tree = nullptr;
         YYACCEPT;
     }
-#line 1686 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 1694 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
   case 5: /* start: T_EOF  */
-#line 78 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+#line 81 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
     {
         parse_tree = nullptr;
         YYACCEPT;
     }
-#line 1695 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 1703 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
   case 10: /* txnStmt: TXN_BEGIN  */
-#line 93 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+#line 96 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<TxnBegin>();
     }
-#line 1703 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 1711 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
   case 11: /* txnStmt: TXN_COMMIT  */
-#line 97 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+#line 100 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<TxnCommit>();
     }
-#line 1711 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 1719 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
   case 12: /* txnStmt: TXN_ABORT  */
-#line 101 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+#line 104 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<TxnAbort>();
     }
-#line 1719 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 1727 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
   case 13: /* txnStmt: TXN_ROLLBACK  */
-#line 105 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+#line 108 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<TxnRollback>();
     }
-#line 1727 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 1735 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
   case 14: /* dbStmt: SHOW TABLES  */
-#line 112 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+#line 115 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<ShowTables>();
     }
-#line 1735 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 1743 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
   case 15: /* dbStmt: SHOW INDEX FROM tbName  */
-#line 116 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+#line 119 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
     {
 	(yyval.sv_node) = std::make_shared<ShowIndex>((yyvsp[0].sv_str));
     }
-#line 1743 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 1751 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
-  case 16: /* ddl: CREATE TABLE tbName '(' fieldList ')'  */
+  case 16: /* dbStmt: SET IDENTIFIER '=' value  */
 #line 123 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+    {
+        (yyval.sv_node) = std::make_shared<SetKnob>((yyvsp[-2].sv_str), (yyvsp[0].sv_val));
+    }
+#line 1759 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+    break;
+
+  case 17: /* ddl: CREATE TABLE tbName '(' fieldList ')'  */
+#line 130 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<CreateTable>((yyvsp[-3].sv_str), (yyvsp[-1].sv_fields));
     }
-#line 1751 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 1767 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
-  case 17: /* ddl: DROP TABLE tbName  */
-#line 127 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+  case 18: /* ddl: DROP TABLE tbName  */
+#line 134 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<DropTable>((yyvsp[0].sv_str));
     }
-#line 1759 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 1775 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
-  case 18: /* ddl: DESC tbName  */
-#line 131 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+  case 19: /* ddl: DESC tbName  */
+#line 138 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<DescTable>((yyvsp[0].sv_str));
     }
-#line 1767 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 1783 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
-  case 19: /* ddl: CREATE INDEX tbName '(' colNameList ')'  */
-#line 135 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+  case 20: /* ddl: CREATE INDEX tbName '(' colNameList ')'  */
+#line 142 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<CreateIndex>((yyvsp[-3].sv_str), (yyvsp[-1].sv_strs));
     }
-#line 1775 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 1791 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
-  case 20: /* ddl: DROP INDEX tbName '(' colNameList ')'  */
-#line 139 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+  case 21: /* ddl: DROP INDEX tbName '(' colNameList ')'  */
+#line 146 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<DropIndex>((yyvsp[-3].sv_str), (yyvsp[-1].sv_strs));
     }
-#line 1783 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 1799 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
-  case 21: /* dml: INSERT INTO tbName VALUES '(' valueList ')'  */
-#line 146 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+  case 22: /* dml: INSERT INTO tbName VALUES valueRows  */
+#line 153 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
     {
-        (yyval.sv_node) = std::make_shared<InsertStmt>((yyvsp[-4].sv_str), (yyvsp[-1].sv_vals));
+        (yyval.sv_node) = std::make_shared<InsertStmt>((yyvsp[-2].sv_str), std::move(*(yyvsp[0].sv_val_rows)));
     }
-#line 1791 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 1807 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
-  case 22: /* dml: DELETE FROM tbName optWhereClause  */
-#line 150 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+  case 23: /* dml: DELETE FROM tbName optWhereClause  */
+#line 157 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<DeleteStmt>((yyvsp[-1].sv_str), (yyvsp[0].sv_conds));
     }
-#line 1799 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 1815 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
-  case 23: /* dml: UPDATE tbName SET setClauses optWhereClause  */
-#line 154 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+  case 24: /* dml: UPDATE tbName SET setClauses optWhereClause  */
+#line 161 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<UpdateStmt>((yyvsp[-3].sv_str), (yyvsp[-1].sv_set_clauses), (yyvsp[0].sv_conds));
     }
-#line 1807 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 1823 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
-  case 24: /* dml: SELECT selector FROM tableList optWhereClause order_clauses opt_limit  */
-#line 158 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+  case 25: /* dml: SELECT selector FROM tableList optWhereClause order_clauses opt_limit  */
+#line 165 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<SelectStmt>((yyvsp[-5].sv_select_cols), (yyvsp[-3].sv_strs), (yyvsp[-2].sv_conds), (yyvsp[-1].sv_orderbys_), (yyvsp[0].sv_int));
     }
-#line 1815 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 1831 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
-  case 25: /* fieldList: field  */
-#line 165 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+  case 26: /* fieldList: field  */
+#line 172 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
     {
         (yyval.sv_fields) = std::vector<std::shared_ptr<Field>>{(yyvsp[0].sv_field)};
     }
-#line 1823 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 1839 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
-  case 26: /* fieldList: fieldList ',' field  */
-#line 169 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+  case 27: /* fieldList: fieldList ',' field  */
+#line 176 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
     {
         (yyval.sv_fields).push_back((yyvsp[0].sv_field));
     }
-#line 1831 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 1847 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
-  case 27: /* colNameList: colName  */
-#line 176 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+  case 28: /* colNameList: colName  */
+#line 183 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
     {
         (yyval.sv_strs) = std::vector<std::string>{(yyvsp[0].sv_str)};
     }
-#line 1839 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 1855 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
-  case 28: /* colNameList: colNameList ',' colName  */
-#line 180 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+  case 29: /* colNameList: colNameList ',' colName  */
+#line 187 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
     {
         (yyval.sv_strs).push_back((yyvsp[0].sv_str));
     }
-#line 1847 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 1863 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
-  case 29: /* field: colName type  */
-#line 187 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+  case 30: /* field: colName type  */
+#line 194 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
     {
         (yyval.sv_field) = std::make_shared<ColDef>((yyvsp[-1].sv_str), (yyvsp[0].sv_type_len));
     }
-#line 1855 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 1871 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
-  case 30: /* type: INT  */
-#line 194 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+  case 31: /* type: INT  */
+#line 201 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
     {
         (yyval.sv_type_len) = std::make_shared<TypeLen>(SV_TYPE_INT, sizeof(int));
     }
-#line 1863 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 1879 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
-  case 31: /* type: CHAR '(' VALUE_INT ')'  */
-#line 198 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+  case 32: /* type: CHAR '(' VALUE_INT ')'  */
+#line 205 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
     {
         (yyval.sv_type_len) = std::make_shared<TypeLen>(SV_TYPE_STRING, (yyvsp[-1].sv_int));
     }
-#line 1871 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 1887 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
-  case 32: /* type: FLOAT  */
-#line 202 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+  case 33: /* type: FLOAT  */
+#line 209 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
     {
         (yyval.sv_type_len) = std::make_shared<TypeLen>(SV_TYPE_FLOAT, sizeof(float));
     }
-#line 1879 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 1895 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
-  case 33: /* type: BIGINT  */
-#line 206 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+  case 34: /* type: BIGINT  */
+#line 213 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
     {
     	(yyval.sv_type_len) = std::make_shared<TypeLen>(SV_TYPE_BIGINT, sizeof(long long));
     }
-#line 1887 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 1903 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
-  case 34: /* type: DATETIME  */
-#line 210 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+  case 35: /* type: DATETIME  */
+#line 217 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
     {
     	(yyval.sv_type_len) = std::make_shared<TypeLen>(SV_TYPE_DATETIME, 19);
     }
-#line 1895 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 1911 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
-  case 35: /* valueList: value  */
-#line 217 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+  case 36: /* type: IDENTIFIER '(' VALUE_INT ')'  */
+#line 221 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+    {
+        // VARCHAR不是词法关键字，作为标识符识别
+        if (strcasecmp((yyvsp[-3].sv_str).c_str(), "VARCHAR") != 0) {
+            yyerror(&(yylsp[-3]), ("unknown type " + (yyvsp[-3].sv_str)).c_str());
+            YYERROR;
+        }
+        (yyval.sv_type_len) = std::make_shared<TypeLen>(SV_TYPE_VARCHAR, (yyvsp[-1].sv_int));
+    }
+#line 1924 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+    break;
+
+  case 37: /* valueList: value  */
+#line 233 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
     {
         (yyval.sv_vals) = std::vector<std::shared_ptr<Value>>{(yyvsp[0].sv_val)};
     }
-#line 1903 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 1932 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
-  case 36: /* valueList: valueList ',' value  */
-#line 221 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+  case 38: /* valueList: valueList ',' value  */
+#line 237 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
     {
         (yyval.sv_vals).push_back((yyvsp[0].sv_val));
     }
-#line 1911 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 1940 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+    break;
+
+  case 39: /* valueRows: '(' valueList ')'  */
+#line 244 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+    {
+        (yyval.sv_val_rows) = std::make_shared<std::vector<std::vector<std::shared_ptr<Value>>>>();
+        (yyval.sv_val_rows)->push_back(std::move((yyvsp[-1].sv_vals)));
+    }
+#line 1949 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+    break;
+
+  case 40: /* valueRows: valueRows ',' '(' valueList ')'  */
+#line 249 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+    {
+        (yyval.sv_val_rows) = std::move((yyvsp[-4].sv_val_rows));
+        (yyval.sv_val_rows)->push_back(std::move((yyvsp[-1].sv_vals)));
+    }
+#line 1958 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
-  case 37: /* value: VALUE_INT  */
-#line 228 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+  case 41: /* value: VALUE_INT  */
+#line 257 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
     {
         (yyval.sv_val) = std::make_shared<IntLit>((yyvsp[0].sv_int));
     }
-#line 1919 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 1966 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
-  case 38: /* value: VALUE_FLOAT  */
-#line 232 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+  case 42: /* value: VALUE_FLOAT  */
+#line 261 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
     {
         (yyval.sv_val) = std::make_shared<FloatLit>((yyvsp[0].sv_float));
     }
-#line 1927 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 1974 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
-  case 39: /* value: VALUE_STRING  */
-#line 236 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+  case 43: /* value: VALUE_STRING  */
+#line 265 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
     {
         (yyval.sv_val) = std::make_shared<StringLit>((yyvsp[0].sv_str));
     }
-#line 1935 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 1982 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
-  case 40: /* value: VALUE_BIGINT  */
-#line 240 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+  case 44: /* value: VALUE_BIGINT  */
+#line 269 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
     {
     	(yyval.sv_val) = std::make_shared<BigintLit>((yyvsp[0].sv_bigint));
     }
-#line 1943 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 1990 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
-  case 41: /* condition: col op expr  */
-#line 247 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+  case 45: /* condition: col op expr  */
+#line 276 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
     {
         (yyval.sv_cond) = std::make_shared<BinaryExpr>((yyvsp[-2].sv_col), (yyvsp[-1].sv_comp_op), (yyvsp[0].sv_expr));
     }
-#line 1951 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 1998 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
-  case 42: /* optWhereClause: %empty  */
-#line 253 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+  case 46: /* optWhereClause: %empty  */
+#line 282 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
                       { /* ignore*/ }
-#line 1957 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 2004 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
-  case 43: /* optWhereClause: WHERE whereClause  */
-#line 255 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+  case 47: /* optWhereClause: WHERE whereClause  */
+#line 284 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
     {
         (yyval.sv_conds) = (yyvsp[0].sv_conds);
     }
-#line 1965 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 2012 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
-  case 44: /* whereClause: condition  */
-#line 262 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+  case 48: /* whereClause: condition  */
+#line 291 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
     {
         (yyval.sv_conds) = std::vector<std::shared_ptr<BinaryExpr>>{(yyvsp[0].sv_cond)};
     }
-#line 1973 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 2020 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
-  case 45: /* whereClause: whereClause AND condition  */
-#line 266 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+  case 49: /* whereClause: whereClause AND condition  */
+#line 295 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
     {
         (yyval.sv_conds).push_back((yyvsp[0].sv_cond));
     }
-#line 1981 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 2028 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
-  case 46: /* col: tbName '.' colName  */
-#line 273 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+  case 50: /* col: tbName '.' colName  */
+#line 302 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
     {
         (yyval.sv_col) = std::make_shared<Col>((yyvsp[-2].sv_str), (yyvsp[0].sv_str));
     }
-#line 1989 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 2036 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
-  case 47: /* col: colName  */
-#line 277 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+  case 51: /* col: colName  */
+#line 306 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
     {
         (yyval.sv_col) = std::make_shared<Col>("", (yyvsp[0].sv_str));
     }
-#line 1997 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 2044 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
-  case 48: /* op: '='  */
-#line 295 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+  case 52: /* op: '='  */
+#line 324 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
     {
         (yyval.sv_comp_op) = SV_OP_EQ;
     }
-#line 2005 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 2052 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
-  case 49: /* op: '<'  */
-#line 299 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+  case 53: /* op: '<'  */
+#line 328 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
     {
         (yyval.sv_comp_op) = SV_OP_LT;
     }
-#line 2013 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 2060 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
-  case 50: /* op: '>'  */
-#line 303 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+  case 54: /* op: '>'  */
+#line 332 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
     {
         (yyval.sv_comp_op) = SV_OP_GT;
     }
-#line 2021 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 2068 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
-  case 51: /* op: NEQ  */
-#line 307 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+  case 55: /* op: NEQ  */
+#line 336 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
     {
         (yyval.sv_comp_op) = SV_OP_NE;
     }
-#line 2029 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 2076 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
-  case 52: /* op: LEQ  */
-#line 311 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+  case 56: /* op: LEQ  */
+#line 340 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
     {
         (yyval.sv_comp_op) = SV_OP_LE;
     }
-#line 2037 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 2084 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
-  case 53: /* op: GEQ  */
-#line 315 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+  case 57: /* op: GEQ  */
+#line 344 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
     {
         (yyval.sv_comp_op) = SV_OP_GE;
     }
-#line 2045 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 2092 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
-  case 54: /* expr: value  */
-#line 322 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+  case 58: /* expr: value  */
+#line 351 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
     {
         (yyval.sv_expr) = std::static_pointer_cast<Expr>((yyvsp[0].sv_val));
     }
-#line 2053 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 2100 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
-  case 55: /* expr: col  */
-#line 326 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+  case 59: /* expr: col  */
+#line 355 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
     {
         (yyval.sv_expr) = std::static_pointer_cast<Expr>((yyvsp[0].sv_col));
     }
-#line 2061 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 2108 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
-  case 56: /* setClauses: setClause  */
-#line 333 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+  case 60: /* setClauses: setClause  */
+#line 362 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
     {
         (yyval.sv_set_clauses) = std::vector<std::shared_ptr<SetClause>>{(yyvsp[0].sv_set_clause)};
     }
-#line 2069 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 2116 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
-  case 57: /* setClauses: setClauses ',' setClause  */
-#line 337 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+  case 61: /* setClauses: setClauses ',' setClause  */
+#line 366 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
     {
         (yyval.sv_set_clauses).push_back((yyvsp[0].sv_set_clause));
     }
-#line 2077 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 2124 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
-  case 58: /* setClause: colName '=' value  */
-#line 344 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+  case 62: /* setClause: colName '=' value  */
+#line 373 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
     {
         (yyval.sv_set_clause) = std::make_shared<SetClause>((yyvsp[-2].sv_str), (yyvsp[0].sv_val));
     }
-#line 2085 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 2132 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
-  case 59: /* selector: '*'  */
-#line 351 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+  case 63: /* selector: '*'  */
+#line 380 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
     {
         (yyval.sv_select_cols) = {};
     }
-#line 2093 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 2140 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
-  case 61: /* tableList: tbName  */
-#line 359 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+  case 65: /* tableList: tbName  */
+#line 388 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
     {
         (yyval.sv_strs) = std::vector<std::string>{(yyvsp[0].sv_str)};
     }
-#line 2101 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 2148 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
-  case 62: /* tableList: tableList ',' tbName  */
-#line 363 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+  case 66: /* tableList: tableList ',' tbName  */
+#line 392 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
     {
         (yyval.sv_strs).push_back((yyvsp[0].sv_str));
     }
-#line 2109 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 2156 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
-  case 63: /* tableList: tableList JOIN tbName  */
-#line 367 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+  case 67: /* tableList: tableList JOIN tbName  */
+#line 396 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
     {
         (yyval.sv_strs).push_back((yyvsp[0].sv_str));
     }
-#line 2117 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 2164 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
-  case 64: /* order_clauses: ORDER BY order_clause  */
-#line 374 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+  case 68: /* order_clauses: ORDER BY order_clause  */
+#line 403 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
         {
 		(yyval.sv_orderbys_) = std::vector<std::shared_ptr<OrderBy> >{(yyvsp[0].sv_orderby)};
 	}
-#line 2125 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 2172 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
-  case 65: /* order_clauses: order_clauses ',' order_clause  */
-#line 378 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+  case 69: /* order_clauses: order_clauses ',' order_clause  */
+#line 407 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
         {
 		(yyval.sv_orderbys_).push_back((yyvsp[0].sv_orderby));
 	}
-#line 2133 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 2180 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
-  case 66: /* order_clauses: %empty  */
-#line 381 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+  case 70: /* order_clauses: %empty  */
+#line 410 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
                         {
 		(yyval.sv_orderbys_) = std::vector<std::shared_ptr<OrderBy> >(0);
 	}
-#line 2141 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 2188 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
-  case 67: /* order_clause: col opt_asc_desc  */
-#line 387 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+  case 71: /* order_clause: col opt_asc_desc  */
+#line 416 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
     { 
         (yyval.sv_orderby) = std::make_shared<OrderBy>((yyvsp[-1].sv_col), (yyvsp[0].sv_orderby_dir));
     }
-#line 2149 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 2196 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
-  case 68: /* opt_asc_desc: ASC  */
-#line 393 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+  case 72: /* opt_asc_desc: ASC  */
+#line 422 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
                  { (yyval.sv_orderby_dir) = OrderBy_ASC;     }
-#line 2155 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 2202 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
-  case 69: /* opt_asc_desc: DESC  */
-#line 394 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+  case 73: /* opt_asc_desc: DESC  */
+#line 423 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
                  { (yyval.sv_orderby_dir) = OrderBy_DESC;    }
-#line 2161 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 2208 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
-  case 70: /* opt_asc_desc: %empty  */
-#line 395 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+  case 74: /* opt_asc_desc: %empty  */
+#line 424 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
             { (yyval.sv_orderby_dir) = OrderBy_DEFAULT; }
-#line 2167 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 2214 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
-  case 71: /* opt_limit: LIMIT VALUE_INT  */
-#line 399 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+  case 75: /* opt_limit: LIMIT VALUE_INT  */
+#line 428 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
                         { (yyval.sv_int) = (yyvsp[0].sv_int); }
-#line 2173 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 2220 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
-  case 72: /* opt_limit: %empty  */
-#line 400 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+  case 76: /* opt_limit: %empty  */
+#line 429 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
                         { (yyval.sv_int) = -1; }
-#line 2179 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 2226 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
-  case 73: /* selectColList: selectCol  */
-#line 404 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+  case 77: /* selectColList: selectCol  */
+#line 433 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
         {
                 (yyval.sv_select_cols) = std::vector<std::shared_ptr<SelectCol>>{(yyvsp[0].sv_select_col)};
 	}
-#line 2187 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 2234 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
-  case 74: /* selectColList: selectColList ',' selectCol  */
-#line 408 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+  case 78: /* selectColList: selectColList ',' selectCol  */
+#line 437 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
         {
                 (yyval.sv_select_cols).push_back((yyvsp[0].sv_select_col));
         }
-#line 2195 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 2242 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
-  case 75: /* selectCol: aggregateFunc '(' '*' ')' AS colName  */
-#line 415 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+  case 79: /* selectCol: aggregateFunc '(' '*' ')' AS colName  */
+#line 444 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
         {
 		(yyval.sv_select_col) = std::make_shared<SelectCol>((yyvsp[-5].sv_func), nullptr, (yyvsp[0].sv_str));
 	}
-#line 2203 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 2250 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
-  case 76: /* selectCol: aggregateFunc '(' col ')' AS colName  */
-#line 419 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+  case 80: /* selectCol: aggregateFunc '(' col ')' AS colName  */
+#line 448 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
         {
         	(yyval.sv_select_col) = std::make_shared<SelectCol>((yyvsp[-5].sv_func), (yyvsp[-3].sv_col), (yyvsp[0].sv_str));
         }
-#line 2211 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 2258 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
-  case 77: /* selectCol: aggregateFunc '(' col ')'  */
-#line 423 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+  case 81: /* selectCol: aggregateFunc '(' col ')'  */
+#line 452 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
         {
                 (yyval.sv_select_col) = std::make_shared<SelectCol>((yyvsp[-3].sv_func), (yyvsp[-1].sv_col));
         }
-#line 2219 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 2266 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
-  case 78: /* selectCol: col  */
-#line 427 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+  case 82: /* selectCol: col  */
+#line 456 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
         {
          	(yyval.sv_select_col) = std::make_shared<SelectCol>(SV_FUNC_NULL, (yyvsp[0].sv_col));
         }
-#line 2227 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 2274 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
-  case 79: /* aggregateFunc: COUNT  */
-#line 433 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+  case 83: /* aggregateFunc: COUNT  */
+#line 462 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
               { (yyval.sv_func) = SV_FUNC_COUNT; }
-#line 2233 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 2280 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
-  case 80: /* aggregateFunc: MAX  */
-#line 434 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+  case 84: /* aggregateFunc: MAX  */
+#line 463 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
               { (yyval.sv_func) = SV_FUNC_MAX; }
-#line 2239 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 2286 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
-  case 81: /* aggregateFunc: MIN  */
-#line 435 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+  case 85: /* aggregateFunc: MIN  */
+#line 464 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
               { (yyval.sv_func) = SV_FUNC_MIN; }
-#line 2245 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 2292 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
-  case 82: /* aggregateFunc: SUM  */
-#line 436 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+  case 86: /* aggregateFunc: SUM  */
+#line 465 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
               { (yyval.sv_func) = SV_FUNC_SUM; }
-#line 2251 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 2298 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
     break;
 
 
-#line 2255 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
+#line 2302 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.tab.cpp"
 
       default: break;
     }
@@ -2480,7 +2527,7 @@ yyreturnlab:
   return yyresult;
 }
 
-#line 443 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
+#line 472 "/home/sarail/CLionProjects/oshinodb/src/parser/yacc.y"
 
 
 
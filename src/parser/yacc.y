@@ -1,6 +1,8 @@
 %{
 #include "ast.h"
 #include "yacc.tab.h"
+#include <strings.h>
+
 #include <iostream>
 #include <memory>
 
@@ -41,6 +43,7 @@ WHERE UPDATE SET SELECT INT CHAR FLOAT BIGINT DATETIME INDEX AND JOIN EXIT HELP
 %type <sv_expr> expr
 %type <sv_val> value
 %type <sv_vals> valueList
+%type <sv_val_rows> valueRows
 %type <sv_str> tbName colName
 %type <sv_strs> tableList colNameList
 %type <sv_col> col
@@ -116,6 +119,10 @@ dbStmt:
     {
 	$$ = std::make_shared<ShowIndex>($4);
     }
+    |   SET IDENTIFIER '=' value
+    {
+        $$ = std::make_shared<SetKnob>($2, $4);
+    }
     ;
 
 ddl:
@@ -142,9 +149,9 @@ ddl:
     ;
 
 dml:
-        INSERT INTO tbName VALUES '(' valueList ')'
+        INSERT INTO tbName VALUES valueRows
     {
-        $$ = std::make_shared<InsertStmt>($3, $6);
+        $$ = std::make_shared<InsertStmt>($3, std::move(*$5));
     }
     |   DELETE FROM tbName optWhereClause
     {
@@ -210,6 +217,15 @@ type:
     {
     	$$ = std::make_shared<TypeLen>(SV_TYPE_DATETIME, 19);
     }
+    |   IDENTIFIER '(' VALUE_INT ')'
+    {
+        // VARCHAR不是词法关键字，作为标识符识别
+        if (strcasecmp($1.c_str(), "VARCHAR") != 0) {
+            yyerror(&@1, ("unknown type " + $1).c_str());
+            YYERROR;
+        }
+        $$ = std::make_shared<TypeLen>(SV_TYPE_VARCHAR, $3);
+    }
     ;
 
 valueList:
@@ -223,6 +239,19 @@ valueList:
     }
     ;
 
+valueRows:
+        '(' valueList ')'
+    {
+        $$ = std::make_shared<std::vector<std::vector<std::shared_ptr<Value>>>>();
+        $$->push_back(std::move($2));
+    }
+    |   valueRows ',' '(' valueList ')'
+    {
+        $$ = std::move($1);
+        $$->push_back(std::move($4));
+    }
+    ;
+
 value:
         VALUE_INT
     {
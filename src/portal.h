@@ -161,11 +161,11 @@ public:
         if (auto x = std::dynamic_pointer_cast<ProjectionPlan>(plan)) {
             std::cerr << "proj executor" << std::endl;
             return std::make_unique<ProjectionExecutor>(convert_plan_executor(x->subplan_, context),
-                                                        x->sel_cols_);
+                                                        x->sel_cols_, context);
         } else if (auto x = std::dynamic_pointer_cast<AggregatePlan>(plan)) {
             std::cerr << "aggregate executor" << std::endl;
             return std::make_unique<AggregateExecutor>(convert_plan_executor(x->subplan_, context),
-                                                       x->sel_cols_);
+                                                       x->sel_cols_, context);
         } else if (auto x = std::dynamic_pointer_cast<ScanPlan>(plan)) {
             if (x->tag == T_SeqScan) {
                 std::cerr << "seq scan executor" << std::endl;
@@ -181,11 +181,12 @@ public:
             std::unique_ptr<AbstractExecutor> right = convert_plan_executor(x->right_, context);
             std::unique_ptr<AbstractExecutor> join = std::make_unique<NestedLoopJoinExecutor>(
                     std::move(left),
-                    std::move(right), std::move(x->conds_));
+                    std::move(right), std::move(x->conds_), context);
             return join;
         } else if (auto x = std::dynamic_pointer_cast<SortPlan>(plan)) {
             std::cerr << "sort executor" << std::endl;
-            return std::make_unique<SortExecutor>(convert_plan_executor(x->subplan_, context),x->key_cols_, x->limit);
+            return std::make_unique<SortExecutor>(convert_plan_executor(x->subplan_, context),x->key_cols_, x->limit,
+                                                  context);
         }
         return nullptr;
     }
@@ -13,9 +13,19 @@ See the Mulan PSL v2 for more details. */
 #include <cinttypes>
 #include <cstring>
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
 static constexpr int BITMAP_WIDTH = 8;
 static constexpr unsigned BITMAP_HIGHEST_BIT = 0x80u;  // 128 (2^7)
 
+/*
+位图中第pos位位于第pos / 8个字节，在字节内从最高位开始编号。查找和计数按64位的字进行：
+连续8个字节按大端序组成一个字，字的最高位即编号最小的位，因此可以用__builtin_clzll直接得到位的编号，磁盘上的格式不变。
+编译时开启AVX2时，查找先以256位为单位跳过不含目标位的块
+*/
+
 class Bitmap {
 public:
     // 从地址bm开始的size个字节全部置0
@@ -39,9 +49,20 @@ public:
      * @return 找到了就返回偏移位置，没找到就返回max_n
      */
     static int next_bit(bool bit, const char *bm, int max_n, int curr) {
-        for (int i = curr + 1; i < max_n; i++) {
-            if (is_set(bm, i) == bit) {
-                return i;
+        int pos = curr + 1;
+        int num_bytes = (max_n + BITMAP_WIDTH - 1) / BITMAP_WIDTH;
+        // 找0时将字取反，统一为找1；位图末尾补的0取反后为1，找到的位置超出max_n时返回max_n
+        uint64_t flip = bit ? 0 : ~0ull;
+        for (int base = pos / 64 * 64; base < max_n; base += 64) {
+#if defined(__AVX2__)
+            base = skip_blocks(bit, bm, base, num_bytes);
+            if (base >= max_n) break;
+#endif
+            uint64_t word = load_word(bm, base, num_bytes) ^ flip;
+            if (base < pos) word &= ~0ull >> (pos - base);
+            if (word != 0) {
+                int i = base + __builtin_clzll(word);
+                return i < max_n ? i : max_n;
             }
         }
         return max_n;
@@ -50,11 +71,49 @@ public:
     // 找第一个为0 or 1的位
     static int first_bit(bool bit, const char *bm, int max_n) { return next_bit(bit, bm, max_n, -1); }
 
+    // 统计[0, max_n)中为1的位的个数
+    static int count(const char *bm, int max_n) {
+        int num_bytes = (max_n + BITMAP_WIDTH - 1) / BITMAP_WIDTH;
+        int num = 0;
+        for (int base = 0; base < max_n; base += 64) {
+            uint64_t word = load_word(bm, base, num_bytes);
+            // 最后一个字中超出max_n的位不计入
+            if (max_n - base < 64) word &= ~(~0ull >> (max_n - base));
+            num += __builtin_popcountll(word);
+        }
+        return num;
+    }
+
     // for example:
     // rid_.slot_no = Bitmap::next_bit(true, page_handle.bitmap, file_handle_->file_hdr_.num_records_per_page,
     // rid_.slot_no); int slot_no = Bitmap::first_bit(false, page_handle.bitmap, file_hdr_.num_records_per_page);
 
 private:
+    // 读取从第base位开始的64位，第base位在字的最高位；位图的字节数num_bytes之后的部分补0
+    static uint64_t load_word(const char *bm, int base, int num_bytes) {
+        int byte = base / BITMAP_WIDTH;
+        uint64_t word = 0;
+        memcpy(&word, bm + byte, num_bytes - byte < 8 ? num_bytes - byte : 8);
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        word = __builtin_bswap64(word);
+#endif
+        return word;
+    }
+
+#if defined(__AVX2__)
+    // 从第base位开始，以256位为单位跳过全为!bit的块，返回第一个可能含有目标位的块的起始位置；base需按64位对齐
+    static int skip_blocks(bool bit, const char *bm, int base, int num_bytes) {
+        if (base % 256 != 0) return base;
+        const __m256i ones = _mm256_set1_epi8(-1);
+        while ((base + 256) / BITMAP_WIDTH <= num_bytes) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(bm + base / BITMAP_WIDTH));
+            if (bit ? !_mm256_testz_si256(v, v) : !_mm256_testc_si256(v, ones)) break;
+            base += 256;
+        }
+        return base;
+    }
+#endif
+
     static int get_bucket(int pos) { return pos / BITMAP_WIDTH; }
 
     static char get_bit(int pos) { return BITMAP_HIGHEST_BIT >> static_cast<char>(pos % BITMAP_WIDTH); }
@@ -10,6 +10,7 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include "common/arena.h"
 #include "defs.h"
 #include "storage/buffer_pool_manager.h"
 
@@ -17,23 +18,77 @@ constexpr int RM_NO_PAGE = -1;
 constexpr int RM_FILE_HDR_PAGE = 0;
 constexpr int RM_FIRST_RECORD_PAGE = 1;
 constexpr int RM_MAX_RECORD_SIZE = 512;
+constexpr int RM_MAX_VAR_FIELDS = 32;
+
+/* 表数据文件的存储格式 */
+enum RmFormat : int {
+    RM_FORMAT_FIXED = 0,        // 定长格式：每个slot存放一条record_size大小的记录，由位图记录slot是否被占用
+    RM_FORMAT_SLOTTED = 1,      // 槽页格式：变长字段去掉末尾的'\0'后存储，页面通过槽目录定位记录
+};
+
+/* 记录中的变长字段，占据记录的[offset, offset + len)，内存中仍按定长存放，存储时只保留到最后一个非'\0'字节 */
+struct RmVarField {
+    int offset;
+    int len;
+};
 
 /* 文件头，记录表数据文件的元信息，写入磁盘中文件的第0号页面 */
 struct RmFileHdr {
-    int record_size;            // 表中每条记录的大小，由于不包含变长字段，因此当前字段初始化后保持不变
+    int record_size;            // 表中每条记录在内存中的大小，槽页格式中存储的记录可能更短
     int num_pages;              // 文件中分配的页面个数（初始化为1）
     int num_records_per_page;   // 每个页面最多能存储的元组个数
     int first_free_page_no;     // 文件中当前第一个包含空闲空间的页面号（初始化为-1）
     int bitmap_size;            // 每个页面bitmap大小
     int lsn;                    // 日志编号
+    int first_fsm_page_no;      // 第一个空闲空间映射页的页号（初始化为-1），为0表示文件创建于引入空闲空间映射之前，不维护映射
+    int format;                 // 存储格式RmFormat，文件创建于引入槽页格式之前时为0，即定长格式
+    int num_var_fields;         // 槽页格式中变长字段的个数
+    RmVarField var_fields[RM_MAX_VAR_FIELDS];   // 槽页格式中的变长字段，按offset递增排列
 };
 
+/* 空闲空间映射（FSM）：记录文件中每个页面的空闲状态，每个页面占一个字节。
+ * 映射页按需分配并串成链表，第i个映射页记录页面[i * RM_FSM_ENTRIES_PER_PAGE, (i + 1) * RM_FSM_ENTRIES_PER_PAGE)，
+ * 不存在的映射页所覆盖的页面均为空。文件头页和映射页本身在映射中始终为空，扫描时跳过所有为空的页面 */
+struct RmFsmPageHdr {
+    int next_fsm_page_no;   // 下一个映射页的页号，没有时为RM_NO_PAGE
+};
+
+constexpr int RM_FSM_ENTRIES_OFFSET = Page::OFFSET_PAGE_HDR + sizeof(RmFsmPageHdr);
+constexpr int RM_FSM_ENTRIES_PER_PAGE = PAGE_SIZE - RM_FSM_ENTRIES_OFFSET;
+
+constexpr int RM_FSM_DISABLED = RM_FILE_HDR_PAGE;    // first_fsm_page_no为该值时文件不维护空闲空间映射
+
+/* 空闲空间映射中页面的状态 */
+enum RmFsmState : char { RM_FSM_EMPTY = 0, RM_FSM_PARTIAL = 1, RM_FSM_FULL = 2 };
+
 /* 表数据文件中每个页面的页头，记录每个页面的元信息 */
 struct RmPageHdr {
     int next_free_page_no;  // 当前页面满了之后，下一个包含空闲空间的页面号（初始化为-1）
     int num_records;        // 当前页面中当前已经存储的记录个数（初始化为0）
 };
 
+/* 槽页格式的页头，紧跟在RmPageHdr之后，之后是槽目录；记录数据从页尾向前存放。
+ * num_records为被占用的槽数，页面剩余空间足够存放一条最长的记录时页面位于空闲页面链表中 */
+struct RmSlottedPageHdr {
+    int num_slots;          // 槽目录中的槽数，包括空槽
+    int data_begin;         // 记录数据区的起始偏移，[data_begin, PAGE_SIZE)为数据区
+    int free_bytes;         // 可用的字节数，包括槽目录与数据区之间的空间和数据区中被删除记录留下的空洞
+    int in_free_list;       // 页面是否位于空闲页面链表中
+};
+
+/* 槽目录中的一项 */
+struct RmSlot {
+    uint16_t offset;        // 记录在页面中的偏移，为0表示空槽
+    uint16_t len;           // 低位为记录占用的字节数，高位为标志位
+};
+
+constexpr uint16_t RM_SLOT_FORWARD = 0x8000;    // 记录因更新后变长而迁移到了其他页面，槽中存放迁移后的Rid
+constexpr uint16_t RM_SLOT_MOVED = 0x4000;      // 从其他页面迁移来的记录，数据前存放记录原来的Rid，扫描时跳过
+constexpr uint16_t RM_SLOT_LEN_MASK = 0x1fff;
+
+constexpr int RM_SLOT_DIR_OFFSET = Page::OFFSET_PAGE_HDR + sizeof(RmPageHdr) + sizeof(RmSlottedPageHdr);
+constexpr int RM_MIN_SLOT_BYTES = sizeof(Rid);  // 每条记录至少占用的字节数，保证原地改为迁移标记时放得下
+
 /* 表中的记录 */
 struct RmRecord {
     char* data;  // 记录的数据
@@ -42,9 +97,11 @@ struct RmRecord {
 
     RmRecord(): data(nullptr), size(0), allocated_(false) {};
 
+    // 拷贝总是为数据分配新的空间，即使other的数据来自Arena，拷贝出的记录也可以在语句结束后继续使用
     RmRecord(const RmRecord& other) {
         size = other.size;
-        allocated_ = other.allocated_;
+        allocated_ = other.data != nullptr;
+        data = nullptr;
         if (other.data != nullptr) {
             data = new char[size];
             memcpy(data, other.data, size);
@@ -52,9 +109,12 @@ struct RmRecord {
     };
 
     RmRecord &operator=(const RmRecord& other) {
+        if (this == &other) return *this;
+        if (allocated_) delete[] data;
         size = other.size;
-        allocated_ = other.allocated_;
-        if (other.data != nullptr && other.allocated_) {
+        allocated_ = other.data != nullptr;
+        data = nullptr;
+        if (other.data != nullptr) {
             data = new char[size];
             memcpy(data, other.data, size);
         }
@@ -75,6 +135,17 @@ struct RmRecord {
         allocated_ = true;
     }
 
+    // 数据从arena中分配，随arena一起释放
+    RmRecord(int size_, Arena *arena) {
+        size = size_;
+        data = arena->allocate(size_);
+        allocated_ = false;
+    }
+
+    RmRecord(int size_, const char* data_, Arena *arena) : RmRecord(size_, arena) {
+        memcpy(data, data_, size_);
+    }
+
     void SetData(char* data_) {
         memcpy(data, data_, size);
     }
@@ -85,6 +156,7 @@ struct RmRecord {
             delete[] data;
         }
         data = new char[size];
+        allocated_ = true;
         memcpy(data, data_ + sizeof(int), size);
     }
 
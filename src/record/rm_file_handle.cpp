@@ -10,20 +10,31 @@ See the Mulan PSL v2 for more details. */
 
 #include "rm_file_handle.h"
 
+#include <algorithm>
+
 /**
  * @description: 获取当前表中记录号为rid的记录
  * @param {Rid&} rid 记录号，指定记录的位置
  * @param {Context*} context
+ * @param {BufferAccessStrategy*} strategy 缓冲池访问策略，为nullptr时使用整个缓冲池
  * @return {unique_ptr<RmRecord>} rid对应的记录对象指针
  */
-std::unique_ptr<RmRecord> RmFileHandle::get_record(const Rid &rid, Context *context) const {
+std::unique_ptr<RmRecord> RmFileHandle::get_record(const Rid &rid, Context *context,
+                                                   BufferAccessStrategy *strategy) const {
     // Todo:
     // 1. 获取指定记录所在的page handle
     // 2. 初始化一个指向RmRecord的指针（赋值其内部的data和size）
     if (context != nullptr && !context->lock_mgr_->lock_shared_on_record(context->txn_, rid, fd_))
         throw TransactionAbortException(context->txn_->get_transaction_id(), AbortReason::DEADLOCK_PREVENTION);
 
-    auto page_handle = fetch_page_handle(rid.page_no);
+    auto page_handle = fetch_page_handle(rid.page_no, strategy);
+    if (is_slotted()) {
+        auto record_ptr = std::make_unique<RmRecord>(file_hdr_.record_size);
+        bool found = read_slotted_record(page_handle, rid.slot_no, record_ptr->data, strategy);
+        buffer_pool_manager_->unpin_page({fd_, rid.page_no}, false);
+        if (!found) throw RecordNotFoundError(rid.page_no, rid.slot_no);
+        return record_ptr;
+    }
     auto data = page_handle.get_slot(rid.slot_no);
 
     auto record_ptr = std::make_unique<RmRecord>(file_hdr_.record_size, data);
@@ -32,6 +43,30 @@ std::unique_ptr<RmRecord> RmFileHandle::get_record(const Rid &rid, Context *cont
     return record_ptr;
 }
 
+/**
+ * @description: 获取记录的只读视图，不拷贝记录数据，记录所在页面在视图析构前保持pin
+ * @return {RecordView} 指向页面中rid对应slot的视图
+ * @param {Rid&} rid 记录号，指定记录的位置
+ * @param {Context*} context
+ * @param {BufferAccessStrategy*} strategy 缓冲池访问策略，为nullptr时使用普通的替换策略
+ */
+RecordView RmFileHandle::get_record_view(const Rid &rid, Context *context, BufferAccessStrategy *strategy) const {
+    if (context != nullptr && !context->lock_mgr_->lock_shared_on_record(context->txn_, rid, fd_))
+        throw TransactionAbortException(context->txn_->get_transaction_id(), AbortReason::DEADLOCK_PREVENTION);
+
+    auto page_handle = fetch_page_handle(rid.page_no, strategy);
+    if (is_slotted()) {
+        // 槽页格式中的记录需要解码，视图持有解码后的数据，页面随即unpin
+        std::unique_ptr<char[]> decoded(new char[file_hdr_.record_size]);
+        bool found = read_slotted_record(page_handle, rid.slot_no, decoded.get(), strategy);
+        buffer_pool_manager_->unpin_page({fd_, rid.page_no}, false);
+        if (!found) throw RecordNotFoundError(rid.page_no, rid.slot_no);
+        return RecordView(std::move(decoded), file_hdr_.record_size);
+    }
+    return RecordView(buffer_pool_manager_, page_handle.page->get_page_id(), page_handle.get_slot(rid.slot_no),
+                      file_hdr_.record_size);
+}
+
 /**
  * @description: 在当前表中插入一条记录，不指定插入位置
  * @param {char*} buf 要插入的记录的数据
@@ -45,17 +80,18 @@ Rid RmFileHandle::insert_record(char *buf, Context *context) {
     // 3. 将buf复制到空闲slot位置
     // 4. 更新page_handle.page_hdr中的数据结构
     // 注意考虑插入一条记录后页面已满的情况，需要更新file_hdr_.first_free_page_no
-    auto page_handle = create_page_handle();
-
-    PageLogRecord* page_log;
-    char* file_hdr_page;
-    if (context != nullptr) {
-        page_log = new PageLogRecord(context->txn_->get_transaction_id(), context->txn_->get_prev_lsn(),
-                                 disk_manager_->get_file_name(fd_), page_handle.page->get_page_id().page_no,
-                                 (char *) page_handle.page);
-        file_hdr_page = new char[PAGE_SIZE]();
-        memmove(file_hdr_page, &file_hdr_, sizeof(file_hdr_));
+    if (is_slotted()) {
+        char encoded[RM_MAX_RECORD_SIZE + RM_MAX_VAR_FIELDS * sizeof(uint16_t)];
+        RmFileHdr old_hdr = file_hdr_;
+        auto rid = insert_slotted(encoded, encode_record(buf, encoded), 0, context);
+        log_file_hdr_change(old_hdr, context);
+        return rid;
     }
+    // 分配新页面时会修改文件头，需要在此之前保存修改前的文件头
+    RmFileHdr old_hdr = file_hdr_;
+    auto page_handle = create_page_handle();
+    char old_image[PAGE_SIZE];
+    memmove(old_image, page_handle.page->get_data(), PAGE_SIZE);
 
     auto pos =
             Bitmap::first_bit(false, page_handle.bitmap, page_handle.file_hdr->num_records_per_page);
@@ -76,26 +112,103 @@ Rid RmFileHandle::insert_record(char *buf, Context *context) {
     Bitmap::set(page_handle.bitmap, pos);
 
     // 写入日志
-    if (context != nullptr) {
-        page_log->set_new_page((char *) page_handle.page);
-        auto lsn = context->log_mgr_->add_log_to_buffer(page_log);
-        page_handle.page->set_page_lsn(lsn);
+    log_page_change(page_handle.page, old_image, context);
+    // 更新空闲空间映射，可能分配新的映射页并修改文件头，因此在记录文件头的日志之前进行
+    update_fsm(page_handle, context);
+    log_file_hdr_change(old_hdr, context);
 
-        PageLogRecord hdr_page_log(context->txn_->get_transaction_id(), lsn,
-                                          disk_manager_->get_file_name(fd_), RM_FILE_HDR_PAGE,
-                                          file_hdr_page);
-        memmove(file_hdr_page, &file_hdr_, sizeof(file_hdr_));
-        hdr_page_log.set_new_page(file_hdr_page);
-        lsn = context->log_mgr_->add_log_to_buffer(&hdr_page_log);
-        context->txn_->set_prev_lsn(lsn);
-        file_hdr_.lsn = lsn;
+    buffer_pool_manager_->unpin_page(page_handle.page->get_page_id(), true);
+    return rid;
+}
+
+/**
+ * @description: 批量插入记录：每个页面固定一次并放入尽可能多的记录，每个被修改的页面写一条页面日志，
+ *               文件头和空闲页面链表在整批插入后只记录一次日志
+ * @param {vector<char*>&} bufs 要插入的各条记录的数据
+ * @param {Context*} context
+ * @return {vector<Rid>} 各条记录插入的位置，与bufs一一对应
+ */
+std::vector<Rid> RmFileHandle::insert_records(const std::vector<char *> &bufs, Context *context) {
+    std::vector<Rid> rids;
+    rids.reserve(bufs.size());
+    RmFileHdr old_hdr = file_hdr_;
+    char old_image[PAGE_SIZE];
+    while (rids.size() < bufs.size()) {
+        auto page_handle = create_page_handle();
+        memmove(old_image, page_handle.page->get_data(), PAGE_SIZE);
+        auto finish_page = [&]() {
+            log_page_change(page_handle.page, old_image, context);
+            update_fsm(page_handle, context);
+            buffer_pool_manager_->unpin_page(page_handle.page->get_page_id(), true);
+        };
+        try {
+            if (is_slotted()) {
+                fill_slotted_page(page_handle, bufs, rids, context);
+            } else {
+                fill_page(page_handle, bufs, rids, context);
+            }
+        } catch (TransactionAbortException &e) {
+            // 加锁失败时本批次已插入的记录还不在事务的写集合中，需要在这里删除
+            finish_page();
+            log_file_hdr_change(old_hdr, context);
+            for (auto &rid : rids) delete_record(rid, context);
+            throw;
+        }
+        finish_page();
+    }
+    log_file_hdr_change(old_hdr, context);
+    return rids;
+}
 
-        delete file_hdr_page;
-        delete page_log;
+/**
+ * @description: 将bufs中尚未插入的记录依次放入定长格式的页面，直到页面已满或全部插入，页面已满时移出空闲页面链表
+ * @param {RmPageHandle&} page_handle 空闲页面链表中的第一个页面
+ * @param {vector<char*>&} bufs 要插入的各条记录的数据
+ * @param {vector<Rid>&} rids 已插入的记录的位置，新插入的记录追加在末尾
+ * @param {Context*} context
+ */
+void RmFileHandle::fill_page(RmPageHandle &page_handle, const std::vector<char *> &bufs, std::vector<Rid> &rids,
+                             Context *context) {
+    int num_slots = file_hdr_.num_records_per_page;
+    int pos = Bitmap::first_bit(false, page_handle.bitmap, num_slots);
+    while (rids.size() < bufs.size() && page_handle.page_hdr->num_records < num_slots) {
+        auto rid = Rid{page_handle.page->get_page_id().page_no, pos};
+        if (context != nullptr && !context->lock_mgr_->lock_exclusive_on_record(context->txn_, rid, fd_))
+            throw TransactionAbortException(context->txn_->get_transaction_id(), AbortReason::DEADLOCK_PREVENTION);
+        memmove(page_handle.get_slot(pos), bufs[rids.size()], file_hdr_.record_size);
+        Bitmap::set(page_handle.bitmap, pos);
+        page_handle.page_hdr->num_records++;
+        rids.push_back(rid);
+        pos = Bitmap::next_bit(false, page_handle.bitmap, num_slots, pos);
+    }
+    if (page_handle.page_hdr->num_records >= num_slots) {
+        file_hdr_.first_free_page_no = page_handle.page_hdr->next_free_page_no;
     }
+}
 
-    buffer_pool_manager_->unpin_page(page_handle.page->get_page_id(), true);
-    return rid;
+/**
+ * @description: 将bufs中尚未插入的记录编码后依次放入槽页，直到页面放不下或全部插入，
+ *               页面放不下最长的记录时移出空闲页面链表
+ */
+void RmFileHandle::fill_slotted_page(RmPageHandle &page_handle, const std::vector<char *> &bufs,
+                                     std::vector<Rid> &rids, Context *context) {
+    auto slotted_hdr = page_handle.slotted_hdr();
+    char encoded[RM_MAX_RECORD_SIZE + RM_MAX_VAR_FIELDS * sizeof(uint16_t)];
+    int slot_no = 0;
+    while (rids.size() < bufs.size()) {
+        int len = encode_record(bufs[rids.size()], encoded);
+        while (slot_no < slotted_hdr->num_slots && page_handle.slot_dir()[slot_no].offset != 0) slot_no++;
+        if (!has_room(page_handle, len, slot_no)) break;
+        auto rid = Rid{page_handle.page->get_page_id().page_no, slot_no};
+        if (context != nullptr && !context->lock_mgr_->lock_exclusive_on_record(context->txn_, rid, fd_))
+            throw TransactionAbortException(context->txn_->get_transaction_id(), AbortReason::DEADLOCK_PREVENTION);
+        place_slotted(page_handle, slot_no, encoded, len, 0);
+        rids.push_back(rid);
+    }
+    if (!has_room(page_handle, max_stored_size(), slotted_hdr->num_slots)) {
+        file_hdr_.first_free_page_no = page_handle.page_hdr->next_free_page_no;
+        slotted_hdr->in_free_list = 0;
+    }
 }
 
 /**
@@ -105,6 +218,10 @@ Rid RmFileHandle::insert_record(char *buf, Context *context) {
  * @note 回滚时使用
  */
 void RmFileHandle::insert_record(const Rid &rid, char *buf) {
+    if (is_slotted()) {
+        store_slotted(rid, buf, nullptr);
+        return;
+    }
     auto page_handle = fetch_page_handle(rid.page_no);
     auto data = page_handle.get_slot(rid.slot_no);
 
@@ -118,8 +235,9 @@ void RmFileHandle::insert_record(const Rid &rid, char *buf) {
  * @description: 删除记录文件中记录号为rid的记录
  * @param {Rid&} rid 要删除的记录的记录号（位置）
  * @param {Context*} context
+ * @param {BufferAccessStrategy*} strategy 缓冲池访问策略，为nullptr时使用整个缓冲池
  */
-void RmFileHandle::delete_record(const Rid &rid, Context *context) {
+void RmFileHandle::delete_record(const Rid &rid, Context *context, BufferAccessStrategy *strategy) {
     // done
     // 1. 获取指定记录所在的page handle
     // 2. 更新page_handle.page_hdr中的数据结构
@@ -127,18 +245,33 @@ void RmFileHandle::delete_record(const Rid &rid, Context *context) {
     if (context != nullptr && !context->lock_mgr_->lock_exclusive_on_record(context->txn_, rid, fd_))
         throw TransactionAbortException(context->txn_->get_transaction_id(), AbortReason::DEADLOCK_PREVENTION);
 
-    auto page_handle = fetch_page_handle(rid.page_no);
-
-    // 初始化日至记录
-    PageLogRecord* page_log;
-    char* file_hdr_page;
-    if (context != nullptr) {
-        page_log = new PageLogRecord(context->txn_->get_transaction_id(), context->txn_->get_prev_lsn(),
-                                 disk_manager_->get_file_name(fd_), page_handle.page->get_page_id().page_no,
-                                 (char *) page_handle.page);
-        file_hdr_page = new char[PAGE_SIZE]();
-        memmove(file_hdr_page, &file_hdr_, sizeof(file_hdr_));
+    if (is_slotted()) {
+        auto page_handle = fetch_page_handle(rid.page_no, strategy);
+        char old_image[PAGE_SIZE];
+        memmove(old_image, page_handle.page->get_data(), PAGE_SIZE);
+        RmFileHdr old_hdr = file_hdr_;
+
+        auto slot = page_handle.slot_dir()[rid.slot_no];
+        if (slot.len & RM_SLOT_FORWARD) {
+            Rid target;
+            memcpy(&target, page_handle.page->get_data() + slot.offset, sizeof(Rid));
+            delete_moved(target, context, strategy);
+        }
+        free_slotted(page_handle, rid.slot_no);
+        release_slotted_page(page_handle);
+
+        log_page_change(page_handle.page, old_image, context);
+        update_fsm(page_handle, context);
+        log_file_hdr_change(old_hdr, context);
+        buffer_pool_manager_->unpin_page({fd_, rid.page_no}, true);
+        return;
     }
+
+    auto page_handle = fetch_page_handle(rid.page_no, strategy);
+    char old_image[PAGE_SIZE];
+    memmove(old_image, page_handle.page->get_data(), PAGE_SIZE);
+    RmFileHdr old_hdr = file_hdr_;
+
     // 开始写入
     memset(page_handle.get_slot(rid.slot_no), 0, file_hdr_.record_size);
     Bitmap::reset(page_handle.bitmap, rid.slot_no);
@@ -149,23 +282,9 @@ void RmFileHandle::delete_record(const Rid &rid, Context *context) {
     page_handle.page_hdr->num_records--;
 
     // 写入日志
-    if (context != nullptr) {
-        page_log->set_new_page((char *) page_handle.page);
-        auto lsn = context->log_mgr_->add_log_to_buffer(page_log);
-        page_handle.page->set_page_lsn(lsn);
-
-        auto hdr_page_log = PageLogRecord(context->txn_->get_transaction_id(), lsn,
-                                          disk_manager_->get_file_name(fd_), RM_FILE_HDR_PAGE,
-                                          file_hdr_page);
-        memmove(file_hdr_page, &file_hdr_, sizeof(file_hdr_));
-        hdr_page_log.set_new_page(file_hdr_page);
-        lsn = context->log_mgr_->add_log_to_buffer(&hdr_page_log);
-        file_hdr_.lsn = lsn;
-        context->txn_->set_prev_lsn(lsn);
-
-        delete file_hdr_page;
-        delete page_log;
-    }
+    log_page_change(page_handle.page, old_image, context);
+    update_fsm(page_handle, context);
+    log_file_hdr_change(old_hdr, context);
 
     buffer_pool_manager_->unpin_page({fd_, rid.page_no}, true);
 }
@@ -184,28 +303,22 @@ void RmFileHandle::update_record(const Rid &rid, char *buf, Context *context) {
     if (context != nullptr && !context->lock_mgr_->lock_exclusive_on_record(context->txn_, rid, fd_))
         throw TransactionAbortException(context->txn_->get_transaction_id(), AbortReason::DEADLOCK_PREVENTION);
 
-    auto page_handle = fetch_page_handle(rid.page_no);
+    if (is_slotted()) {
+        // 更新后的记录可能变长，放不下时迁移到其他页面
+        store_slotted(rid, buf, context);
+        return;
+    }
 
-    // 生成日志记录，不需要修改file_hdr
-    PageLogRecord* page_log;
-    if (context != nullptr)
-        page_log = new PageLogRecord(context->txn_->get_transaction_id(), context->txn_->get_prev_lsn(),
-                                 disk_manager_->get_file_name(fd_), page_handle.page->get_page_id().page_no,
-                                 (char *) page_handle.page);
+    auto page_handle = fetch_page_handle(rid.page_no);
+    char old_image[PAGE_SIZE];
+    memmove(old_image, page_handle.page->get_data(), PAGE_SIZE);
 
     auto data = page_handle.get_slot(rid.slot_no);
 
     memmove(data, buf, page_handle.file_hdr->record_size);
 
-    // 写入日志
-    if (context != nullptr) {
-        page_log->set_new_page((char *) page_handle.page);
-        auto lsn = context->log_mgr_->add_log_to_buffer(page_log);
-        page_handle.page->set_page_lsn(lsn);
-        context->txn_->set_prev_lsn(lsn);
-
-        delete page_log;
-    }
+    // 写入日志，不需要修改file_hdr
+    log_page_change(page_handle.page, old_image, context);
 
     buffer_pool_manager_->unpin_page({fd_, rid.page_no}, true);
 }
@@ -216,19 +329,165 @@ void RmFileHandle::update_record(const Rid &rid, char *buf, Context *context) {
 /**
  * @description: 获取指定页面的页面句柄
  * @param {int} page_no 页面号
+ * @param {BufferAccessStrategy*} strategy 缓冲池访问策略，为nullptr时使用整个缓冲池
  * @return {RmPageHandle} 指定页面的句柄
  */
-RmPageHandle RmFileHandle::fetch_page_handle(int page_no) const {
+RmPageHandle RmFileHandle::fetch_page_handle(int page_no, BufferAccessStrategy *strategy) const {
     // done
     // 使用缓冲池获取指定页面，并生成page_handle返回给上层
     // if page_no is invalid, throw PageNotExistError exception
-    auto page = buffer_pool_manager_->fetch_page(PageId{fd_, page_no});
+    auto page = buffer_pool_manager_->fetch_page(PageId{fd_, page_no}, strategy);
     if (page == nullptr) {
         throw PageNotExistError("", page_no);
     }
     return {&file_hdr_, page};
 }
 
+/**
+ * @description: 根据空闲空间映射判断页面中是否可能存放了记录
+ * @param {int} page_no 页面号
+ * @return {bool} 为false时页面中一定没有记录，扫描可以跳过该页面
+ */
+bool RmFileHandle::may_have_records(int page_no) const {
+    if (file_hdr_.first_fsm_page_no == RM_FSM_DISABLED) return true;
+    auto fsm_page_no = get_fsm_page_no(page_no / RM_FSM_ENTRIES_PER_PAGE);
+    if (fsm_page_no == RM_NO_PAGE) return false;
+
+    auto fsm_page = fetch_page_handle(fsm_page_no).page;
+    auto state = fsm_page->get_data()[RM_FSM_ENTRIES_OFFSET + page_no % RM_FSM_ENTRIES_PER_PAGE];
+    buffer_pool_manager_->unpin_page(fsm_page->get_page_id(), false);
+    return state != RM_FSM_EMPTY;
+}
+
+/**
+ * @description: 获取第fsm_idx个空闲空间映射页的页号，必要时沿映射页链表向后读取
+ * @return {page_id_t} 映射页的页号，不存在时返回RM_NO_PAGE
+ */
+page_id_t RmFileHandle::get_fsm_page_no(int fsm_idx) const {
+    std::lock_guard<std::mutex> lock{fsm_latch_};
+    if (fsm_pages_.empty()) {
+        if (file_hdr_.first_fsm_page_no == RM_NO_PAGE) return RM_NO_PAGE;
+        fsm_pages_.push_back(file_hdr_.first_fsm_page_no);
+    }
+    while ((int) fsm_pages_.size() <= fsm_idx) {
+        auto fsm_page = fetch_page_handle(fsm_pages_.back()).page;
+        auto next = reinterpret_cast<RmFsmPageHdr *>(fsm_page->get_data() + Page::OFFSET_PAGE_HDR)->next_fsm_page_no;
+        buffer_pool_manager_->unpin_page(fsm_page->get_page_id(), false);
+        if (next == RM_NO_PAGE) return RM_NO_PAGE;
+        fsm_pages_.push_back(next);
+    }
+    return fsm_pages_[fsm_idx];
+}
+
+/**
+ * @description: 在映射页链表末尾追加一个新的空闲空间映射页，调用者需已通过get_fsm_page_no读完整个链表。
+ *               文件头的修改（first_fsm_page_no和num_pages）由调用者记录日志
+ * @param {Context*} context
+ */
+void RmFileHandle::append_fsm_page(Context *context) {
+    auto page_id = PageId{fd_, INVALID_PAGE_ID};
+    auto page = buffer_pool_manager_->new_page(&page_id);
+    if (page == nullptr) {
+        throw InternalError("[RmFileHandle] buffer pool cannot allocate new page");
+    }
+    file_hdr_.num_pages++;
+    char old_image[PAGE_SIZE];
+    memmove(old_image, page->get_data(), PAGE_SIZE);
+    reinterpret_cast<RmFsmPageHdr *>(page->get_data() + Page::OFFSET_PAGE_HDR)->next_fsm_page_no = RM_NO_PAGE;
+    log_page_change(page, old_image, context);
+    buffer_pool_manager_->unpin_page(page_id, true);
+
+    std::lock_guard<std::mutex> lock{fsm_latch_};
+    if (fsm_pages_.empty()) {
+        file_hdr_.first_fsm_page_no = page_id.page_no;
+    } else {
+        auto prev = fetch_page_handle(fsm_pages_.back()).page;
+        memmove(old_image, prev->get_data(), PAGE_SIZE);
+        reinterpret_cast<RmFsmPageHdr *>(prev->get_data() + Page::OFFSET_PAGE_HDR)->next_fsm_page_no = page_id.page_no;
+        log_page_change(prev, old_image, context);
+        buffer_pool_manager_->unpin_page(prev->get_page_id(), true);
+    }
+    fsm_pages_.push_back(page_id.page_no);
+}
+
+/**
+ * @description: 页面中的记录数改变后，更新其在空闲空间映射中的状态，状态改变时为映射页写入日志
+ * @param {RmPageHandle&} page_handle 记录数改变的页面
+ * @param {Context*} context
+ */
+void RmFileHandle::update_fsm(const RmPageHandle &page_handle, Context *context) {
+    if (file_hdr_.first_fsm_page_no == RM_FSM_DISABLED) return;
+    int page_no = page_handle.page->get_page_id().page_no;
+    int num_records = page_handle.page_hdr->num_records;
+    // 槽页格式的页面放不下一条最长的记录时即为满
+    bool full = is_slotted() ? !has_room(page_handle, max_stored_size(), page_handle.slotted_hdr()->num_slots)
+                             : num_records >= file_hdr_.num_records_per_page;
+    char state = num_records == 0 ? RM_FSM_EMPTY : full ? RM_FSM_FULL : RM_FSM_PARTIAL;
+
+    int fsm_idx = page_no / RM_FSM_ENTRIES_PER_PAGE;
+    auto fsm_page_no = get_fsm_page_no(fsm_idx);
+    if (fsm_page_no == RM_NO_PAGE) {
+        // 不存在的映射页所覆盖的页面都为空，第一次有页面非空时才分配映射页
+        if (state == RM_FSM_EMPTY) return;
+        while ((fsm_page_no = get_fsm_page_no(fsm_idx)) == RM_NO_PAGE) append_fsm_page(context);
+    }
+
+    auto fsm_page = fetch_page_handle(fsm_page_no).page;
+    char *entry = fsm_page->get_data() + RM_FSM_ENTRIES_OFFSET + page_no % RM_FSM_ENTRIES_PER_PAGE;
+    if (*entry == state) {
+        buffer_pool_manager_->unpin_page(fsm_page->get_page_id(), false);
+        return;
+    }
+    char old_image[PAGE_SIZE];
+    memmove(old_image, fsm_page->get_data(), PAGE_SIZE);
+    *entry = state;
+    log_page_change(fsm_page, old_image, context);
+    buffer_pool_manager_->unpin_page(fsm_page->get_page_id(), true);
+}
+
+/**
+ * @description: 为页面的修改写入页面日志，context为nullptr时（如恢复时的回滚）或页面没有变化时不写日志。
+ *               页面自上次写回磁盘后第一次被修改时写入完整的页面镜像，防止写回时页面写了一半导致页面损坏；
+ *               新分配的页面还没有写过日志，页头的初始化不在old_image中，也需要写入完整的页面镜像；
+ *               之后的修改只写入被修改的字节区间
+ * @param {Page*} page 修改后的页面
+ * @param {char*} old_image 修改前页面的内容
+ * @param {Context*} context
+ */
+void RmFileHandle::log_page_change(Page *page, char *old_image, Context *context) {
+    if (context == nullptr) return;
+    PageDeltaLogRecord delta_log(context->txn_->get_transaction_id(), context->txn_->get_prev_lsn(), oid_,
+                                 page->get_page_id().page_no, old_image, page->get_data(), PAGE_SIZE);
+    if (delta_log.ranges.empty()) return;
+    lsn_t lsn;
+    if (!page->is_dirty() || page->get_page_lsn() == INVALID_LSN) {
+        PageLogRecord page_log(context->txn_->get_transaction_id(), context->txn_->get_prev_lsn(), oid_,
+                               page->get_page_id().page_no, old_image);
+        page_log.set_new_page(page->get_data());
+        lsn = context->log_mgr_->add_log_to_buffer(&page_log);
+    } else {
+        lsn = context->log_mgr_->add_log_to_buffer(&delta_log);
+    }
+    page->set_page_lsn(lsn);
+    context->txn_->set_prev_lsn(lsn);
+}
+
+/**
+ * @description: 文件头被修改时为其写入日志，context为nullptr或文件头没有变化时不写日志
+ * @param {RmFileHdr&} old_hdr 修改前的文件头
+ * @param {Context*} context
+ */
+void RmFileHandle::log_file_hdr_change(const RmFileHdr &old_hdr, Context *context) {
+    if (context == nullptr || memcmp(&old_hdr, &file_hdr_, sizeof(RmFileHdr)) == 0) return;
+    // 文件头只在关闭文件时整体写回，只需要记录被修改的字段
+    PageDeltaLogRecord hdr_log(context->txn_->get_transaction_id(), context->txn_->get_prev_lsn(), oid_,
+                               RM_FILE_HDR_PAGE, reinterpret_cast<const char *>(&old_hdr),
+                               reinterpret_cast<const char *>(&file_hdr_), sizeof(RmFileHdr));
+    auto lsn = context->log_mgr_->add_log_to_buffer(&hdr_log);
+    context->txn_->set_prev_lsn(lsn);
+    file_hdr_.lsn = lsn;
+}
+
 /**
  * @description: 创建一个新的page handle
  * @return {RmPageHandle} 新的PageHandle
@@ -246,7 +505,15 @@ RmPageHandle RmFileHandle::create_new_page_handle() {
     auto page_handle = RmPageHandle(&file_hdr_, page);
     page_handle.page_hdr->num_records = 0;
     page_handle.page_hdr->next_free_page_no = RM_NO_PAGE;
-    Bitmap::init(page_handle.bitmap, file_hdr_.bitmap_size);
+    if (is_slotted()) {
+        auto slotted_hdr = page_handle.slotted_hdr();
+        slotted_hdr->num_slots = 0;
+        slotted_hdr->data_begin = PAGE_SIZE;
+        slotted_hdr->free_bytes = PAGE_SIZE - RM_SLOT_DIR_OFFSET;
+        slotted_hdr->in_free_list = 1;
+    } else {
+        Bitmap::init(page_handle.bitmap, file_hdr_.bitmap_size);
+    }
 
     file_hdr_.first_free_page_no = page->get_page_id().page_no;
     file_hdr_.num_pages++;
@@ -282,3 +549,275 @@ void RmFileHandle::release_page_handle(RmPageHandle &page_handle) {
     page_handle.page_hdr->next_free_page_no = file_hdr_.first_free_page_no;
     file_hdr_.first_free_page_no = page_handle.page->get_page_id().page_no;
 }
+
+/**
+ * 以下为槽页格式的辅助函数。槽页中的记录以编码后的形式存放：变长字段存为2字节的长度加上去掉末尾'\0'的内容，
+ * 其余字节原样保存。更新后的记录在原页面放不下时迁移到其他页面，原来的槽改为指向新位置的迁移标记，记录号保持不变
+ */
+/**
+ * @description: 槽页中一条记录最多占用的字节数，即编码后最长的记录加上迁移记录前存放的原Rid
+ */
+int RmFileHandle::max_stored_size() const {
+    return file_hdr_.record_size + file_hdr_.num_var_fields * (int) sizeof(uint16_t) + (int) sizeof(Rid);
+}
+
+/**
+ * @description: 将内存中定长格式的记录编码为存储格式
+ * @return {int} 编码后的长度
+ * @param {char*} buf 定长格式的记录
+ * @param {char*} out 编码结果，至少需要record_size + num_var_fields * 2字节
+ */
+int RmFileHandle::encode_record(const char *buf, char *out) const {
+    int pos = 0;
+    int len = 0;
+    for (int i = 0; i < file_hdr_.num_var_fields; i++) {
+        auto &field = file_hdr_.var_fields[i];
+        memcpy(out + len, buf + pos, field.offset - pos);
+        len += field.offset - pos;
+        uint16_t field_len = field.len;
+        while (field_len > 0 && buf[field.offset + field_len - 1] == '\0') field_len--;
+        memcpy(out + len, &field_len, sizeof(uint16_t));
+        memcpy(out + len + sizeof(uint16_t), buf + field.offset, field_len);
+        len += sizeof(uint16_t) + field_len;
+        pos = field.offset + field.len;
+    }
+    memcpy(out + len, buf + pos, file_hdr_.record_size - pos);
+    return len + file_hdr_.record_size - pos;
+}
+
+/**
+ * @description: 将存储格式的记录解码为内存中定长格式的记录，变长字段末尾补'\0'
+ * @param {char*} data 存储格式的记录
+ * @param {char*} out 解码结果，大小为record_size
+ */
+void RmFileHandle::decode_record(const char *data, char *out) const {
+    int pos = 0;
+    for (int i = 0; i < file_hdr_.num_var_fields; i++) {
+        auto &field = file_hdr_.var_fields[i];
+        memcpy(out + pos, data, field.offset - pos);
+        data += field.offset - pos;
+        uint16_t field_len;
+        memcpy(&field_len, data, sizeof(uint16_t));
+        memcpy(out + field.offset, data + sizeof(uint16_t), field_len);
+        memset(out + field.offset + field_len, 0, field.len - field_len);
+        data += sizeof(uint16_t) + field_len;
+        pos = field.offset + field.len;
+    }
+    memcpy(out + pos, data, file_hdr_.record_size - pos);
+}
+
+/**
+ * @description: 读取槽页中的一条记录并解码，槽中是迁移标记时读取迁移后的记录
+ * @return {bool} 槽中没有以该位置为记录号的记录时返回false
+ * @param {RmPageHandle&} page_handle 记录所在的页面
+ * @param {int} slot_no 槽号
+ * @param {char*} out 解码后的记录，大小为record_size
+ * @param {BufferAccessStrategy*} strategy 读取迁移后的记录时使用的缓冲池访问策略
+ */
+bool RmFileHandle::read_slotted_record(const RmPageHandle &page_handle, int slot_no, char *out,
+                                       BufferAccessStrategy *strategy) const {
+    if (slot_no >= page_handle.slotted_hdr()->num_slots) return false;
+    auto slot = page_handle.slot_dir()[slot_no];
+    if (slot.offset == 0 || (slot.len & RM_SLOT_MOVED)) return false;
+    if (!(slot.len & RM_SLOT_FORWARD)) {
+        decode_record(page_handle.page->get_data() + slot.offset, out);
+        return true;
+    }
+    Rid target;
+    memcpy(&target, page_handle.page->get_data() + slot.offset, sizeof(Rid));
+    auto target_handle = fetch_page_handle(target.page_no, strategy);
+    auto target_slot = target_handle.slot_dir()[target.slot_no];
+    decode_record(target_handle.page->get_data() + target_slot.offset + sizeof(Rid), out);
+    buffer_pool_manager_->unpin_page(target_handle.page->get_page_id(), false);
+    return true;
+}
+
+/**
+ * @description: 判断页面中是否有足够的空间在slot_no处存放一条长为len的记录，slot_no处的槽需为空
+ */
+bool RmFileHandle::has_room(const RmPageHandle &page_handle, int len, int slot_no) const {
+    auto slotted_hdr = page_handle.slotted_hdr();
+    int new_slots = std::max(slot_no + 1 - slotted_hdr->num_slots, 0);
+    return slotted_hdr->free_bytes >= std::max(len, RM_MIN_SLOT_BYTES) + new_slots * (int) sizeof(RmSlot);
+}
+
+/**
+ * @description: 整理页面，将所有记录紧密排列到页尾，消除被删除的记录留下的空洞
+ */
+void RmFileHandle::compact_page(const RmPageHandle &page_handle) {
+    auto slotted_hdr = page_handle.slotted_hdr();
+    auto slots = page_handle.slot_dir();
+    char *data = page_handle.page->get_data();
+    std::vector<int> used;
+    for (int i = 0; i < slotted_hdr->num_slots; i++) {
+        if (slots[i].offset != 0) used.push_back(i);
+    }
+    // 按偏移从大到小移动，每条记录只会向页尾移动，不会覆盖尚未移动的记录
+    std::sort(used.begin(), used.end(), [slots](int a, int b) { return slots[a].offset > slots[b].offset; });
+    int end = PAGE_SIZE;
+    for (int slot_no : used) {
+        int len = slots[slot_no].len & RM_SLOT_LEN_MASK;
+        end -= std::max(len, RM_MIN_SLOT_BYTES);
+        memmove(data + end, data + slots[slot_no].offset, len);
+        slots[slot_no].offset = end;
+    }
+    slotted_hdr->data_begin = end;
+    slotted_hdr->free_bytes = end - RM_SLOT_DIR_OFFSET - slotted_hdr->num_slots * (int) sizeof(RmSlot);
+}
+
+/**
+ * @description: 将长为len的数据存放到页面的slot_no处，调用者需先通过has_room确认空间足够，必要时整理页面
+ * @param {uint16_t} flags 槽的标志位
+ */
+void RmFileHandle::place_slotted(const RmPageHandle &page_handle, int slot_no, const char *data, int len,
+                                 uint16_t flags) {
+    auto slotted_hdr = page_handle.slotted_hdr();
+    auto slots = page_handle.slot_dir();
+    int alloc = std::max(len, RM_MIN_SLOT_BYTES);
+    int new_slots = std::max(slot_no + 1, slotted_hdr->num_slots);
+    if (slotted_hdr->data_begin - RM_SLOT_DIR_OFFSET - new_slots * (int) sizeof(RmSlot) < alloc) {
+        compact_page(page_handle);
+    }
+    for (int i = slotted_hdr->num_slots; i < new_slots; i++) slots[i] = RmSlot{0, 0};
+    slotted_hdr->free_bytes -= (new_slots - slotted_hdr->num_slots) * (int) sizeof(RmSlot) + alloc;
+    slotted_hdr->num_slots = new_slots;
+    slotted_hdr->data_begin -= alloc;
+    memcpy(page_handle.page->get_data() + slotted_hdr->data_begin, data, len);
+    slots[slot_no] = RmSlot{static_cast<uint16_t>(slotted_hdr->data_begin), static_cast<uint16_t>(len | flags)};
+    page_handle.page_hdr->num_records++;
+}
+
+/**
+ * @description: 释放页面中slot_no处的记录，槽目录末尾的空槽一并回收
+ */
+void RmFileHandle::free_slotted(const RmPageHandle &page_handle, int slot_no) {
+    auto slotted_hdr = page_handle.slotted_hdr();
+    auto slots = page_handle.slot_dir();
+    if (slot_no >= slotted_hdr->num_slots || slots[slot_no].offset == 0) return;
+    int alloc = std::max(slots[slot_no].len & RM_SLOT_LEN_MASK, RM_MIN_SLOT_BYTES);
+    if (slots[slot_no].offset == slotted_hdr->data_begin) slotted_hdr->data_begin += alloc;
+    slotted_hdr->free_bytes += alloc;
+    slots[slot_no] = RmSlot{0, 0};
+    page_handle.page_hdr->num_records--;
+    while (slotted_hdr->num_slots > 0 && slots[slotted_hdr->num_slots - 1].offset == 0) {
+        slotted_hdr->num_slots--;
+        slotted_hdr->free_bytes += sizeof(RmSlot);
+    }
+    if (page_handle.page_hdr->num_records == 0) slotted_hdr->data_begin = PAGE_SIZE;
+}
+
+/**
+ * @description: 槽页中释放了空间后，若页面重新放得下一条最长的记录且不在空闲页面链表中，将其加入链表头部
+ */
+void RmFileHandle::release_slotted_page(RmPageHandle &page_handle) {
+    auto slotted_hdr = page_handle.slotted_hdr();
+    if (slotted_hdr->in_free_list || !has_room(page_handle, max_stored_size(), slotted_hdr->num_slots)) return;
+    release_page_handle(page_handle);
+    slotted_hdr->in_free_list = 1;
+}
+
+/**
+ * @description: 在空闲页面链表的第一个放得下的页面中插入一条编码后的记录，沿途将放不下的页面移出链表。
+ *               修改的页面写入日志，文件头的修改由调用者记录日志
+ * @return {Rid} 插入的位置
+ * @param {char*} data 编码后的记录，迁移记录前带有原Rid
+ * @param {int} len 记录的长度
+ * @param {uint16_t} flags 槽的标志位，插入迁移记录时不对新位置加锁
+ * @param {Context*} context
+ */
+Rid RmFileHandle::insert_slotted(const char *data, int len, uint16_t flags, Context *context) {
+    char old_image[PAGE_SIZE];
+    while (true) {
+        auto page_handle = create_page_handle();
+        auto slotted_hdr = page_handle.slotted_hdr();
+        memmove(old_image, page_handle.page->get_data(), PAGE_SIZE);
+
+        // 优先使用槽目录中的空槽
+        int slot_no = 0;
+        while (slot_no < slotted_hdr->num_slots && page_handle.slot_dir()[slot_no].offset != 0) slot_no++;
+        if (has_room(page_handle, len, slot_no)) {
+            auto rid = Rid{page_handle.page->get_page_id().page_no, slot_no};
+            if (!(flags & RM_SLOT_MOVED) && context != nullptr &&
+                !context->lock_mgr_->lock_exclusive_on_record(context->txn_, rid, fd_)) {
+                buffer_pool_manager_->unpin_page(page_handle.page->get_page_id(), true);
+                throw TransactionAbortException(context->txn_->get_transaction_id(),
+                                                AbortReason::DEADLOCK_PREVENTION);
+            }
+            place_slotted(page_handle, slot_no, data, len, flags);
+            // 放不下最长的记录时移出空闲页面链表
+            if (!has_room(page_handle, max_stored_size(), slotted_hdr->num_slots)) {
+                file_hdr_.first_free_page_no = page_handle.page_hdr->next_free_page_no;
+                slotted_hdr->in_free_list = 0;
+            }
+            log_page_change(page_handle.page, old_image, context);
+            update_fsm(page_handle, context);
+            buffer_pool_manager_->unpin_page(page_handle.page->get_page_id(), true);
+            return rid;
+        }
+
+        file_hdr_.first_free_page_no = page_handle.page_hdr->next_free_page_no;
+        slotted_hdr->in_free_list = 0;
+        log_page_change(page_handle.page, old_image, context);
+        buffer_pool_manager_->unpin_page(page_handle.page->get_page_id(), true);
+    }
+}
+
+/**
+ * @description: 将记录写入槽页中的rid处，替换该位置原有的记录；原页面放不下时记录迁移到其他页面，
+ *               原位置存放迁移标记。用于更新和回滚时的插入
+ * @param {Rid&} rid 记录号
+ * @param {char*} buf 内存中定长格式的记录
+ * @param {Context*} context
+ */
+void RmFileHandle::store_slotted(const Rid &rid, const char *buf, Context *context) {
+    auto page_handle = fetch_page_handle(rid.page_no);
+    char old_image[PAGE_SIZE];
+    memmove(old_image, page_handle.page->get_data(), PAGE_SIZE);
+    RmFileHdr old_hdr = file_hdr_;
+
+    // 先删除原有的记录及其迁移后的副本
+    if (rid.slot_no < page_handle.slotted_hdr()->num_slots) {
+        auto slot = page_handle.slot_dir()[rid.slot_no];
+        if (slot.offset != 0 && (slot.len & RM_SLOT_FORWARD)) {
+            Rid target;
+            memcpy(&target, page_handle.page->get_data() + slot.offset, sizeof(Rid));
+            delete_moved(target, context);
+        }
+        free_slotted(page_handle, rid.slot_no);
+    }
+
+    // 迁移记录的数据前存放原Rid
+    char stored[sizeof(Rid) + RM_MAX_RECORD_SIZE + RM_MAX_VAR_FIELDS * sizeof(uint16_t)];
+    memcpy(stored, &rid, sizeof(Rid));
+    int len = encode_record(buf, stored + sizeof(Rid));
+    if (has_room(page_handle, len, rid.slot_no)) {
+        place_slotted(page_handle, rid.slot_no, stored + sizeof(Rid), len, 0);
+    } else {
+        auto target = insert_slotted(stored, len + (int) sizeof(Rid), RM_SLOT_MOVED, context);
+        if (!has_room(page_handle, sizeof(Rid), rid.slot_no)) {
+            throw InternalError("RmFileHandle::store_slotted: no room for forwarding slot");
+        }
+        place_slotted(page_handle, rid.slot_no, reinterpret_cast<char *>(&target), sizeof(Rid), RM_SLOT_FORWARD);
+    }
+    release_slotted_page(page_handle);
+
+    log_page_change(page_handle.page, old_image, context);
+    update_fsm(page_handle, context);
+    log_file_hdr_change(old_hdr, context);
+    buffer_pool_manager_->unpin_page({fd_, rid.page_no}, true);
+}
+
+/**
+ * @description: 删除迁移到其他页面的记录副本，页面修改写入日志，文件头的修改由调用者记录日志
+ * @param {Rid&} rid 迁移后记录的位置
+ */
+void RmFileHandle::delete_moved(const Rid &rid, Context *context, BufferAccessStrategy *strategy) {
+    auto page_handle = fetch_page_handle(rid.page_no, strategy);
+    char old_image[PAGE_SIZE];
+    memmove(old_image, page_handle.page->get_data(), PAGE_SIZE);
+    free_slotted(page_handle, rid.slot_no);
+    release_slotted_page(page_handle);
+    log_page_change(page_handle.page, old_image, context);
+    update_fsm(page_handle, context);
+    buffer_pool_manager_->unpin_page(page_handle.page->get_page_id(), true);
+}
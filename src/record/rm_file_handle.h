@@ -12,7 +12,11 @@ See the Mulan PSL v2 for more details. */
 
 #include <assert.h>
 
+#include <algorithm>
+#include <cstring>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 #include "bitmap.h"
 #include "common/context.h"
@@ -38,11 +42,84 @@ struct RmPageHandle {
     char *get_slot(int slot_no) const {
         return slots + 1ll * slot_no * file_hdr->record_size;  // slots的首地址 + slot个数 * 每个slot的大小(每个record的大小)
     }
+
+    // 槽页格式的页头，紧跟在page_hdr之后
+    RmSlottedPageHdr *slotted_hdr() const {
+        return reinterpret_cast<RmSlottedPageHdr *>(page->get_data() + Page::OFFSET_PAGE_HDR + sizeof(RmPageHdr));
+    }
+
+    // 槽页格式的槽目录
+    RmSlot *slot_dir() const { return reinterpret_cast<RmSlot *>(page->get_data() + RM_SLOT_DIR_OFFSET); }
+};
+
+/*
+RecordView是对缓冲池中一条记录的只读视图：直接指向被固定的页面中的slot，不拷贝记录数据。
+视图存在期间页面保持pin，析构或release()时unpin；视图只能移动，不能拷贝。
+记录需要在页面unpin之后继续使用时（如排序缓冲、返回给上层的结果）调用to_record()拷贝出来。
+槽页格式中的记录需要解码，视图持有解码后的数据，不固定页面。
+*/
+class RecordView {
+   public:
+    RecordView() = default;
+
+    RecordView(BufferPoolManager *buffer_pool_manager, PageId page_id, const char *data, int size)
+        : buffer_pool_manager_(buffer_pool_manager), page_id_(page_id), data_(data), size_(size) {}
+
+    RecordView(std::unique_ptr<char[]> decoded, int size)
+        : data_(decoded.get()), size_(size), decoded_(std::move(decoded)) {}
+
+    RecordView(RecordView &&other) noexcept { *this = std::move(other); }
+
+    RecordView &operator=(RecordView &&other) noexcept {
+        if (this != &other) {
+            release();
+            buffer_pool_manager_ = other.buffer_pool_manager_;
+            page_id_ = other.page_id_;
+            data_ = other.data_;
+            size_ = other.size_;
+            decoded_ = std::move(other.decoded_);
+            other.buffer_pool_manager_ = nullptr;
+            other.data_ = nullptr;
+        }
+        return *this;
+    }
+
+    RecordView(const RecordView &) = delete;
+    RecordView &operator=(const RecordView &) = delete;
+
+    ~RecordView() { release(); }
+
+    const char *data() const { return data_; }
+
+    int size() const { return size_; }
+
+    bool valid() const { return data_ != nullptr; }
+
+    /* 将记录拷贝到一个新的RmRecord中，拷贝不依赖页面的pin */
+    std::unique_ptr<RmRecord> to_record() const { return std::make_unique<RmRecord>(size_, const_cast<char *>(data_)); }
+
+    /* 提前unpin页面，之后视图失效 */
+    void release() {
+        if (buffer_pool_manager_ != nullptr) {
+            buffer_pool_manager_->unpin_page(page_id_, false);
+            buffer_pool_manager_ = nullptr;
+        }
+        data_ = nullptr;
+        decoded_.reset();
+    }
+
+   private:
+    BufferPoolManager *buffer_pool_manager_ = nullptr;
+    PageId page_id_;
+    const char *data_ = nullptr;
+    int size_ = 0;
+    std::unique_ptr<char[]> decoded_;   // 槽页格式中解码出的记录
 };
 
 /* 每个RmFileHandle对应一个表的数据文件，里面有多个page，每个page的数据封装在RmPageHandle中 */
 class RmFileHandle {
     friend class RmScan;
+    friend class RmPageScan;
 
     friend class RmManager;
 
@@ -52,7 +129,10 @@ private:
     DiskManager *disk_manager_;
     BufferPoolManager *buffer_pool_manager_;
     int fd_;        // 打开文件后产生的文件句柄
+    oid_t oid_ = INVALID_OID;   // 表在目录中的对象ID，写日志时用它标识表
     RmFileHdr file_hdr_;    // 文件头，维护当前表文件的元数据
+    mutable std::mutex fsm_latch_;                  // 保护fsm_pages_
+    mutable std::vector<page_id_t> fsm_pages_;      // 已读取到的空闲空间映射页链表的前缀，映射页只会追加，不会被释放
 
 public:
     RmFileHandle(DiskManager *disk_manager, BufferPoolManager *buffer_pool_manager, int fd)
@@ -60,34 +140,68 @@ public:
         // 注意：这里从磁盘中读出文件描述符为fd的文件的file_hdr，读到内存中
         // 这里实际就是初始化file_hdr，只不过是从磁盘中读出进行初始化
         // init file_hdr_
-        disk_manager_->read_page(fd, RM_FILE_HDR_PAGE, (char *) &file_hdr_, sizeof(file_hdr_));
+        // 旧版本创建且从未插入过记录的文件只有当时较短的文件头，只读取文件中实际存在的字节，新增的字段为0：
+        // first_fsm_page_no为0表示不维护空闲空间映射，format为0表示定长格式
+        memset(&file_hdr_, 0, sizeof(file_hdr_));
+        int hdr_size = std::min<int>(sizeof(file_hdr_), disk_manager_->get_file_size(disk_manager_->get_file_name(fd)));
+        disk_manager_->read_page(fd, RM_FILE_HDR_PAGE, (char *) &file_hdr_, hdr_size);
         // disk_manager管理的fd对应的文件中，设置从file_hdr_.num_pages开始分配page_no
         disk_manager_->set_fd2pageno(fd, file_hdr_.num_pages);
     }
 
-    RmFileHdr get_file_hdr() { return file_hdr_; }
+    const RmFileHdr &get_file_hdr() const { return file_hdr_; }
+
+    bool is_slotted() const { return file_hdr_.format == RM_FORMAT_SLOTTED; }
 
     int GetFd() { return fd_; }
 
+    oid_t get_oid() const { return oid_; }
+
+    void set_oid(oid_t oid) { oid_ = oid; }
+
     /* 判断指定位置上是否已经存在一条记录，通过Bitmap来判断 */
     bool is_record(const Rid &rid) const {
+        // 空闲空间映射中为空的页面（包括映射页本身）没有记录
+        if (!may_have_records(rid.page_no)) return false;
         RmPageHandle page_handle = fetch_page_handle(rid.page_no);
-        return Bitmap::is_set(page_handle.bitmap, rid.slot_no);  // page的slot_no位置上是否有record
+        bool ret;
+        if (is_slotted()) {
+            // 迁移来的记录不以当前位置作为记录号
+            auto slot = page_handle.slot_dir() + rid.slot_no;
+            ret = rid.slot_no < page_handle.slotted_hdr()->num_slots && slot->offset != 0 &&
+                  !(slot->len & RM_SLOT_MOVED);
+        } else {
+            ret = Bitmap::is_set(page_handle.bitmap, rid.slot_no);  // page的slot_no位置上是否有record
+        }
+        buffer_pool_manager_->unpin_page(page_handle.page->get_page_id(), false);
+        return ret;
+    }
+
+    /* 为访问整个文件的批量操作创建缓冲池访问策略，文件相对缓冲池较小时返回nullptr */
+    std::unique_ptr<BufferAccessStrategy> make_access_strategy(size_t ring_size) const {
+        return buffer_pool_manager_->make_access_strategy(file_hdr_.num_pages, ring_size);
     }
 
-    std::unique_ptr<RmRecord> get_record(const Rid &rid, Context *context) const;
+    std::unique_ptr<RmRecord> get_record(const Rid &rid, Context *context,
+                                         BufferAccessStrategy *strategy = nullptr) const;
+
+    RecordView get_record_view(const Rid &rid, Context *context, BufferAccessStrategy *strategy = nullptr) const;
 
     Rid insert_record(char *buf, Context *context);
 
+    std::vector<Rid> insert_records(const std::vector<char *> &bufs, Context *context);
+
     void insert_record(const Rid &rid, char *buf);
 
-    void delete_record(const Rid &rid, Context *context);
+    void delete_record(const Rid &rid, Context *context, BufferAccessStrategy *strategy = nullptr);
 
     void update_record(const Rid &rid, char *buf, Context *context);
 
     RmPageHandle create_new_page_handle();
 
-    RmPageHandle fetch_page_handle(int page_no) const;
+    RmPageHandle fetch_page_handle(int page_no, BufferAccessStrategy *strategy = nullptr) const;
+
+    bool may_have_records(int page_no) const;
 
     void flush_all_record() {
         disk_manager_->write_page(fd_, RM_FILE_HDR_PAGE, (char *) &file_hdr_,
@@ -99,4 +213,46 @@ private:
     RmPageHandle create_page_handle();
 
     void release_page_handle(RmPageHandle &page_handle);
+
+    void fill_page(RmPageHandle &page_handle, const std::vector<char *> &bufs, std::vector<Rid> &rids,
+                   Context *context);
+
+    void fill_slotted_page(RmPageHandle &page_handle, const std::vector<char *> &bufs, std::vector<Rid> &rids,
+                           Context *context);
+
+    page_id_t get_fsm_page_no(int fsm_idx) const;
+
+    void append_fsm_page(Context *context);
+
+    void update_fsm(const RmPageHandle &page_handle, Context *context);
+
+    void log_page_change(Page *page, char *old_image, Context *context);
+
+    void log_file_hdr_change(const RmFileHdr &old_hdr, Context *context);
+
+    // 以下为槽页格式的辅助函数
+    int max_stored_size() const;
+
+    int encode_record(const char *buf, char *out) const;
+
+    void decode_record(const char *data, char *out) const;
+
+    bool read_slotted_record(const RmPageHandle &page_handle, int slot_no, char *out,
+                             BufferAccessStrategy *strategy = nullptr) const;
+
+    bool has_room(const RmPageHandle &page_handle, int len, int slot_no) const;
+
+    void compact_page(const RmPageHandle &page_handle);
+
+    void place_slotted(const RmPageHandle &page_handle, int slot_no, const char *data, int len, uint16_t flags);
+
+    void free_slotted(const RmPageHandle &page_handle, int slot_no);
+
+    void release_slotted_page(RmPageHandle &page_handle);
+
+    Rid insert_slotted(const char *data, int len, uint16_t flags, Context *context);
+
+    void store_slotted(const Rid &rid, const char *buf, Context *context);
+
+    void delete_moved(const Rid &rid, Context *context, BufferAccessStrategy *strategy = nullptr);
 };
\ No newline at end of file
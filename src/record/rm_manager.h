@@ -12,6 +12,8 @@ See the Mulan PSL v2 for more details. */
 
 #include <assert.h>
 
+#include <algorithm>
+
 #include "bitmap.h"
 #include "rm_defs.h"
 #include "rm_file_handle.h"
@@ -30,11 +32,15 @@ public:
      * @description: 创建表的数据文件并初始化相关信息
      * @param {string&} filename 要创建的文件名称
      * @param {int} record_size 表中记录的大小
+     * @param {vector<RmVarField>&} var_fields 变长字段，不为空时文件使用槽页格式
      */
-    void create_file(const std::string &filename, int record_size) {
+    void create_file(const std::string &filename, int record_size, const std::vector<RmVarField> &var_fields = {}) {
         if (record_size < 1 || record_size > RM_MAX_RECORD_SIZE) {
             throw InvalidRecordSizeError(record_size);
         }
+        if (var_fields.size() > RM_MAX_VAR_FIELDS) {
+            throw InternalError("RmManager::create_file: too many variable-length fields");
+        }
         disk_manager_->create_file(filename);
         int fd = disk_manager_->open_file(filename);
 
@@ -43,10 +49,24 @@ public:
         file_hdr.record_size = record_size;
         file_hdr.num_pages = 1;
         file_hdr.first_free_page_no = RM_NO_PAGE;
-        // We have: sizeof(hdr) + (n + 7) / 8 + n * record_size <= PAGE_SIZE
-        file_hdr.num_records_per_page =
-                (BITMAP_WIDTH * (PAGE_SIZE - 1 - (int) sizeof(RmFileHdr)) + 1) / (1 + record_size * BITMAP_WIDTH);
-        file_hdr.bitmap_size = (file_hdr.num_records_per_page + BITMAP_WIDTH - 1) / BITMAP_WIDTH;
+        file_hdr.first_fsm_page_no = RM_NO_PAGE;
+        if (var_fields.empty()) {
+            file_hdr.format = RM_FORMAT_FIXED;
+            // We have: sizeof(page hdr) + (n + 7) / 8 + n * record_size <= PAGE_SIZE
+            int page_hdr_size = Page::OFFSET_PAGE_HDR + sizeof(RmPageHdr);
+            file_hdr.num_records_per_page =
+                    (BITMAP_WIDTH * (PAGE_SIZE - 1 - page_hdr_size) + 1) / (1 + record_size * BITMAP_WIDTH);
+            file_hdr.bitmap_size = (file_hdr.num_records_per_page + BITMAP_WIDTH - 1) / BITMAP_WIDTH;
+        } else {
+            // 槽页格式不使用位图，num_records_per_page为一个页面最多能容纳的槽数
+            file_hdr.format = RM_FORMAT_SLOTTED;
+            file_hdr.num_var_fields = static_cast<int>(var_fields.size());
+            std::copy(var_fields.begin(), var_fields.end(), file_hdr.var_fields);
+            std::sort(file_hdr.var_fields, file_hdr.var_fields + file_hdr.num_var_fields,
+                      [](const RmVarField &a, const RmVarField &b) { return a.offset < b.offset; });
+            file_hdr.num_records_per_page = (PAGE_SIZE - RM_SLOT_DIR_OFFSET) / (sizeof(RmSlot) + RM_MIN_SLOT_BYTES);
+            file_hdr.bitmap_size = 0;
+        }
 
         // 将file header写入磁盘文件（名为file name，文件描述符为fd）中的第0页
         // head page直接写入磁盘，没有经过缓冲区的NewPage，那么也就不需要FlushPage
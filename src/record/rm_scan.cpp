@@ -14,46 +14,95 @@ See the Mulan PSL v2 for more details. */
 /**
  * @brief 初始化file_handle和rid
  * @param file_handle
+ * @param strategy 缓冲池访问策略，由调用者持有，扫描期间需保持有效
  */
-RmScan::RmScan(const RmFileHandle *file_handle) : file_handle_(file_handle) {
-    // Todo:
-    // 初始化file_handle和rid（指向第一个存放了记录的位置）
-    rid_ = Rid{RM_FIRST_RECORD_PAGE, -1};
-    next();
-}
+RmPageScan::RmPageScan(const RmFileHandle *file_handle, BufferAccessStrategy *strategy)
+    : file_handle_(file_handle), strategy_(strategy), page_no_(RM_FIRST_RECORD_PAGE) {}
 
 /**
- * @brief 找到文件中下一个存放了记录的位置
+ * @description: 读取下一个存放了记录的页面：固定页面一次，按位图拷贝出其中全部记录后解除固定；
+ *               slot编号连续的记录在页面中也连续存放，每段连续的记录只需一次拷贝。
+ *               槽页格式中逐条解码，迁移标记处读取迁移后的记录，迁移来的记录在其原位置返回
+ * @return {bool} 找到了有记录的页面返回true，扫描结束返回false
+ * @param {RmPageBatch*} batch 保存页面中的记录，原有内容被覆盖
  */
-void RmScan::next() {
-    // Todo:
-    // 找到文件中下一个存放了记录的非空闲位置，用rid_来指向这个位置
-    while (rid_.page_no < file_handle_->file_hdr_.num_pages) {
-        auto page_handle = file_handle_->fetch_page_handle(rid_.page_no);
-        rid_.slot_no = Bitmap::next_bit(true, page_handle.bitmap, file_handle_->file_hdr_.num_records_per_page, rid_.slot_no);
-        file_handle_->buffer_pool_manager_->unpin_page(PageId{file_handle_->fd_, rid_.page_no}, false);
-        if (rid_.slot_no < file_handle_->file_hdr_.num_records_per_page) {
-            return;
+bool RmPageScan::next_page(RmPageBatch *batch) {
+    int num_slots = file_handle_->file_hdr_.num_records_per_page;
+    int record_size = file_handle_->file_hdr_.record_size;
+    for (; page_no_ < file_handle_->file_hdr_.num_pages; page_no_++) {
+        // 空闲空间映射中为空的页面没有记录，不需要读取
+        if (!file_handle_->may_have_records(page_no_)) continue;
+        // 进入新的页面，由缓冲池识别顺序访问并预读后续页面
+        file_handle_->buffer_pool_manager_->read_ahead(PageId{file_handle_->fd_, page_no_},
+                                                       file_handle_->file_hdr_.num_pages, strategy_);
+        auto page_handle = file_handle_->fetch_page_handle(page_no_, strategy_);
+        batch->page_no = page_no_;
+        batch->record_size = record_size;
+        batch->slots.clear();
+        if (file_handle_->is_slotted()) {
+            read_slotted_page(page_handle, batch);
+        } else {
+            batch->data.resize(static_cast<size_t>(Bitmap::count(page_handle.bitmap, num_slots)) * record_size);
+            size_t offset = 0;
+            for (int begin = Bitmap::first_bit(true, page_handle.bitmap, num_slots); begin < num_slots;) {
+                int end = Bitmap::next_bit(false, page_handle.bitmap, num_slots, begin);
+                size_t len = static_cast<size_t>(end - begin) * record_size;
+                memcpy(batch->data.data() + offset, page_handle.get_slot(begin), len);
+                offset += len;
+                for (int slot_no = begin; slot_no < end; slot_no++) batch->slots.push_back(slot_no);
+                begin = Bitmap::next_bit(true, page_handle.bitmap, num_slots, end);
+            }
+        }
+        file_handle_->buffer_pool_manager_->unpin_page(PageId{file_handle_->fd_, page_no_}, false);
+        if (!batch->slots.empty()) {
+            page_no_++;
+            return true;
         }
-        // search failed
-        rid_.slot_no = -1;
-        rid_.page_no++;
     }
-    rid_.page_no = RM_NO_PAGE;
-
+    return false;
 }
 
 /**
- * @brief ​ 判断是否到达文件末尾
+ * @description: 解码槽页中的全部记录，页面由调用者固定
  */
+void RmPageScan::read_slotted_page(const RmPageHandle &page_handle, RmPageBatch *batch) {
+    int record_size = file_handle_->file_hdr_.record_size;
+    int num_slots = page_handle.slotted_hdr()->num_slots;
+    batch->data.resize(static_cast<size_t>(page_handle.page_hdr->num_records) * record_size);
+    for (int slot_no = 0; slot_no < num_slots; slot_no++) {
+        char *out = batch->data.data() + batch->slots.size() * record_size;
+        if (file_handle_->read_slotted_record(page_handle, slot_no, out, strategy_)) batch->slots.push_back(slot_no);
+    }
+}
+
+RmScan::RmScan(const RmFileHandle *file_handle, BufferAccessStrategy *strategy)
+    : page_scan_(file_handle, strategy) {
+    // 初始化rid，指向第一个存放了记录的位置
+    if (page_scan_.next_page(&batch_)) {
+        rid_ = batch_.rid(0);
+    } else {
+        rid_ = Rid{RM_NO_PAGE, -1};
+    }
+}
+
+void RmScan::next() {
+    // 找到文件中下一个存放了记录的非空闲位置，用rid_来指向这个位置；当前页面的记录用完后读取下一个页面
+    if (++pos_ < batch_.size()) {
+        rid_ = batch_.rid(pos_);
+        return;
+    }
+    pos_ = 0;
+    if (page_scan_.next_page(&batch_)) {
+        rid_ = batch_.rid(0);
+    } else {
+        rid_ = Rid{RM_NO_PAGE, -1};
+    }
+}
+
 bool RmScan::is_end() const {
-    // Todo: 修改返回值
     return rid_.page_no == RM_NO_PAGE;
 }
 
-/**
- * @brief RmScan内部存放的rid
- */
 Rid RmScan::rid() const {
     return rid_;
-}
\ No newline at end of file
+}
@@ -10,19 +10,60 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include <vector>
+
 #include "rm_defs.h"
 
 class RmFileHandle;
+struct RmPageHandle;
 
-class RmScan : public RecScan {
+/* 一个页面中的全部记录：页面只在读取时固定一次，记录被拷贝到batch中，之后可以在不固定页面的情况下逐条访问 */
+struct RmPageBatch {
+    page_id_t page_no = RM_NO_PAGE;
+    int record_size = 0;
+    std::vector<int> slots;     // 页面中存放了记录的slot，按slot_no递增
+    std::vector<char> data;     // 各条记录的数据，第i条记录位于data.data() + i * record_size
+
+    size_t size() const { return slots.size(); }
+
+    Rid rid(size_t i) const { return Rid{page_no, slots[i]}; }
+
+    const char *record(size_t i) const { return data.data() + i * record_size; }
+};
+
+/* 按页面扫描表数据文件：每次读取一个有记录的页面中的全部记录，每个页面只访问一次缓冲池 */
+class RmPageScan {
     const RmFileHandle *file_handle_;
+    BufferAccessStrategy *strategy_;    // 扫描使用的缓冲池访问策略，为nullptr时使用整个缓冲池
+    int page_no_;                       // 下一个要读取的页面
+public:
+    RmPageScan(const RmFileHandle *file_handle, BufferAccessStrategy *strategy = nullptr);
+
+    bool next_page(RmPageBatch *batch);
+
+private:
+    void read_slotted_page(const RmPageHandle &page_handle, RmPageBatch *batch);
+};
+
+/* 逐条扫描记录，基于RmPageScan按页面读取，rid()和record()返回当前记录 */
+class RmScan : public RecScan {
+    RmPageScan page_scan_;
+    RmPageBatch batch_;     // 当前页面中的记录
+    size_t pos_ = 0;        // 当前记录在batch_中的下标
     Rid rid_;
 public:
-    RmScan(const RmFileHandle *file_handle);
+    RmScan(const RmFileHandle *file_handle, BufferAccessStrategy *strategy = nullptr);
 
     void next() override;
 
     bool is_end() const override;
 
     Rid rid() const override;
+
+    /**
+     * @description: 当前记录的数据，在扫描进入下一个页面之前有效
+     */
+    const char *record() const { return batch_.record(pos_); }
+
+    int record_size() const { return batch_.record_size; }
 };
@@ -28,8 +28,10 @@ static constexpr int OFFSET_LOG_TOT_LEN = OFFSET_LSN + sizeof(lsn_t);
 static constexpr int OFFSET_LOG_TID = OFFSET_LOG_TOT_LEN + sizeof(uint32_t);
 // the offset of prev_lsn_ in log header
 static constexpr int OFFSET_PREV_LSN = OFFSET_LOG_TID + sizeof(txn_id_t);
+// the offset of log_oid_ in log header
+static constexpr int OFFSET_LOG_OID = OFFSET_PREV_LSN + sizeof(lsn_t);
 // offset of log data
-static constexpr int OFFSET_LOG_DATA = OFFSET_PREV_LSN + sizeof(lsn_t);
+static constexpr int OFFSET_LOG_DATA = OFFSET_LOG_OID + sizeof(oid_t);
 // sizeof log_header
 static constexpr int LOG_HEADER_SIZE = OFFSET_LOG_DATA;
 
@@ -8,37 +8,155 @@ EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
 MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
 See the Mulan PSL v2 for more details. */
 
+#include <algorithm>
 #include <cstring>
 #include "log_manager.h"
+#include "errors.h"
+
+// 组提交时刷日志线程额外等待的时间，默认不等待：上一批写入期间到达的提交自然组成下一批
+std::chrono::microseconds log_timeout = std::chrono::microseconds(0);
+// 等待的事务达到这个数量时刷日志线程不再等待，立即写入
+size_t group_commit_batch_size = GROUP_COMMIT_BATCH_SIZE;
 
 /**
  * @description: 添加日志记录到日志缓冲区中，并返回日志记录号
- * @param {
- *
- * *} log_record 要写入缓冲区的日志记录
+ *               日志号和写入位置一起预留，序列化时不持有任何锁；当前缓冲区放不下时先交换缓冲区再重试
+ * @param {LogRecord*} log_record 要写入缓冲区的日志记录
  * @return {lsn_t} 返回该日志的日志记录号
  */
 lsn_t LogManager::add_log_to_buffer(LogRecord* log_record) {
-    std::scoped_lock lock{latch_};
-    if(log_buffer_.is_full((int)log_record->log_tot_len_)){
-        disk_manager_->write_log(log_buffer_.buffer_ , log_buffer_.offset_);
-        memset(log_buffer_.buffer_, 0, sizeof(log_buffer_.buffer_));
-        log_buffer_.offset_ = 0;
-        persist_lsn_ = global_lsn_;
-    }
-    log_record->lsn_ = global_lsn_;
-    log_record->serialize(log_buffer_.buffer_ + log_buffer_.offset_);
-    log_buffer_.offset_ += (int)log_record->log_tot_len_;
-    return global_lsn_++;
+    uint64_t len = log_record->log_tot_len_;
+    if (len > (uint64_t)LOG_BUFFER_SIZE) {
+        throw InternalError("LogManager::add_log_to_buffer: log record is larger than the log buffer");
+    }
+    uint64_t state = reserve_state_.load();
+    while (true) {
+        uint64_t offset = state & BUFFER_OFFSET_MASK;
+        if (offset + len > (uint64_t)LOG_BUFFER_SIZE) {
+            // 当前缓冲区已满，若其他线程还没有交换缓冲区，则由本线程交换并写入磁盘
+            {
+                std::lock_guard<std::mutex> lock{latch_};
+                uint64_t cur = reserve_state_.load();
+                if ((cur & BUFFER_INDEX_BIT) == (state & BUFFER_INDEX_BIT) &&
+                    (cur & BUFFER_OFFSET_MASK) + len > (uint64_t)LOG_BUFFER_SIZE) {
+                    swap_and_write_buffer();
+                }
+            }
+            state = reserve_state_.load();
+            continue;
+        }
+        // 日志号加一，写入位置后移len字节
+        if (reserve_state_.compare_exchange_weak(state, state + (1ull << 32) + len)) break;
+    }
+
+    int index = (state & BUFFER_INDEX_BIT) ? 1 : 0;
+    int offset = (int)(state & BUFFER_OFFSET_MASK);
+    log_record->lsn_ = (lsn_t)(state >> 32);
+    log_record->serialize(buffers_[index].buffer_ + offset);
+    // release保证写入磁盘的线程看到filled_时也能看到序列化的内容
+    filled_[index].fetch_add((int)len, std::memory_order_release);
+    return log_record->lsn_;
 }
 
 /**
- * @description: 把日志缓冲区的内容刷到磁盘中，由于目前只设置了一个缓冲区，因此需要阻塞其他日志操作
+ * @description: 把日志缓冲区的内容刷到磁盘中，追加日志的线程在此期间写入另一个缓冲区，不会被阻塞
  */
 void LogManager::flush_log_to_disk() {
-    std::scoped_lock lock{latch_};
-    disk_manager_->write_log(log_buffer_.buffer_ , log_buffer_.offset_);
-    memset(log_buffer_.buffer_, 0, sizeof(log_buffer_.buffer_));
-    log_buffer_.offset_ = 0;
-    persist_lsn_ = global_lsn_;
+    std::lock_guard<std::mutex> lock{latch_};
+    swap_and_write_buffer();
+}
+
+/**
+ * @description: 交换两个缓冲区，等待旧缓冲区中已预留的日志都序列化完成后写入磁盘并同步，调用者需持有latch_
+ *               另一个缓冲区在上一次写入后已经清空，交换之后新的日志都写入其中
+ */
+void LogManager::swap_and_write_buffer() {
+    {
+        // 写入失败后缓冲区和日志文件的内容都不再可靠，之后的写入都报告同一个错误
+        std::lock_guard<std::mutex> lock{flush_latch_};
+        if (flush_error_ != nullptr) std::rethrow_exception(flush_error_);
+    }
+    uint64_t state = reserve_state_.load();
+    while (!reserve_state_.compare_exchange_weak(state, ((state & ~BUFFER_OFFSET_MASK) ^ BUFFER_INDEX_BIT))) {
+    }
+    int index = (state & BUFFER_INDEX_BIT) ? 1 : 0;
+    int size = (int)(state & BUFFER_OFFSET_MASK);
+    lsn_t lsn = (lsn_t)(state >> 32);
+
+    // 等待已经在旧缓冲区中预留了位置的线程完成序列化
+    while (filled_[index].load(std::memory_order_acquire) != size) {
+        std::this_thread::yield();
+    }
+    auto &buffer = buffers_[index];
+    buffer.offset_ = size;
+    try {
+        disk_manager_->write_log(buffer.buffer_, buffer.offset_);
+        disk_manager_->sync_log();
+    } catch (RMDBError &) {
+        {
+            std::lock_guard<std::mutex> lock{flush_latch_};
+            flush_error_ = std::current_exception();
+        }
+        persist_cv_.notify_all();
+        throw;
+    }
+    memset(buffer.buffer_, 0, buffer.offset_);
+    buffer.offset_ = 0;
+    filled_[index].store(0);
+    advance_persist_lsn(lsn);
+}
+
+/**
+ * @description: 等待日志号不超过lsn的日志都持久化到磁盘中，由刷日志线程与其他等待者成组写入
+ *               日志写入失败时抛出写入时的异常，事务不能认为已经提交
+ * @param {lsn_t} lsn 需要持久化的日志号
+ */
+void LogManager::wait_for_flush(lsn_t lsn) {
+    if (persist_lsn_.load() > lsn) return;
+    std::unique_lock<std::mutex> lock{flush_latch_};
+    flush_request_lsn_ = std::max(flush_request_lsn_, lsn);
+    num_waiters_++;
+    flush_cv_.notify_one();
+    persist_cv_.wait(lock, [&] { return persist_lsn_.load() > lsn || flush_error_ != nullptr; });
+    num_waiters_--;
+    if (persist_lsn_.load() <= lsn) std::rethrow_exception(flush_error_);
+}
+
+/**
+ * @description: 刷日志线程：有等待者时等待更多的事务加入本批，然后一次写入并同步日志，唤醒所有等待者
+ *               写入失败时错误已记录在flush_error_中并唤醒了等待者，线程随即退出
+ */
+void LogManager::flush_thread() {
+    std::unique_lock<std::mutex> lock{flush_latch_};
+    while (true) {
+        flush_cv_.wait(lock, [&] { return stop_ || persist_lsn_.load() <= flush_request_lsn_; });
+        if (persist_lsn_.load() > flush_request_lsn_) return;
+        if (log_timeout_.count() > 0) {
+            flush_cv_.wait_for(lock, log_timeout_, [&] { return stop_ || num_waiters_ >= group_commit_batch_size_; });
+        }
+        // 先计数，等待者被唤醒时已经能看到本次写入
+        group_flush_count_++;
+        lock.unlock();
+        try {
+            flush_log_to_disk();
+        } catch (RMDBError &) {
+            return;
+        }
+        lock.lock();
+    }
+}
+
+/**
+ * @description: 推进persist_lsn_并唤醒等待持久化的事务，persist_lsn_只会增大
+ * @param {lsn_t} lsn 日志号小于lsn的日志都已持久化
+ */
+void LogManager::advance_persist_lsn(lsn_t lsn) {
+    lsn_t cur = persist_lsn_.load();
+    while (cur < lsn && !persist_lsn_.compare_exchange_weak(cur, lsn)) {
+    }
+    {
+        // 等待者在flush_latch_下检查persist_lsn_，加锁保证通知不会丢失
+        std::lock_guard<std::mutex> lock{flush_latch_};
+    }
+    persist_cv_.notify_all();
 }
@@ -10,7 +10,10 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include <condition_variable>
+#include <exception>
 #include <mutex>
+#include <thread>
 #include <utility>
 #include <vector>
 #include <iostream>
@@ -31,7 +34,8 @@ enum LogRecordType : int {
     UNDO_NEXT,
     INDEX_PAGE,
     CREATE_INDEX,
-    DROP_INDEX
+    DROP_INDEX,
+    PAGE_DELTA
 };
 
 enum TxnStatus {
@@ -52,7 +56,8 @@ static std::string LogTypeStr[] = {
         "UNDO_NEXT",
         "INDEX_PAGE",
         "CREATE_INDEX",
-        "DROP_INDEX"
+        "DROP_INDEX",
+        "PAGE_DELTA"
 };
 
 class LogRecord {
@@ -62,6 +67,7 @@ public:
     uint32_t log_tot_len_;     /* 整个日志记录的长度 */
     txn_id_t log_tid_;         /* 创建当前日志的事务ID */
     lsn_t prev_lsn_;           /* 事务的前一条日志记录的lsn，用于undo */
+    oid_t log_oid_;            /* 日志涉及的表或索引在目录中的对象ID，与具体对象无关的日志为INVALID_OID */
 
     LogRecord() {
         log_type_ = LogRecordType::BEGIN;
@@ -69,6 +75,7 @@ public:
         log_tot_len_ = 0;
         log_tid_ = -1;
         prev_lsn_ = -1;
+        log_oid_ = INVALID_OID;
     }
 
     LogRecord(const LogRecord &other) {
@@ -77,6 +84,7 @@ public:
         log_tot_len_ = other.log_tot_len_;
         log_tid_ = other.log_tid_;
         prev_lsn_ = other.prev_lsn_;
+        log_oid_ = other.log_oid_;
     }
 
     // 把日志记录序列化到dest中
@@ -86,6 +94,7 @@ public:
         memcpy(dest + OFFSET_LOG_TOT_LEN, &log_tot_len_, sizeof(uint32_t));
         memcpy(dest + OFFSET_LOG_TID, &log_tid_, sizeof(txn_id_t));
         memcpy(dest + OFFSET_PREV_LSN, &prev_lsn_, sizeof(lsn_t));
+        memcpy(dest + OFFSET_LOG_OID, &log_oid_, sizeof(oid_t));
     }
 
     // 从src中反序列化出一条日志记录
@@ -95,6 +104,7 @@ public:
         log_tot_len_ = *reinterpret_cast<const uint32_t *>(src + OFFSET_LOG_TOT_LEN);
         log_tid_ = *reinterpret_cast<const txn_id_t *>(src + OFFSET_LOG_TID);
         prev_lsn_ = *reinterpret_cast<const lsn_t *>(src + OFFSET_PREV_LSN);
+        log_oid_ = *reinterpret_cast<const oid_t *>(src + OFFSET_LOG_OID);
     }
 
     // used for debug
@@ -106,16 +116,17 @@ public:
         printf("log_tot_len: %d\n", log_tot_len_);
         printf("log_tid: %d\n", log_tid_);
         printf("prev_lsn: %d\n", prev_lsn_);
+        printf("log_oid: %d\n", log_oid_);
     }
 };
 
 /**
  * For every write operation on the table page, you should write ahead a corresponding log record.
  *
- * For EACH log record, HEADER is like (5 fields in common, 20 bytes in total).
- *---------------------------------------------
- * | size | LSN | transID | prevLSN | LogRecordType |
- *---------------------------------------------
+ * For EACH log record, HEADER is like (6 fields in common, 22 bytes in total).
+ *---------------------------------------------------------
+ * | LogRecordType | LSN | size | transID | prevLSN | OID |
+ *---------------------------------------------------------
  * For insert type log record
  *---------------------------------------------------------------
  * | HEADER | tuple_rid | tuple_size | tuple_data(char[] array) |
@@ -272,10 +283,9 @@ public:
         log_tot_len_ = LOG_HEADER_SIZE;
         log_tid_ = INVALID_TXN_ID;
         prev_lsn_ = INVALID_LSN;
-        table_name_ = nullptr;
     }
 
-    InsertLogRecord(txn_id_t txn_id, int prev_lsn, RmRecord &insert_value, const Rid &rid, std::string table_name)
+    InsertLogRecord(txn_id_t txn_id, int prev_lsn, RmRecord &insert_value, const Rid &rid, oid_t oid)
             : InsertLogRecord() {
         prev_lsn_ = prev_lsn;
         log_tid_ = txn_id;
@@ -284,18 +294,11 @@ public:
         log_tot_len_ += sizeof(int);
         log_tot_len_ += insert_value_.size;
         log_tot_len_ += sizeof(Rid);
-        table_name_size_ = table_name.length() + 1;
-        table_name_ = new char[table_name_size_];
-        memcpy(table_name_, table_name.c_str(), table_name_size_);
-        log_tot_len_ += sizeof(size_t) + table_name_size_;
+        log_oid_ = oid;
+        log_tot_len_ += sizeof(undo_next);
         undo_next = -1;
     }
 
-    ~InsertLogRecord() {
-        delete[] table_name_;
-        table_name_ = nullptr;
-    }
-
     // 把insert日志记录序列化到dest中
     void serialize(char *dest) const override {
         LogRecord::serialize(dest);
@@ -306,10 +309,6 @@ public:
         offset += insert_value_.size;
         memcpy(dest + offset, &rid_, sizeof(Rid));
         offset += sizeof(Rid);
-        memcpy(dest + offset, &table_name_size_, sizeof(size_t));
-        offset += sizeof(size_t);
-        memcpy(dest + offset, table_name_, table_name_size_);
-        offset += table_name_size_;
         memmove(dest + offset, &undo_next, sizeof(undo_next));
     }
 
@@ -320,11 +319,6 @@ public:
         int offset = OFFSET_LOG_DATA + insert_value_.size + sizeof(int);
         rid_ = *reinterpret_cast<const Rid *>(src + offset);
         offset += sizeof(Rid);
-        table_name_size_ = *reinterpret_cast<const size_t *>(src + offset);
-        offset += sizeof(size_t);
-        table_name_ = new char[table_name_size_];
-        memcpy(table_name_, src + offset, table_name_size_);
-        offset += table_name_size_;
         undo_next = *(lsn_t *) (src + offset);
     }
 
@@ -333,13 +327,11 @@ public:
         LogRecord::format_print();
         printf("insert_value: %s\n", insert_value_.data);
         printf("insert rid: %d, %d\n", rid_.page_no, rid_.slot_no);
-        printf("table name: %s\n", table_name_);
+        printf("table oid: %d\n", log_oid_);
     }
 
     RmRecord insert_value_;     // 插入的记录
     Rid rid_;                   // 记录插入的位置
-    char *table_name_;          // 插入记录的表名称
-    size_t table_name_size_;    // 表名称的大小
     lsn_t undo_next;
 };
 
@@ -354,10 +346,9 @@ public:
         log_tot_len_ = LOG_HEADER_SIZE;
         log_tid_ = INVALID_TXN_ID;
         prev_lsn_ = INVALID_LSN;
-        table_name_ = nullptr;
     }
 
-    DeleteLogRecord(txn_id_t txn_id, int prev_lsn, RmRecord &delete_value, const Rid &rid, std::string table_name)
+    DeleteLogRecord(txn_id_t txn_id, int prev_lsn, RmRecord &delete_value, const Rid &rid, oid_t oid)
             : DeleteLogRecord() {
         prev_lsn_ = prev_lsn;
         log_tid_ = txn_id;
@@ -366,17 +357,11 @@ public:
         log_tot_len_ += sizeof(int);
         log_tot_len_ += delete_value.size;
         log_tot_len_ += sizeof(Rid);
-        table_name_size_ = table_name.length() + 1;
-        table_name_ = new char[table_name_size_];
-        memcpy(table_name_, table_name.c_str(), table_name_size_);
-        log_tot_len_ += sizeof(size_t) + table_name_size_;
+        log_oid_ = oid;
+        log_tot_len_ += sizeof(undo_next);
         undo_next = -1;
     }
 
-    ~DeleteLogRecord() {
-        delete[] table_name_;
-    }
-
     // 把insert日志记录序列化到dest中
     void serialize(char *dest) const override {
         LogRecord::serialize(dest);
@@ -387,10 +372,6 @@ public:
         offset += delete_value_.size;
         memcpy(dest + offset, &rid_, sizeof(Rid));
         offset += sizeof(Rid);
-        memcpy(dest + offset, &table_name_size_, sizeof(size_t));
-        offset += sizeof(size_t);
-        memcpy(dest + offset, table_name_, table_name_size_);
-        offset += (int) table_name_size_;
         memmove(dest + offset, &undo_next, sizeof(undo_next));
     }
 
@@ -401,11 +382,6 @@ public:
         int offset = OFFSET_LOG_DATA + delete_value_.size + sizeof(int);
         rid_ = *reinterpret_cast<const Rid *>(src + offset);
         offset += sizeof(Rid);
-        table_name_size_ = *reinterpret_cast<const size_t *>(src + offset);
-        offset += sizeof(size_t);
-        table_name_ = new char[table_name_size_];
-        memcpy(table_name_, src + offset, table_name_size_);
-        offset += table_name_size_;
         undo_next = *(lsn_t *) (src + offset);
     }
 
@@ -414,13 +390,11 @@ public:
         LogRecord::format_print();
         printf("delete_value: %s\n", delete_value_.data);
         printf("delete rid: %d, %d\n", rid_.page_no, rid_.slot_no);
-        printf("table name: %s\n", table_name_);
+        printf("table oid: %d\n", log_oid_);
     }
 
     RmRecord delete_value_;     // 插入的记录
     Rid rid_{};                   // 记录插入的位置
-    char *table_name_;          // 插入记录的表名称
-    size_t table_name_size_{};    // 表名称的大小
     lsn_t undo_next;
 };
 
@@ -435,11 +409,9 @@ public:
         log_tot_len_ = LOG_HEADER_SIZE;
         log_tid_ = INVALID_TXN_ID;
         prev_lsn_ = INVALID_LSN;
-        table_name_ = nullptr;
     }
 
-    UpdateLogRecord(txn_id_t txn_id, int prev_lsn, RmRecord &new_value, RmRecord &old_value, const Rid &rid,
-                    std::string table_name)
+    UpdateLogRecord(txn_id_t txn_id, int prev_lsn, RmRecord &new_value, RmRecord &old_value, const Rid &rid, oid_t oid)
             : UpdateLogRecord() {
         prev_lsn_ = prev_lsn;
         log_tid_ = txn_id;
@@ -450,17 +422,11 @@ public:
         log_tot_len_ += old_value_.size;
         log_tot_len_ += new_value_.size;
         log_tot_len_ += sizeof(Rid);
-        table_name_size_ = table_name.length() + 1;
-        table_name_ = new char[table_name_size_];
-        memcpy(table_name_, table_name.c_str(), table_name_size_);
-        log_tot_len_ += sizeof(size_t) + table_name_size_;
+        log_oid_ = oid;
+        log_tot_len_ += sizeof(undo_next);
         undo_next = -1;
     }
 
-    ~UpdateLogRecord() {
-        delete[] table_name_;
-    }
-
     // 把insert日志记录序列化到dest中
     void serialize(char *dest) const override {
         LogRecord::serialize(dest);
@@ -475,10 +441,6 @@ public:
         offset += new_value_.size;
         memcpy(dest + offset, &rid_, sizeof(Rid));
         offset += sizeof(Rid);
-        memcpy(dest + offset, &table_name_size_, sizeof(size_t));
-        offset += sizeof(size_t);
-        memcpy(dest + offset, table_name_, table_name_size_);
-        offset += table_name_size_;
         memmove(dest + offset, &undo_next, sizeof(undo_next));
     }
 
@@ -491,11 +453,6 @@ public:
         offset = offset + new_value_.size + sizeof(int);
         rid_ = *reinterpret_cast<const Rid *>(src + offset);
         offset += sizeof(Rid);
-        table_name_size_ = *reinterpret_cast<const size_t *>(src + offset);
-        offset += sizeof(size_t);
-        table_name_ = new char[table_name_size_];
-        memcpy(table_name_, src + offset, table_name_size_);
-        offset += table_name_size_;
         undo_next = *(lsn_t *) (src + offset);
     }
 
@@ -505,14 +462,12 @@ public:
         printf("update_old_value: %s\n", old_value_.data);
         printf("update_new_value: %s\n", new_value_.data);
         printf("update rid: %d, %d\n", rid_.page_no, rid_.slot_no);
-        printf("table name: %s\n", table_name_);
+        printf("table oid: %d\n", log_oid_);
     }
 
     RmRecord old_value_;        // 修改前的记录
     RmRecord new_value_;        // 修改后的记录
     Rid rid_{};                   // 修改记录的位置
-    char *table_name_;          // 插入记录的表名称
-    size_t table_name_size_{};    // 表名称的大小
     lsn_t undo_next;
 };
 
@@ -528,14 +483,11 @@ public:
         new_page = nullptr;
     }
 
-    PageLogRecord(txn_id_t txn_id, int prev_lsn, const std::string &tab_name_, size_t page_no_, char *old_data_)
+    PageLogRecord(txn_id_t txn_id, int prev_lsn, oid_t oid, size_t page_no_, char *old_data_)
             : PageLogRecord() {
         log_tid_ = txn_id;
         prev_lsn_ = prev_lsn;
-
-        tab_name = tab_name_;
-        log_tot_len_ += sizeof(size_t);
-        log_tot_len_ += tab_name.size();
+        log_oid_ = oid;
 
         page_no = page_no_;
         log_tot_len_ += sizeof(page_no);
@@ -556,13 +508,6 @@ public:
     void serialize(char *dest) const override {
         LogRecord::serialize(dest);
         size_t offset = LOG_HEADER_SIZE;
-        auto tab_name_size = tab_name.size();
-
-        memmove(dest + offset, &tab_name_size, sizeof(tab_name_size));
-        offset += sizeof(tab_name_size);
-
-        memmove(dest + offset, tab_name.c_str(), tab_name_size);
-        offset += tab_name_size;
 
         memmove(dest + offset, &page_no, sizeof(size_t));
         offset += sizeof(size_t);
@@ -578,15 +523,6 @@ public:
         LogRecord::deserialize(src);
 
         size_t offset = LOG_HEADER_SIZE;
-        size_t tab_name_size = *(size_t *) (src + offset);
-        offset += sizeof(tab_name_size);
-
-        char *tab_name_temp = new char[tab_name_size + 1];
-        memmove(tab_name_temp, src + offset, tab_name_size);
-        tab_name_temp[tab_name_size] = '\0';
-        tab_name = tab_name_temp;
-//        delete[] tab_name_temp;
-        offset += tab_name_size;
 
         page_no = *(size_t *) (src + offset);
         offset += sizeof(page_no);
@@ -609,14 +545,135 @@ public:
         memmove(new_page, src, PAGE_SIZE);
     }
 
-    std::string tab_name;
-
     size_t page_no;
 
     char *old_page;
     char *new_page;
 };
 
+/**
+ * 页面的差异日志：只记录页面中被修改的字节区间修改前后的内容，redo时把修改后的内容写回这些区间。
+ * 日志格式：| header | page_no | num_ranges | (offset, len) * num_ranges | 修改前的字节 | 修改后的字节 |
+ */
+class PageDeltaLogRecord : public LogRecord {
+public:
+    struct Range {
+        uint16_t offset;
+        uint16_t len;
+    };
+
+    // 两个被修改的区间之间相同的字节少于该值时合并为一个区间，避免记录过多的小区间
+    static constexpr int MERGE_GAP = 8;
+
+    PageDeltaLogRecord() {
+        log_type_ = LogRecordType::PAGE_DELTA;
+        lsn_ = INVALID_LSN;
+        log_tot_len_ = LOG_HEADER_SIZE;
+        log_tid_ = INVALID_TXN_ID;
+        prev_lsn_ = INVALID_LSN;
+    }
+
+    /**
+     * @description: 比较修改前后的内容，生成差异日志
+     * @param {char*} old_data 修改前的内容
+     * @param {char*} new_data 修改后的内容
+     * @param {int} size 比较的字节数，不超过PAGE_SIZE
+     */
+    PageDeltaLogRecord(txn_id_t txn_id, int prev_lsn, oid_t oid, size_t page_no_, const char *old_data,
+                       const char *new_data, int size)
+            : PageDeltaLogRecord() {
+        log_tid_ = txn_id;
+        prev_lsn_ = prev_lsn;
+        log_oid_ = oid;
+        page_no = page_no_;
+
+        int i = 0;
+        while (i < size) {
+            // 按8字节跳过相同的内容
+            if (i + 8 <= size && memcmp(old_data + i, new_data + i, 8) == 0) {
+                i += 8;
+                continue;
+            }
+            if (old_data[i] == new_data[i]) {
+                i++;
+                continue;
+            }
+            int end = i + 1;
+            for (int j = end; j < size && j - end < MERGE_GAP; j++) {
+                if (old_data[j] != new_data[j]) end = j + 1;
+            }
+            ranges.push_back(Range{(uint16_t) i, (uint16_t) (end - i)});
+            old_bytes.insert(old_bytes.end(), old_data + i, old_data + end);
+            new_bytes.insert(new_bytes.end(), new_data + i, new_data + end);
+            i = end;
+        }
+
+        log_tot_len_ += sizeof(page_no) + sizeof(int);
+        log_tot_len_ += ranges.size() * sizeof(Range) + old_bytes.size() + new_bytes.size();
+    }
+
+    // 序列化差异日志记录到dest中
+    void serialize(char *dest) const override {
+        LogRecord::serialize(dest);
+        size_t offset = LOG_HEADER_SIZE;
+        memmove(dest + offset, &page_no, sizeof(page_no));
+        offset += sizeof(page_no);
+
+        int num_ranges = ranges.size();
+        memmove(dest + offset, &num_ranges, sizeof(num_ranges));
+        offset += sizeof(num_ranges);
+        memmove(dest + offset, ranges.data(), num_ranges * sizeof(Range));
+        offset += num_ranges * sizeof(Range);
+        memmove(dest + offset, old_bytes.data(), old_bytes.size());
+        offset += old_bytes.size();
+        memmove(dest + offset, new_bytes.data(), new_bytes.size());
+    }
+
+    // 从src中反序列化出一条差异日志记录
+    void deserialize(const char *src) override {
+        LogRecord::deserialize(src);
+        size_t offset = LOG_HEADER_SIZE;
+        page_no = *(size_t *) (src + offset);
+        offset += sizeof(page_no);
+
+        int num_ranges = *(int *) (src + offset);
+        offset += sizeof(num_ranges);
+        ranges.resize(num_ranges);
+        memmove(ranges.data(), src + offset, num_ranges * sizeof(Range));
+        offset += num_ranges * sizeof(Range);
+        size_t num_bytes = 0;
+        for (auto &range : ranges) num_bytes += range.len;
+        old_bytes.assign(src + offset, src + offset + num_bytes);
+        offset += num_bytes;
+        new_bytes.assign(src + offset, src + offset + num_bytes);
+    }
+
+    void format_print() override {
+        std::cout << "log type in son_function: " << LogTypeStr[log_type_] << "\n";
+        LogRecord::format_print();
+    }
+
+    // 将修改后的内容写入data
+    void redo(char *data) const { apply(data, new_bytes); }
+
+    // 将修改前的内容写入data
+    void undo(char *data) const { apply(data, old_bytes); }
+
+    size_t page_no;
+    std::vector<Range> ranges;
+    std::vector<char> old_bytes;
+    std::vector<char> new_bytes;
+
+private:
+    void apply(char *data, const std::vector<char> &bytes) const {
+        size_t offset = 0;
+        for (auto &range : ranges) {
+            memmove(data + range.offset, bytes.data() + offset, range.len);
+            offset += range.len;
+        }
+    }
+};
+
 class UndoNextLogRecord : public LogRecord {
 public:
     UndoNextLogRecord() {
@@ -666,11 +723,11 @@ public:
         hdr_len = 0;
     }
 
-    IndexPagesLogRecord(txn_id_t txn_id, int prev_lsn, std::string idx_name_) : IndexPagesLogRecord() {
+    IndexPagesLogRecord(txn_id_t txn_id, int prev_lsn, oid_t oid) : IndexPagesLogRecord() {
         log_tid_ = txn_id;
         prev_lsn_ = prev_lsn;
-        idx_name = std::move(idx_name_);
-        log_tot_len_ += sizeof(size_t) + idx_name.size() + sizeof(size_t);
+        log_oid_ = oid;
+        log_tot_len_ += sizeof(size_t);
     }
 
     IndexPagesLogRecord(const IndexPagesLogRecord &other) : LogRecord(other) {
@@ -680,7 +737,6 @@ public:
         prev_lsn_ = other.prev_lsn_;
         log_type_ = other.log_type_;
 
-        idx_name = other.idx_name;
         page_ids = other.page_ids;
 
         for (auto page: other.pages) {
@@ -706,13 +762,6 @@ public:
         LogRecord::serialize(dest);
 
         size_t offset = LOG_HEADER_SIZE;
-        auto idx_name_size = idx_name.size();
-        memmove(dest + offset, &idx_name_size, sizeof(idx_name_size));
-        offset += sizeof(idx_name_size);
-
-        memmove(dest + offset, idx_name.c_str(), idx_name_size);
-        offset += idx_name_size;
-
         size_t n = pages.size();
         memmove(dest + offset, &n, sizeof(n));
         offset += sizeof(n);
@@ -740,14 +789,6 @@ public:
         LogRecord::deserialize(src);
 
         size_t offset = LOG_HEADER_SIZE;
-        size_t idx_name_size = *(size_t *) (src + offset);
-        offset += sizeof(idx_name_size);
-
-        auto idx_name_temp = new char[idx_name_size + 1]();
-        memmove(idx_name_temp, src + offset, idx_name_size);
-        idx_name = idx_name_temp;
-        offset += idx_name_size;
-
         size_t n = *(size_t *) (src + offset);
         offset += sizeof(n);
 
@@ -792,7 +833,6 @@ public:
         log_tot_len_ += sizeof(hdr_len) + hdr_len;
     }
 
-    std::string idx_name;
     std::vector<PageId> page_ids;
     std::vector<char *> pages;
     int hdr_len;
@@ -1005,21 +1045,71 @@ public:
     int offset_;    // 写入log的offset
 };
 
-/* 日志管理器，负责把日志写入日志缓冲区，以及把日志缓冲区中的内容写入磁盘中 */
+/*
+日志管理器，负责把日志写入日志缓冲区，以及把日志缓冲区中的内容写入磁盘中。
+日志管理器有两个日志缓冲区，追加日志时只写当前缓冲区；刷盘时两个缓冲区交换，旧缓冲区写入磁盘期间新日志继续写入另一个缓冲区。
+日志号和缓冲区中的写入位置打包在reserve_state_中，通过一次原子的比较交换同时预留，
+预留之后各线程并发地把日志序列化到互不重叠的区间中，因此日志在文件中的顺序与日志号的顺序一致。
+提交的事务通过wait_for_flush等待自己的日志持久化，由后台的刷日志线程成组写入并同步到磁盘：
+收到第一个请求后最多再等待log_timeout_，或等到group_commit_batch_size_个事务在等待，然后一次写入并唤醒所有等待者。
+写入或同步失败时记录错误并唤醒所有等待者，等待者和之后的写入都抛出该错误，已经提交的事务不会被误报为成功。
+*/
 class LogManager {
 public:
-    LogManager(DiskManager *disk_manager) { disk_manager_ = disk_manager; }
+    // 组提交的等待时间和批大小在构造时确定，默认取全局配置，刷日志线程运行期间不再读取全局变量
+    LogManager(DiskManager *disk_manager, std::chrono::microseconds timeout = log_timeout,
+               size_t batch_size = group_commit_batch_size)
+        : log_timeout_(timeout), group_commit_batch_size_(batch_size) {
+        disk_manager_ = disk_manager;
+        flusher_ = std::thread(&LogManager::flush_thread, this);
+    }
+
+    ~LogManager() {
+        {
+            std::lock_guard<std::mutex> lock{flush_latch_};
+            stop_ = true;
+        }
+        flush_cv_.notify_all();
+        flusher_.join();
+    }
 
     lsn_t add_log_to_buffer(LogRecord *log_record);
 
     void flush_log_to_disk();
 
-    LogBuffer *get_log_buffer() { return &log_buffer_; }
+    void wait_for_flush(lsn_t lsn);
+
+    /* 刷日志线程成组写入的次数 */
+    size_t get_group_flush_count() const { return group_flush_count_.load(); }
 
 // private:
-    std::atomic<lsn_t> global_lsn_{0};  // 全局lsn，递增，用于为每条记录分发lsn
-    std::mutex latch_;                  // 用于对log_buffer_的互斥访问
-    LogBuffer log_buffer_;              // 日志缓冲区
-    lsn_t persist_lsn_;                 // 记录已经持久化到磁盘中的最后一条日志的日志号
+    void flush_thread();
+
+    void advance_persist_lsn(lsn_t lsn);
+
+    void swap_and_write_buffer();
+
+    // reserve_state_的布局：高32位是下一个日志号，第31位是当前追加的缓冲区下标，低31位是该缓冲区中已预留的字节数
+    static constexpr uint64_t BUFFER_INDEX_BIT = 1ull << 31;
+    static constexpr uint64_t BUFFER_OFFSET_MASK = BUFFER_INDEX_BIT - 1;
+
+    std::atomic<uint64_t> reserve_state_{0};    // 日志号和写入位置的预留状态
+    LogBuffer buffers_[2];                      // 两个日志缓冲区，轮流用于追加和写入磁盘
+    std::atomic<int> filled_[2] = {0, 0};       // 各缓冲区中已经序列化完成的字节数
+    std::mutex latch_;                          // 保证同一时刻只有一个线程交换并写入缓冲区，日志按顺序写入文件
+    std::atomic<lsn_t> persist_lsn_{0}; // 日志号小于persist_lsn_的日志都已持久化到磁盘中，缓冲池的后台刷脏线程会并发读取
     DiskManager *disk_manager_;
+
+    // 组提交，加锁顺序为先latch_后flush_latch_
+    const std::chrono::microseconds log_timeout_;   // 刷日志线程收到请求后最多额外等待的时间
+    const size_t group_commit_batch_size_;          // 等待的事务达到这个数量时立即写入
+    std::mutex flush_latch_;                // 保护以下成员
+    std::condition_variable flush_cv_;      // 有新的刷盘请求或需要退出时通知刷日志线程
+    std::condition_variable persist_cv_;    // persist_lsn_推进时通知等待者
+    lsn_t flush_request_lsn_ = INVALID_LSN; // 等待者请求持久化的最大日志号
+    size_t num_waiters_ = 0;                // 正在等待的事务数
+    bool stop_ = false;
+    std::exception_ptr flush_error_;        // 日志写入失败时的异常，此后的写入和等待都抛出该异常
+    std::atomic<size_t> group_flush_count_{0};
+    std::thread flusher_;                   // 刷日志线程
 };
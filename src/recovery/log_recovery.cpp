@@ -77,6 +77,14 @@ void RecoveryManager::analyze() {
                     dirty_page_[rec.page_no] = rec.lsn_;
                 }
                 active_txn_[rec.log_tid_] = rec.lsn_;
+            } else if (log_rec.log_type_ == LogRecordType::PAGE_DELTA) {
+                disk_manager_->read_log(log, log_rec.log_tot_len_, offset);
+                PageDeltaLogRecord rec;
+                rec.deserialize(log);
+                if (dirty_page_.count(rec.page_no) != 0) {
+                    dirty_page_[rec.page_no] = rec.lsn_;
+                }
+                active_txn_[rec.log_tid_] = rec.lsn_;
             }
         }
         lsn_mapping_[log_rec.lsn_] = offset;
@@ -115,35 +123,60 @@ void RecoveryManager::redo() {
             disk_manager_->read_log(log, log_rec.log_tot_len_, offset);
             PageLogRecord rec;
             rec.deserialize(log);
-            auto file_handle = sm_manager_->fhs_.at(rec.tab_name).get();
+            auto file_handle = sm_manager_->get_file_handle(rec.log_oid_);
 
-            if (rec.page_no == 0) {
+            if (file_handle == nullptr) {
+                // 表在日志写入之后已被删除
+            } else if (rec.page_no == 0) {
                 if (file_handle->file_hdr_.lsn < rec.lsn_)
                     file_handle->file_hdr_ = *(RmFileHdr *) rec.new_page;
             } else {
                 auto page_handle = file_handle->fetch_page_handle(rec.page_no);
                 if (page_handle.page->get_page_lsn() < rec.lsn_) {
-                    memmove(page_handle.page, rec.new_page, PAGE_SIZE);
+                    memmove(page_handle.page->get_data(), rec.new_page, PAGE_SIZE);
                     buffer_pool_manager_->unpin_page(page_handle.page->get_page_id(), true);
                 } else buffer_pool_manager_->unpin_page(page_handle.page->get_page_id(), false);
             }
-        } else if (log_rec.log_type_ == LogRecordType::INDEX_PAGE) {
+        } else if (log_rec.log_type_ == LogRecordType::PAGE_DELTA) {
+            // 差异日志只包含被修改的区间，需要按顺序重放在页面之前的内容上
             disk_manager_->read_log(log, log_rec.log_tot_len_, offset);
-            IndexPagesLogRecord rec;
+            PageDeltaLogRecord rec;
             rec.deserialize(log);
+            auto file_handle = sm_manager_->get_file_handle(rec.log_oid_);
 
-            auto ih = sm_manager_->ihs_.at(rec.idx_name).get();
-            for (int i = 0; i < rec.pages.size(); i++) {
-                auto node = ih->fetch_node(rec.page_ids[i].page_no);
-                if (node->page->get_page_lsn() < rec.lsn_) {
-                    memmove(node->page->get_data(), rec.pages[i], PAGE_SIZE);
-                    buffer_pool_manager_->unpin_page(node->get_page_id(), true);
-                } else buffer_pool_manager_->unpin_page(node->get_page_id(), false);
+            if (file_handle == nullptr) {
+                // 表在日志写入之后已被删除
+            } else if (rec.page_no == 0) {
+                if (file_handle->file_hdr_.lsn < rec.lsn_) {
+                    rec.redo(reinterpret_cast<char *>(&file_handle->file_hdr_));
+                    file_handle->file_hdr_.lsn = rec.lsn_;
+                }
+            } else {
+                auto page_handle = file_handle->fetch_page_handle(rec.page_no);
+                if (page_handle.page->get_page_lsn() < rec.lsn_) {
+                    rec.redo(page_handle.page->get_data());
+                    page_handle.page->set_page_lsn(rec.lsn_);
+                    buffer_pool_manager_->unpin_page(page_handle.page->get_page_id(), true);
+                } else buffer_pool_manager_->unpin_page(page_handle.page->get_page_id(), false);
             }
+        } else if (log_rec.log_type_ == LogRecordType::INDEX_PAGE) {
+            disk_manager_->read_log(log, log_rec.log_tot_len_, offset);
+            IndexPagesLogRecord rec;
+            rec.deserialize(log);
 
+            auto ih = sm_manager_->get_index_handle(rec.log_oid_);
+            if (ih != nullptr) {
+                for (int i = 0; i < rec.pages.size(); i++) {
+                    auto node = ih->fetch_node(rec.page_ids[i].page_no);
+                    if (node->page->get_page_lsn() < rec.lsn_) {
+                        memmove(node->page->get_data(), rec.pages[i], PAGE_SIZE);
+                        buffer_pool_manager_->unpin_page(node->get_page_id(), true);
+                    } else buffer_pool_manager_->unpin_page(node->get_page_id(), false);
+                }
 
-            if (ih->file_hdr_->lsn < rec.lsn_)
-                ih->file_hdr_->deserialize(rec.file_hdr);
+                if (ih->file_hdr_->lsn < rec.lsn_)
+                    ih->file_hdr_->deserialize(rec.file_hdr);
+            }
         }
 
         offset += (int )log_rec.log_tot_len_;
@@ -202,20 +235,23 @@ void RecoveryManager::undo() {
                 rec.deserialize(log);
 
                 prev_lsn = rec.lsn_;
-                sm_manager_->rollback_update(rec.table_name_, rec.rid_, rec.old_value_, nullptr);
+                auto tab = sm_manager_->db_.get_table(rec.log_oid_);
+                if (tab != nullptr) sm_manager_->rollback_update(tab->name, rec.rid_, rec.old_value_, nullptr);
             } else if (log_rec.log_type_ == LogRecordType::DELETE) {
                 disk_manager_->read_log(log, (int )log_rec.log_tot_len_, offset);
                 DeleteLogRecord rec;
                 rec.deserialize(log);
                 prev_lsn = rec.lsn_;
-                sm_manager_->rollback_delete(rec.table_name_, rec.rid_, rec.delete_value_, nullptr);
+                auto tab = sm_manager_->db_.get_table(rec.log_oid_);
+                if (tab != nullptr) sm_manager_->rollback_delete(tab->name, rec.rid_, rec.delete_value_, nullptr);
             } else if (log_rec.log_type_ == LogRecordType::INSERT) {
                 disk_manager_->read_log(log, (int )log_rec.log_tot_len_, offset);
                 InsertLogRecord rec;
                 rec.deserialize(log);
 
                 prev_lsn = rec.lsn_;
-                sm_manager_->rollback_insert(rec.table_name_, rec.rid_, nullptr);
+                auto tab = sm_manager_->db_.get_table(rec.log_oid_);
+                if (tab != nullptr) sm_manager_->rollback_insert(tab->name, rec.rid_, nullptr);
             } else if (log_rec.log_type_ == LogRecordType::CREATE_INDEX) {
                 disk_manager_->read_log(log, (int)log_rec.log_tot_len_, offset);
                 CreateIndexLogRecord rec;
@@ -0,0 +1,97 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "clock_replacer.h"
+
+#include <algorithm>
+
+ClockReplacer::ClockReplacer(size_t num_pages, frame_id_t first_frame_id)
+    : frames_(std::make_unique<ClockFrame[]>(num_pages)), first_frame_id_(first_frame_id), max_size_(num_pages),
+      num_frames_(num_pages) {}
+
+ClockReplacer::~ClockReplacer() = default;
+
+/**
+ * @description: 使用CLOCK策略删除一个victim frame，并返回该frame的id
+ * @param {frame_id_t*} frame_id 被移除的frame的id，如果没有frame被移除返回nullptr
+ * @return {bool} 如果成功淘汰了一个页面则返回true，否则返回false
+ */
+bool ClockReplacer::victim(frame_id_t *frame_id) {
+    std::lock_guard<std::mutex> lock{latch_};
+    if (size_.load() == 0) return false;
+
+    // 指针最多转两圈：第一圈清除访问位，第二圈一定能找到可淘汰的帧（除非期间被并发pin）
+    for (size_t step = 0; step < 2 * num_frames_; step++) {
+        auto &frame = frames_[hand_];
+        size_t pos = hand_;
+        hand_ = (hand_ + 1) % num_frames_;
+        if (!frame.evictable_.load()) continue;
+        if (frame.referenced_.exchange(false)) continue;
+        // 与并发的pin竞争，只有成功将evictable_由true改为false的一方获得该帧
+        if (frame.evictable_.exchange(false)) {
+            size_--;
+            *frame_id = first_frame_id_ + static_cast<frame_id_t>(pos);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @description: 固定指定的frame，即该页面无法被淘汰
+ * @param {frame_id_t} 需要固定的frame的id
+ */
+void ClockReplacer::pin(frame_id_t frame_id) {
+    auto &frame = frames_[frame_id - first_frame_id_];
+    frame.referenced_.store(true);
+    if (frame.evictable_.exchange(false)) size_--;
+}
+
+/**
+ * @description: 取消固定一个frame，代表该页面可以被淘汰
+ * @param {frame_id_t} frame_id 取消固定的frame的id
+ */
+void ClockReplacer::unpin(frame_id_t frame_id) {
+    auto &frame = frames_[frame_id - first_frame_id_];
+    frame.referenced_.store(true);
+    if (!frame.evictable_.exchange(true)) size_++;
+}
+
+/**
+ * @description: 从时钟指针处开始，列出访问位为0的可淘汰帧，即指针下一圈会淘汰的帧，不将其移出replacer
+ * @param {size_t} max_num 最多列出的帧个数
+ * @return {vector<frame_id_t>} 第一个为下一次victim最可能返回的帧
+ */
+std::vector<frame_id_t> ClockReplacer::next_victims(size_t max_num) {
+    std::lock_guard<std::mutex> lock{latch_};
+    std::vector<frame_id_t> frame_ids;
+    for (size_t step = 0; step < num_frames_ && frame_ids.size() < max_num; step++) {
+        size_t pos = (hand_ + step) % num_frames_;
+        if (frames_[pos].evictable_.load() && !frames_[pos].referenced_.load()) {
+            frame_ids.push_back(first_frame_id_ + static_cast<frame_id_t>(pos));
+        }
+    }
+    return frame_ids;
+}
+
+/**
+ * @description: 缓冲池分区调整大小后，限制时钟指针转动的范围
+ * @param {size_t} num_pages 分区当前的帧数，不超过构造时的num_pages
+ */
+void ClockReplacer::resize(size_t num_pages) {
+    std::lock_guard<std::mutex> lock{latch_};
+    num_frames_ = std::max<size_t>(1, std::min(num_pages, max_size_));
+    if (hand_ >= num_frames_) hand_ = 0;
+}
+
+/**
+ * @description: 获取当前replacer中可以被淘汰的页面数量
+ */
+size_t ClockReplacer::Size() { return size_.load(); }
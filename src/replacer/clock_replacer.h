@@ -0,0 +1,62 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+#include "common/config.h"
+#include "replacer/replacer.h"
+
+/*
+ClockReplacer实现了CLOCK替换策略：每个帧有一个访问位，时钟指针循环扫描，
+遇到访问位为1的帧则将其清零并跳过，遇到访问位为0的可淘汰帧则将其淘汰。
+pin和unpin只修改帧上的原子变量，不需要加锁；只有移动时钟指针的victim需要加锁。
+*/
+class ClockReplacer : public Replacer {
+   public:
+    /**
+     * @description: 创建一个新的ClockReplacer
+     * @param {size_t} num_pages ClockReplacer最多需要存储的page数量
+     * @param {frame_id_t} first_frame_id 管理的帧编号范围为[first_frame_id, first_frame_id + num_pages)
+     * 缓冲池调整大小后，时钟指针只在前resize()个帧中转动
+     */
+    explicit ClockReplacer(size_t num_pages, frame_id_t first_frame_id = 0);
+
+    ~ClockReplacer() override;
+
+    bool victim(frame_id_t *frame_id) override;
+
+    void pin(frame_id_t frame_id) override;
+
+    void unpin(frame_id_t frame_id) override;
+
+    std::vector<frame_id_t> next_victims(size_t max_num) override;
+
+    void resize(size_t num_pages) override;
+
+    size_t Size() override;
+
+   private:
+    struct ClockFrame {
+        std::atomic<bool> evictable_{false};    // 是否可以被淘汰
+        std::atomic<bool> referenced_{false};   // 访问位
+    };
+
+    std::mutex latch_;                          // 保护时钟指针
+    std::unique_ptr<ClockFrame[]> frames_;      // 下标为frame_id - first_frame_id_
+    std::atomic<size_t> size_{0};               // 可淘汰帧的个数
+    size_t hand_ = 0;                           // 时钟指针
+    frame_id_t first_frame_id_;                 // 管理的第一个帧编号
+    size_t max_size_;                           // 最大容量（与缓冲池分区的容量相同）
+    size_t num_frames_;                         // 时钟指针转动的范围，即分区当前的帧数
+};
@@ -0,0 +1,124 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "lru_k_replacer.h"
+
+LRUKReplacer::LRUKReplacer(size_t num_pages, size_t k) : k_(k), max_size_(num_pages) {}
+
+LRUKReplacer::~LRUKReplacer() = default;
+
+/**
+ * @description: 记录一次对指定帧的访问。与上一次访问是同一个帧时视为同一次相关访问，只刷新其时间戳，
+ *               避免顺序扫描对同一页面的连续多次访问使其被当作热点页面
+ * @param {frame_id_t} frame_id 被访问的帧
+ * @param {FrameHistory&} history 该帧的访问历史
+ */
+void LRUKReplacer::record_access(frame_id_t frame_id, FrameHistory &history) {
+    if (frame_id == last_accessed_frame_ && !history.accesses_.empty()) {
+        history.accesses_.back() = current_timestamp_++;
+        return;
+    }
+    history.accesses_.push_back(current_timestamp_++);
+    if (history.accesses_.size() > k_) {
+        history.accesses_.pop_front();
+    }
+    last_accessed_frame_ = frame_id;
+}
+
+/**
+ * @description: 使用LRU-K策略删除一个victim frame，并返回该frame的id
+ * @param {frame_id_t*} frame_id 被移除的frame的id，如果没有frame被移除返回nullptr
+ * @return {bool} 如果成功淘汰了一个页面则返回true，否则返回false
+ */
+bool LRUKReplacer::victim(frame_id_t *frame_id) {
+    std::lock_guard<std::mutex> lock{latch_};
+
+    // 优先淘汰后向K距离为无穷大（访问不足K次）的帧
+    auto &candidates = history_set_.empty() ? cache_set_ : history_set_;
+    if (candidates.empty()) return false;
+
+    *frame_id = candidates.begin()->second;
+    candidates.erase(candidates.begin());
+    // 帧即将用于存放新的页面，丢弃旧页面的访问历史
+    frames_.erase(*frame_id);
+    if (last_accessed_frame_ == *frame_id) last_accessed_frame_ = INVALID_FRAME_ID;
+    return true;
+}
+
+/**
+ * @description: 固定指定的frame，即该页面无法被淘汰，并记录一次对该frame的访问
+ * @param {frame_id_t} 需要固定的frame的id
+ */
+void LRUKReplacer::pin(frame_id_t frame_id) {
+    std::lock_guard<std::mutex> lock{latch_};
+    auto &history = frames_[frame_id];
+    if (history.evictable_) {
+        auto key = order_key(frame_id, history);
+        (history.accesses_.size() < k_ ? history_set_ : cache_set_).erase(key);
+        history.evictable_ = false;
+    }
+    record_access(frame_id, history);
+}
+
+/**
+ * @description: 取消固定一个frame，代表该页面可以被淘汰
+ * @param {frame_id_t} frame_id 取消固定的frame的id
+ */
+void LRUKReplacer::unpin(frame_id_t frame_id) {
+    std::lock_guard<std::mutex> lock{latch_};
+    auto &history = frames_[frame_id];
+    if (history.evictable_) return;
+    // 未经pin直接加入的帧，视为在此刻被访问了一次
+    if (history.accesses_.empty()) record_access(frame_id, history);
+
+    history.evictable_ = true;
+    auto key = order_key(frame_id, history);
+    (history.accesses_.size() < k_ ? history_set_ : cache_set_).insert(key);
+}
+
+/**
+ * @description: 将frame从replacer中移除，并丢弃其访问历史
+ * @param {frame_id_t} frame_id 需要移除的frame的id
+ */
+void LRUKReplacer::remove(frame_id_t frame_id) {
+    std::lock_guard<std::mutex> lock{latch_};
+    auto it = frames_.find(frame_id);
+    if (it == frames_.end()) return;
+    if (it->second.evictable_) {
+        auto key = order_key(frame_id, it->second);
+        (it->second.accesses_.size() < k_ ? history_set_ : cache_set_).erase(key);
+    }
+    frames_.erase(it);
+    if (last_accessed_frame_ == frame_id) last_accessed_frame_ = INVALID_FRAME_ID;
+}
+
+/**
+ * @description: 按淘汰顺序列出接下来将被淘汰的帧，不将其移出replacer
+ * @param {size_t} max_num 最多列出的帧个数
+ * @return {vector<frame_id_t>} 第一个为下一次victim将返回的帧
+ */
+std::vector<frame_id_t> LRUKReplacer::next_victims(size_t max_num) {
+    std::lock_guard<std::mutex> lock{latch_};
+    std::vector<frame_id_t> frame_ids;
+    for (auto set : {&history_set_, &cache_set_}) {
+        for (auto it = set->begin(); it != set->end() && frame_ids.size() < max_num; ++it) {
+            frame_ids.push_back(it->second);
+        }
+    }
+    return frame_ids;
+}
+
+/**
+ * @description: 获取当前replacer中可以被淘汰的页面数量
+ */
+size_t LRUKReplacer::Size() {
+    std::lock_guard<std::mutex> lock{latch_};
+    return history_set_.size() + cache_set_.size();
+}
@@ -0,0 +1,72 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <list>
+#include <mutex>
+#include <set>
+#include <unordered_map>
+#include <utility>
+
+#include "common/config.h"
+#include "replacer/replacer.h"
+
+/*
+LRUKReplacer实现了LRU-K替换策略：淘汰后向第K次访问距离最大的帧。
+访问次数不足K次的帧的后向K距离视为无穷大，优先被淘汰，它们之间按最早一次访问的时间先后淘汰。
+顺序扫描只会访问每个页面一次，因此扫描页面会先于被反复访问的热点页面被淘汰。
+*/
+class LRUKReplacer : public Replacer {
+   public:
+    /**
+     * @description: 创建一个新的LRUKReplacer
+     * @param {size_t} num_pages LRUKReplacer最多需要存储的page数量
+     * @param {size_t} k 计算后向K距离时使用的访问次数
+     */
+    explicit LRUKReplacer(size_t num_pages, size_t k = LRUK_REPLACER_K);
+
+    ~LRUKReplacer() override;
+
+    bool victim(frame_id_t *frame_id) override;
+
+    void pin(frame_id_t frame_id) override;
+
+    void unpin(frame_id_t frame_id) override;
+
+    void remove(frame_id_t frame_id) override;
+
+    std::vector<frame_id_t> next_victims(size_t max_num) override;
+
+    size_t Size() override;
+
+   private:
+    struct FrameHistory {
+        std::list<size_t> accesses_;    // 最近K次访问的时间戳，首部为最早的一次
+        bool evictable_ = false;        // 是否在可淘汰集合中
+    };
+
+    // 帧在可淘汰集合中的排序键：访问不足K次时为最早一次访问时间，否则为倒数第K次访问时间，
+    // 由于accesses_最多保存K个时间戳，两者都是accesses_的首元素
+    std::pair<size_t, frame_id_t> order_key(frame_id_t frame_id, const FrameHistory &history) const {
+        return {history.accesses_.front(), frame_id};
+    }
+
+    void record_access(frame_id_t frame_id, FrameHistory &history);
+
+    std::mutex latch_;                                      // 互斥锁
+    std::unordered_map<frame_id_t, FrameHistory> frames_;   // frame_id_t -> 访问历史
+    std::set<std::pair<size_t, frame_id_t>> history_set_;  // 访问不足K次的可淘汰帧
+    std::set<std::pair<size_t, frame_id_t>> cache_set_;    // 访问达到K次的可淘汰帧
+    size_t current_timestamp_ = 0;                          // 逻辑时钟，每次访问加1
+    frame_id_t last_accessed_frame_ = INVALID_FRAME_ID;     // 上一次被访问的帧
+    size_t k_;                                              // LRU-K中的K
+    size_t max_size_;                                       // 最大容量（与缓冲池分区的容量相同）
+};
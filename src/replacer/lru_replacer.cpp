@@ -67,6 +67,20 @@ void LRUReplacer::unpin(frame_id_t frame_id) {
     LRUhash_[frame_id] = LRUlist_.begin();
 }
 
+/**
+ * @description: 按淘汰顺序列出接下来将被淘汰的帧，不将其移出replacer
+ * @param {size_t} max_num 最多列出的帧个数
+ * @return {vector<frame_id_t>} 第一个为下一次victim将返回的帧
+ */
+std::vector<frame_id_t> LRUReplacer::next_victims(size_t max_num) {
+    std::lock_guard<std::mutex> lock{latch_};
+    std::vector<frame_id_t> frame_ids;
+    for (auto it = LRUlist_.rbegin(); it != LRUlist_.rend() && frame_ids.size() < max_num; ++it) {
+        frame_ids.push_back(*it);
+    }
+    return frame_ids;
+}
+
 /**
  * @description: 获取当前replacer中可以被淘汰的页面数量
  */
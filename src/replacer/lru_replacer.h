@@ -37,6 +37,8 @@ class LRUReplacer : public Replacer {
 
     void unpin(frame_id_t frame_id);
 
+    std::vector<frame_id_t> next_victims(size_t max_num);
+
     size_t Size();
 
    private:
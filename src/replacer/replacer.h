@@ -10,6 +10,8 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include <vector>
+
 #include "common/config.h"
 
 /**
@@ -39,6 +41,28 @@ class Replacer {
      */
     virtual void unpin(frame_id_t frame_id) = 0;
 
+    /**
+     * Removes a frame from the replacer together with any access history kept for it,
+     * e.g. when the frame is returned to the free list.
+     * @param frame_id the id of the frame to remove
+     */
+    virtual void remove(frame_id_t frame_id) { pin(frame_id); }
+
+    /**
+     * Lists the frames that would be victimized next, in eviction order, without removing them.
+     * Used by the background flusher to clean frames before they are evicted.
+     * @param max_num the maximum number of frames to return
+     * @return up to max_num frame ids, the first one is the next victim
+     */
+    virtual std::vector<frame_id_t> next_victims(size_t /*max_num*/) { return {}; }
+
+    /**
+     * Called when the buffer pool partition owning this replacer grows or shrinks.
+     * Frames leaving the partition have been removed from the replacer beforehand.
+     * @param num_pages the number of frames the partition now has
+     */
+    virtual void resize(size_t /*num_pages*/) {}
+
     /** @return the number of elements in the replacer that can be victimized */
     virtual size_t Size() = 0;
 };
@@ -15,6 +15,8 @@ See the Mulan PSL v2 for more details. */
 #include <signal.h>
 #include <unistd.h>
 #include <atomic>
+#include <fstream>
+#include <getopt.h>
 
 #include "errors.h"
 #include "optimizer/optimizer.h"
@@ -29,27 +31,93 @@ See the Mulan PSL v2 for more details. */
 
 static bool should_exit = false;
 
-// 构建全局所需的管理器对象
-auto disk_manager = std::make_unique<DiskManager>();
-auto buffer_pool_manager = std::make_unique<BufferPoolManager>(BUFFER_POOL_SIZE, disk_manager.get());
-auto rm_manager = std::make_unique<RmManager>(disk_manager.get(), buffer_pool_manager.get());
-auto ix_manager = std::make_unique<IxManager>(disk_manager.get(), buffer_pool_manager.get());
-auto sm_manager = std::make_unique<SmManager>(disk_manager.get(), buffer_pool_manager.get(), rm_manager.get(),
-                                              ix_manager.get());
-auto lock_manager = std::make_unique<LockManager>();
-auto txn_manager = std::make_unique<TransactionManager>(lock_manager.get(), sm_manager.get(), buffer_pool_manager.get());
-auto ql_manager = std::make_unique<QlManager>(sm_manager.get(), txn_manager.get());
-auto log_manager = std::make_unique<LogManager>(disk_manager.get());
-auto recovery = std::make_unique<RecoveryManager>(disk_manager.get(), buffer_pool_manager.get(), sm_manager.get());
-auto planner = std::make_unique<Planner>(sm_manager.get());
-auto optimizer = std::make_unique<Optimizer>(sm_manager.get(), planner.get());
-auto portal = std::make_unique<Portal>(sm_manager.get());
-auto analyze = std::make_unique<Analyze>(sm_manager.get());
+// 全局所需的管理器对象，缓冲池的大小在启动时才能确定，因此在main中由init_managers构建
+std::unique_ptr<DiskManager> disk_manager;
+std::unique_ptr<BufferPoolManager> buffer_pool_manager;
+std::unique_ptr<RmManager> rm_manager;
+std::unique_ptr<IxManager> ix_manager;
+std::unique_ptr<SmManager> sm_manager;
+std::unique_ptr<LockManager> lock_manager;
+std::unique_ptr<TransactionManager> txn_manager;
+std::unique_ptr<QlManager> ql_manager;
+std::unique_ptr<LogManager> log_manager;
+std::unique_ptr<RecoveryManager> recovery;
+std::unique_ptr<Planner> planner;
+std::unique_ptr<Optimizer> optimizer;
+std::unique_ptr<Portal> portal;
+std::unique_ptr<Analyze> analyze;
 pthread_mutex_t *buffer_mutex;
 pthread_mutex_t *sockfd_mutex;
 
 static jmp_buf jmpbuf;
 
+/**
+ * @description: 构建全局所需的管理器对象
+ * @param {size_t} pool_size 缓冲池的帧数
+ * @param {size_t} max_pool_size 运行时通过SET buffer_pool_size可以调整到的最大帧数
+ * @param {string&} huge_pages 缓冲池数据区使用的内存页类型
+ */
+static void init_managers(size_t pool_size, size_t max_pool_size, const std::string &huge_pages) {
+    disk_manager = std::make_unique<DiskManager>();
+    buffer_pool_manager = std::make_unique<BufferPoolManager>(pool_size, disk_manager.get(), BUFFER_POOL_PARTITIONS,
+                                                              REPLACER_TYPE, max_pool_size, huge_pages);
+    rm_manager = std::make_unique<RmManager>(disk_manager.get(), buffer_pool_manager.get());
+    ix_manager = std::make_unique<IxManager>(disk_manager.get(), buffer_pool_manager.get());
+    sm_manager = std::make_unique<SmManager>(disk_manager.get(), buffer_pool_manager.get(), rm_manager.get(),
+                                             ix_manager.get());
+    lock_manager = std::make_unique<LockManager>();
+    txn_manager = std::make_unique<TransactionManager>(lock_manager.get(), sm_manager.get(), buffer_pool_manager.get());
+    ql_manager = std::make_unique<QlManager>(sm_manager.get(), txn_manager.get());
+    log_manager = std::make_unique<LogManager>(disk_manager.get());
+    recovery = std::make_unique<RecoveryManager>(disk_manager.get(), buffer_pool_manager.get(), sm_manager.get());
+    planner = std::make_unique<Planner>(sm_manager.get());
+    optimizer = std::make_unique<Optimizer>(sm_manager.get(), planner.get());
+    portal = std::make_unique<Portal>(sm_manager.get());
+    analyze = std::make_unique<Analyze>(sm_manager.get());
+}
+
+/**
+ * @description: 读取配置文件，每行为"name = value"，#之后的内容为注释
+ * @return {unordered_map<string, string>} 配置项名称到值的映射
+ * @param {string&} path 配置文件路径
+ */
+static std::unordered_map<std::string, std::string> read_config(const std::string &path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        throw FileNotFoundError(path);
+    }
+    auto trim = [](const std::string &s) {
+        auto begin = s.find_first_not_of(" \t\r");
+        auto end = s.find_last_not_of(" \t\r");
+        return begin == std::string::npos ? std::string() : s.substr(begin, end - begin + 1);
+    };
+    std::unordered_map<std::string, std::string> config;
+    std::string line;
+    while (std::getline(file, line)) {
+        line = trim(line.substr(0, line.find('#')));
+        if (line.empty()) continue;
+        auto pos = line.find('=');
+        if (pos == std::string::npos) {
+            throw InternalError("invalid config line: " + line);
+        }
+        config[trim(line.substr(0, pos))] = trim(line.substr(pos + 1));
+    }
+    return config;
+}
+
+/**
+ * @description: 解析非负整数形式的配置值
+ * @return {size_t} 配置值
+ * @param {string&} name 配置项名称，用于错误信息
+ * @param {string&} value 配置值
+ */
+static size_t parse_count(const std::string &name, const std::string &value) {
+    if (value.empty() || value.size() > 18 || value.find_first_not_of("0123456789") != std::string::npos) {
+        throw InternalError("invalid " + name + ": " + value);
+    }
+    return std::stoull(value);
+}
+
 void sigint_handler(int signo) {
     should_exit = true;
     log_manager->flush_log_to_disk();
@@ -260,15 +328,87 @@ void start_server() {
     int ret = shutdown(sockfd_server, SHUT_WR);  // shut down the all or part of a full-duplex connection.
     if (ret == -1) { printf("%s\n", strerror(errno)); }
 //    assert(ret != -1);
+    buffer_pool_manager->stop_flusher();
     sm_manager->close_db();
     std::cout << " DB has been closed.\n";
     std::cout << "Server shuts down." << std::endl;
 }
 
 int main(int argc, char **argv) {
-    if (argc != 2) {
+    // 缓冲池大小依次取默认值、配置文件和命令行参数中的值，可以是帧数或带K、M、G单位的字节数
+    // 组提交的等待时间（微秒）和批大小同样可以在配置文件和命令行中设置
+    std::string config_path, pool_size_arg, max_pool_size_arg, huge_pages_arg, direct_io_arg;
+    std::string log_timeout_arg, batch_size_arg;
+    static const struct option long_options[] = {{"config", required_argument, nullptr, 'c'},
+                                                 {"buffer-pool-size", required_argument, nullptr, 'b'},
+                                                 {"buffer-pool-max-size", required_argument, nullptr, 'm'},
+                                                 {"huge-pages", required_argument, nullptr, 'H'},
+                                                 {"direct-io", no_argument, nullptr, 'd'},
+                                                 {"log-timeout", required_argument, nullptr, 't'},
+                                                 {"group-commit-batch-size", required_argument, nullptr, 'g'},
+                                                 {nullptr, 0, nullptr, 0}};
+    int opt;
+    while ((opt = getopt_long(argc, argv, "c:b:m:H:dt:g:", long_options, nullptr)) != -1) {
+        switch (opt) {
+            case 'c': config_path = optarg; break;
+            case 'b': pool_size_arg = optarg; break;
+            case 'm': max_pool_size_arg = optarg; break;
+            case 'H': huge_pages_arg = optarg; break;
+            case 'd': direct_io_arg = "on"; break;
+            case 't': log_timeout_arg = optarg; break;
+            case 'g': batch_size_arg = optarg; break;
+            default: optind = argc + 1; break;
+        }
+    }
+    if (optind != argc - 1) {
         // 需要指定数据库名称
-        std::cerr << "Usage: " << argv[0] << " <database>" << std::endl;
+        std::cerr << "Usage: " << argv[0]
+                  << " [-c config_file] [-b buffer_pool_size] [-m buffer_pool_max_size] [-H none|thp|hugetlb] [-d]"
+                     " [-t log_timeout_us] [-g group_commit_batch_size] <database>" << std::endl;
+        exit(1);
+    }
+
+    size_t pool_size = BUFFER_POOL_SIZE;
+    size_t max_pool_size = BUFFER_POOL_MAX_SIZE;
+    try {
+        if (!config_path.empty()) {
+            // 命令行参数优先于配置文件
+            for (auto &[name, value] : read_config(config_path)) {
+                if (name == "buffer_pool_size") {
+                    if (pool_size_arg.empty()) pool_size_arg = value;
+                } else if (name == "buffer_pool_max_size") {
+                    if (max_pool_size_arg.empty()) max_pool_size_arg = value;
+                } else if (name == "buffer_pool_huge_pages") {
+                    if (huge_pages_arg.empty()) huge_pages_arg = value;
+                } else if (name == "direct_io") {
+                    if (direct_io_arg.empty()) direct_io_arg = value;
+                } else if (name == "log_timeout") {
+                    if (log_timeout_arg.empty()) log_timeout_arg = value;
+                } else if (name == "group_commit_batch_size") {
+                    if (batch_size_arg.empty()) batch_size_arg = value;
+                } else {
+                    throw InternalError("unknown config: " + name);
+                }
+            }
+        }
+        if (!pool_size_arg.empty()) pool_size = BufferPoolManager::parse_pool_size(pool_size_arg);
+        if (!max_pool_size_arg.empty()) max_pool_size = BufferPoolManager::parse_pool_size(max_pool_size_arg);
+        if (pool_size == 0) throw InternalError("buffer pool size must be positive");
+        if (!direct_io_arg.empty() && direct_io_arg != "on" && direct_io_arg != "off") {
+            throw InternalError("invalid direct_io: " + direct_io_arg);
+        }
+        // 刷日志线程随LogManager启动，需要在创建之前设置
+        if (!log_timeout_arg.empty()) {
+            log_timeout = std::chrono::microseconds(parse_count("log_timeout", log_timeout_arg));
+        }
+        if (!batch_size_arg.empty()) {
+            group_commit_batch_size = parse_count("group_commit_batch_size", batch_size_arg);
+            if (group_commit_batch_size == 0) throw InternalError("group commit batch size must be positive");
+        }
+        init_managers(pool_size, max_pool_size, huge_pages_arg.empty() ? BUFFER_POOL_HUGE_PAGES : huge_pages_arg);
+        if (!direct_io_arg.empty()) disk_manager->set_direct_io(direct_io_arg == "on");
+    } catch (RMDBError &e) {
+        std::cerr << e.what() << std::endl;
         exit(1);
     }
 
@@ -285,8 +425,19 @@ int main(int argc, char **argv) {
                      "Welcome to RMDB!\n"
                      "Type 'help;' for help.\n"
                      "\n";
+        // 启用异步I/O引擎，供缓冲池批量读取和预读使用
+        disk_manager->enable_async_io();
+        std::cout << "Async I/O engine: " << disk_manager->get_async_io_engine() << std::endl;
+
+        std::cout << "Buffer pool: " << buffer_pool_manager->get_pool_size() << " pages, up to "
+                  << buffer_pool_manager->get_max_pool_size() << " pages, huge pages: "
+                  << buffer_pool_manager->get_huge_pages() << std::endl;
+        std::cout << "Direct I/O: " << (disk_manager->is_direct_io() ? "on" : "off") << std::endl;
+        std::cout << "Group commit: timeout " << log_timeout.count() << " us, batch size " << group_commit_batch_size
+                  << std::endl;
+
         // Database name is passed by args
-        std::string db_name = argv[1];
+        std::string db_name = argv[optind];
         if (!sm_manager->is_dir(db_name)) {
             // Database not found, create a new one
             sm_manager->create_db(db_name);
@@ -299,6 +450,12 @@ int main(int argc, char **argv) {
         recovery->redo();
         recovery->undo();
 
+        // 启动后台刷脏线程，查询线程淘汰页面时尽量只需使用干净的帧
+        buffer_pool_manager->set_log_manager(log_manager.get());
+        buffer_pool_manager->start_flusher();
+        // 按上次关闭时保存的快照在后台预热缓冲池
+        sm_manager->start_warmup();
+
         // 开启服务端，开始接受客户端连接
         start_server();
     } catch (RMDBError &e) {
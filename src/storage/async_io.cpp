@@ -0,0 +1,271 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "storage/async_io.h"
+
+#include <linux/io_uring.h>
+#include <string.h>    // for memset
+#include <sys/mman.h>  // for mmap
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+
+#include "errors.h"
+#include "storage/disk_manager.h"
+
+static int io_uring_setup(unsigned entries, struct io_uring_params *params) {
+    return (int)syscall(__NR_io_uring_setup, entries, params);
+}
+
+static int io_uring_enter(int ring_fd, unsigned to_submit, unsigned min_complete, unsigned flags) {
+    return (int)syscall(__NR_io_uring_enter, ring_fd, to_submit, min_complete, flags, nullptr, 0);
+}
+
+IoUringEngine::IoUringEngine(size_t queue_depth) {
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    ring_fd_ = io_uring_setup(static_cast<unsigned>(queue_depth), &params);
+    if (ring_fd_ < 0) {
+        throw UnixError();
+    }
+    sq_entries_ = params.sq_entries;
+
+    // 映射SQ环、CQ环和SQE数组；支持IORING_FEAT_SINGLE_MMAP的内核中SQ环和CQ环共用一次映射
+    sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (single_mmap) {
+        sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+    }
+    sq_ring_ = mmap(nullptr, sq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_,
+                    IORING_OFF_SQ_RING);
+    cq_ring_ = single_mmap ? sq_ring_
+                           : mmap(nullptr, cq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_,
+                                  IORING_OFF_CQ_RING);
+    void *sqes = mmap(nullptr, params.sq_entries * sizeof(struct io_uring_sqe), PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQES);
+    if (sq_ring_ == MAP_FAILED || cq_ring_ == MAP_FAILED || sqes == MAP_FAILED) {
+        int err = errno;
+        if (sq_ring_ != MAP_FAILED) munmap(sq_ring_, sq_ring_size_);
+        if (!single_mmap && cq_ring_ != MAP_FAILED) munmap(cq_ring_, cq_ring_size_);
+        if (sqes != MAP_FAILED) munmap(sqes, params.sq_entries * sizeof(struct io_uring_sqe));
+        close(ring_fd_);
+        errno = err;
+        throw UnixError();
+    }
+    sqes_ = static_cast<struct io_uring_sqe *>(sqes);
+
+    auto sq = static_cast<char *>(sq_ring_);
+    sq_tail_ = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+    sq_mask_ = reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+    sq_array_ = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+    auto cq = static_cast<char *>(cq_ring_);
+    cq_head_ = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+    cq_tail_ = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+    cq_mask_ = reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+    cqes_ = reinterpret_cast<struct io_uring_cqe *>(cq + params.cq_off.cqes);
+
+    reaper_ = std::thread(&IoUringEngine::reap, this);
+}
+
+IoUringEngine::~IoUringEngine() {
+    {
+        // 等待所有在途请求完成，再提交一个NOP请求通知后台线程退出
+        std::unique_lock<std::mutex> lock{latch_};
+        cv_.wait(lock, [this] { return in_flight_ == 0; });
+        // 环出错时后台线程已经退出
+        if (!failed_) {
+            push_sqe(nullptr, true);
+            enter(1);
+        }
+    }
+    reaper_.join();
+    munmap(sqes_, sq_entries_ * sizeof(struct io_uring_sqe));
+    if (cq_ring_ != sq_ring_) munmap(cq_ring_, cq_ring_size_);
+    munmap(sq_ring_, sq_ring_size_);
+    close(ring_fd_);
+}
+
+/**
+ * @description: 向SQ中写入一个请求，调用者需持有latch_并保证SQ中有空位
+ * @param {Pending*} pending 请求，完成时其地址作为user_data返回
+ * @param {bool} is_nop 为true时提交一个NOP请求，用于唤醒后台线程
+ */
+void IoUringEngine::push_sqe(Pending *pending, bool is_nop) {
+    unsigned tail = *sq_tail_;
+    unsigned index = tail & *sq_mask_;
+    auto sqe = &sqes_[index];
+    memset(sqe, 0, sizeof(*sqe));
+    if (is_nop) {
+        sqe->opcode = IORING_OP_NOP;
+        sqe->user_data = 0;
+    } else {
+        // 使用READV/WRITEV而不是READ/WRITE，兼容更早的内核版本
+        sqe->opcode = pending->request.is_write ? IORING_OP_WRITEV : IORING_OP_READV;
+        sqe->fd = pending->request.fd;
+        sqe->addr = reinterpret_cast<unsigned long long>(&pending->iov);
+        sqe->len = 1;
+        sqe->off = 1ull * pending->request.page_no * PAGE_SIZE;
+        sqe->user_data = reinterpret_cast<unsigned long long>(pending);
+    }
+    sq_array_[index] = index;
+    __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * @description: 将SQ中的to_submit个请求提交给内核，调用者需持有latch_
+ */
+void IoUringEngine::enter(unsigned to_submit) {
+    while (to_submit > 0) {
+        int ret = io_uring_enter(ring_fd_, to_submit, 0, 0);
+        if (ret < 0) {
+            if (errno == EINTR || errno == EAGAIN) continue;
+            throw UnixError();
+        }
+        to_submit -= ret;
+    }
+}
+
+/**
+ * @description: 提交一批请求，在途请求达到队列深度时等待已有请求完成；环已出错时在当前线程中以失败调用剩余请求的回调
+ * @param {vector<AsyncIoRequest>&} requests 要提交的请求，提交后被清空
+ */
+void IoUringEngine::submit(std::vector<AsyncIoRequest> &requests) {
+    std::unique_lock<std::mutex> lock{latch_};
+    size_t next = 0;
+    while (next < requests.size()) {
+        cv_.wait(lock, [this] { return failed_ || in_flight_ < sq_entries_; });
+        if (failed_) break;
+        unsigned batch = 0;
+        for (; next < requests.size() && in_flight_ < sq_entries_; next++, batch++, in_flight_++) {
+            auto pending = new Pending{std::move(requests[next]), {}};
+            pending->iov.iov_base = pending->request.buf;
+            pending->iov.iov_len = PAGE_SIZE;
+            pending_.insert(pending);
+            push_sqe(pending, false);
+        }
+        enter(batch);
+    }
+    lock.unlock();
+    for (; next < requests.size(); next++) {
+        requests[next].callback(false);
+    }
+    requests.clear();
+}
+
+/**
+ * @description: 后台线程：等待CQ中的完成事件，执行请求的回调，收到NOP时退出
+ */
+void IoUringEngine::reap() {
+    while (true) {
+        unsigned head = *cq_head_;
+        if (head == __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE)) {
+            if (io_uring_enter(ring_fd_, 0, 1, IORING_ENTER_GETEVENTS) < 0 && errno != EINTR) {
+                // 其他错误重试也不会恢复，不能一直空转
+                fail_in_flight();
+                return;
+            }
+            continue;
+        }
+        auto cqe = &cqes_[head & *cq_mask_];
+        auto pending = reinterpret_cast<Pending *>(cqe->user_data);
+        int res = cqe->res;
+        __atomic_store_n(cq_head_, head + 1, __ATOMIC_RELEASE);
+        if (pending == nullptr) return;
+
+        {
+            // CQE已被消费，可以腾出一个在途名额；加锁同时保证能看到提交方对pending的写入
+            std::lock_guard<std::mutex> lock{latch_};
+            in_flight_--;
+            pending_.erase(pending);
+            cv_.notify_all();
+        }
+        pending->request.callback(res == PAGE_SIZE);
+        delete pending;
+    }
+}
+
+/**
+ * @description: 环出错后使所有在途请求以失败完成，并让之后的submit直接失败
+ */
+void IoUringEngine::fail_in_flight() {
+    std::unordered_set<Pending *> pending;
+    {
+        std::lock_guard<std::mutex> lock{latch_};
+        failed_ = true;
+        pending.swap(pending_);
+        in_flight_ = 0;
+        cv_.notify_all();
+    }
+    for (auto p : pending) {
+        p->request.callback(false);
+        delete p;
+    }
+}
+
+ThreadPoolIoEngine::ThreadPoolIoEngine(DiskManager *disk_manager, size_t num_threads) : disk_manager_(disk_manager) {
+    for (size_t i = 0; i < num_threads; i++) {
+        workers_.emplace_back(&ThreadPoolIoEngine::work, this);
+    }
+}
+
+ThreadPoolIoEngine::~ThreadPoolIoEngine() {
+    {
+        std::lock_guard<std::mutex> lock{latch_};
+        stop_ = true;
+    }
+    cv_.notify_all();
+    for (auto &worker : workers_) {
+        worker.join();
+    }
+}
+
+/**
+ * @description: 将一批请求放入队列，由工作线程执行
+ * @param {vector<AsyncIoRequest>&} requests 要提交的请求，提交后被清空
+ */
+void ThreadPoolIoEngine::submit(std::vector<AsyncIoRequest> &requests) {
+    {
+        std::lock_guard<std::mutex> lock{latch_};
+        for (auto &request : requests) {
+            queue_.push_back(std::move(request));
+        }
+    }
+    cv_.notify_all();
+    requests.clear();
+}
+
+/**
+ * @description: 工作线程：从队列中取出请求并同步执行，队列为空且需要退出时返回
+ */
+void ThreadPoolIoEngine::work() {
+    while (true) {
+        std::unique_lock<std::mutex> lock{latch_};
+        cv_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+        if (queue_.empty()) return;
+        auto request = std::move(queue_.front());
+        queue_.pop_front();
+        lock.unlock();
+
+        bool ok = true;
+        try {
+            if (request.is_write) {
+                disk_manager_->write_page(request.fd, request.page_no, request.buf, PAGE_SIZE);
+            } else {
+                disk_manager_->read_page(request.fd, request.page_no, request.buf, PAGE_SIZE);
+            }
+        } catch (RMDBError &e) {
+            ok = false;
+        }
+        request.callback(ok);
+    }
+}
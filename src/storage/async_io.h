@@ -0,0 +1,132 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <sys/uio.h>
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include "common/config.h"
+
+class DiskManager;
+
+/**
+ * @description: 一次异步页面读写请求，buf指向PAGE_SIZE大小的缓冲区，在回调被调用之前必须保持有效
+ */
+struct AsyncIoRequest {
+    bool is_write;                          // true为写入磁盘，false为从磁盘读取
+    int fd;                                 // 磁盘文件的文件句柄
+    page_id_t page_no;                      // 读写的页面编号
+    char *buf;                              // 内存缓冲区
+    std::function<void(bool)> callback;     // I/O完成后在引擎的线程中调用，参数表示是否完整读写了一个页面
+};
+
+/*
+AsyncIoEngine是异步I/O引擎的接口：submit一次提交一批请求后立即返回，请求完成时调用各自的回调。
+回调在引擎内部的线程中执行，不能再向同一个引擎提交请求，也不应执行耗时操作。
+*/
+class AsyncIoEngine {
+   public:
+    virtual ~AsyncIoEngine() = default;
+
+    virtual void submit(std::vector<AsyncIoRequest> &requests) = 0;
+
+    virtual const char *name() const = 0;
+};
+
+/*
+IoUringEngine直接通过io_uring_setup/io_uring_enter系统调用使用io_uring，不依赖liburing。
+提交方将请求写入SQ后调用io_uring_enter，由一个后台线程等待CQ中的完成事件并执行回调。
+同时在途的请求数不超过队列深度，队列满时submit阻塞等待。
+等待完成事件的io_uring_enter出错（EINTR除外）时环已不可用：所有在途请求以失败完成，之后提交的请求也在submit中直接失败。
+*/
+class IoUringEngine : public AsyncIoEngine {
+   public:
+    /**
+     * @description: 创建io_uring实例，内核不支持时抛出UnixError
+     * @param {size_t} queue_depth 队列深度
+     */
+    explicit IoUringEngine(size_t queue_depth);
+
+    ~IoUringEngine() override;
+
+    void submit(std::vector<AsyncIoRequest> &requests) override;
+
+    const char *name() const override { return "io_uring"; }
+
+   private:
+    struct Pending {
+        AsyncIoRequest request;
+        struct iovec iov;
+    };
+
+    void push_sqe(Pending *pending, bool is_nop);
+
+    void enter(unsigned to_submit);
+
+    void reap();
+
+    void fail_in_flight();
+
+    int ring_fd_ = -1;
+    unsigned sq_entries_ = 0;
+
+    // mmap得到的SQ、CQ环和SQE数组
+    void *sq_ring_ = nullptr;
+    void *cq_ring_ = nullptr;
+    size_t sq_ring_size_ = 0;
+    size_t cq_ring_size_ = 0;
+    struct io_uring_sqe *sqes_ = nullptr;
+    unsigned *sq_tail_ = nullptr;
+    unsigned *sq_mask_ = nullptr;
+    unsigned *sq_array_ = nullptr;
+    unsigned *cq_head_ = nullptr;
+    unsigned *cq_tail_ = nullptr;
+    unsigned *cq_mask_ = nullptr;
+    struct io_uring_cqe *cqes_ = nullptr;
+
+    std::mutex latch_;                  // 保护SQ、in_flight_、pending_和failed_
+    std::condition_variable cv_;        // 有请求完成时通知
+    size_t in_flight_ = 0;              // 已提交尚未完成的请求数
+    std::unordered_set<Pending *> pending_;  // 已提交尚未完成的请求，环出错时由后台线程使其失败
+    bool failed_ = false;               // 环出错后不再提交新的请求
+    std::thread reaper_;                // 收割完成事件的后台线程
+};
+
+/*
+ThreadPoolIoEngine是不支持io_uring时的后备实现：请求放入队列，由固定数量的工作线程调用DiskManager完成读写。
+*/
+class ThreadPoolIoEngine : public AsyncIoEngine {
+   public:
+    ThreadPoolIoEngine(DiskManager *disk_manager, size_t num_threads);
+
+    ~ThreadPoolIoEngine() override;
+
+    void submit(std::vector<AsyncIoRequest> &requests) override;
+
+    const char *name() const override { return "thread_pool"; }
+
+   private:
+    void work();
+
+    DiskManager *disk_manager_;
+    std::mutex latch_;                      // 保护queue_和stop_
+    std::condition_variable cv_;            // 有新请求或需要退出时通知
+    std::deque<AsyncIoRequest> queue_;      // 等待执行的请求
+    bool stop_ = false;
+    std::vector<std::thread> workers_;
+};
@@ -9,48 +9,443 @@ MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
 See the Mulan PSL v2 for more details. */
 
 #include "buffer_pool_manager.h"
+
+#include <sys/mman.h>  // for mmap, madvise
+
 #include "cstdio"
+#include "recovery/log_manager.h"
+
+/**
+ * @description: 创建缓冲池。帧描述符数组和数据区都按max_pool_size一次性预留虚拟地址空间，只有使用中的帧占用物理内存，
+ *               第i个分区的帧编号从i * partition_capacity_开始连续分配，调整缓冲池大小时已有的帧不会移动
+ * @param {size_t} pool_size 初始的帧数
+ * @param {DiskManager*} disk_manager 磁盘管理器
+ * @param {size_t} num_partitions 分区数
+ * @param {string&} replacer_type 置换策略，可以为"LRU"、"LRU-K"或"CLOCK"
+ * @param {size_t} max_pool_size 运行时可以调整到的最大帧数，小于pool_size时取pool_size
+ * @param {string&} huge_pages 数据区使用的内存页类型，可以为"none"、"thp"或"hugetlb"
+ */
+BufferPoolManager::BufferPoolManager(size_t pool_size, DiskManager *disk_manager, size_t num_partitions,
+                                     const std::string &replacer_type, size_t max_pool_size,
+                                     const std::string &huge_pages)
+    : pool_size_(pool_size), disk_manager_(disk_manager) {
+    // 分区数不能超过帧数，否则会出现没有帧的分区
+    num_partitions_ = std::max<size_t>(1, std::min(num_partitions, pool_size));
+    max_pool_size_ = std::max(pool_size, max_pool_size);
+    partition_capacity_ = (max_pool_size_ + num_partitions_ - 1) / num_partitions_;
+    reserved_bytes_ = num_partitions_ * partition_capacity_ * sizeof(Page);
+    void *mem = mmap(nullptr, reserved_bytes_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE,
+                     -1, 0);
+    if (mem == MAP_FAILED) {
+        throw UnixError();
+    }
+    pages_ = static_cast<Page *>(mem);
+    try {
+        map_data_arena(huge_pages);
+    } catch (RMDBError &) {
+        munmap(pages_, reserved_bytes_);
+        throw;
+    }
+    for (size_t i = 0; i < num_partitions_; ++i) {
+        auto partition = std::make_unique<BufferPoolPartition>();
+        partition->first_frame_id_ = static_cast<frame_id_t>(i * partition_capacity_);
+        // 可以被Replacer改变
+        if (replacer_type == "LRU")
+            partition->replacer_ = new LRUReplacer(partition_capacity_);
+        else if (replacer_type == "LRU-K")
+            partition->replacer_ = new LRUKReplacer(partition_capacity_);
+        else if (replacer_type == "CLOCK")
+            partition->replacer_ = new ClockReplacer(partition_capacity_, partition->first_frame_id_);
+        else {
+            munmap(pages_, reserved_bytes_);
+            munmap(data_arena_, arena_bytes_);
+            throw InternalError("unknown replacer type: " + replacer_type);
+        }
+        partitions_.push_back(std::move(partition));
+    }
+    // 初始化时，分区内所有的帧都在free_list_中
+    for (size_t i = 0; i < num_partitions_; ++i) {
+        grow_partition(partitions_[i].get(), (i + 1) * pool_size / num_partitions_ - i * pool_size / num_partitions_);
+    }
+}
+
+BufferPoolManager::~BufferPoolManager() {
+    stop_warmup();
+    stop_flusher();
+    // 异步I/O的回调会访问帧和分区，需等待其全部执行完毕
+    wait_async_io();
+    for (auto &partition : partitions_) {
+        for (size_t i = 0; i < partition->num_frames_; ++i) {
+            pages_[partition->first_frame_id_ + i].~Page();
+        }
+    }
+    munmap(pages_, reserved_bytes_);
+    munmap(data_arena_, arena_bytes_);
+}
+
+/**
+ * @description: 预留数据区的虚拟地址空间。mmap返回的地址按内存页对齐，每帧的数据因此都按PAGE_SIZE对齐。
+ *               "hugetlb"时直接申请大页并预留全部物理内存，系统配置的大页不足时退化为"thp"；
+ *               "thp"时建议内核使用透明大页，减少大缓冲池的TLB缺失
+ * @param {string&} huge_pages 数据区使用的内存页类型
+ */
+void BufferPoolManager::map_data_arena(const std::string &huge_pages) {
+    if (huge_pages != "none" && huge_pages != "thp" && huge_pages != "hugetlb") {
+        throw InternalError("unknown huge pages type: " + huge_pages);
+    }
+    arena_bytes_ = num_partitions_ * partition_capacity_ * PAGE_SIZE;
+    huge_pages_ = huge_pages;
+    if (huge_pages_ == "hugetlb") {
+        arena_bytes_ = (arena_bytes_ + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+        void *mem = mmap(nullptr, arena_bytes_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB,
+                         -1, 0);
+        if (mem != MAP_FAILED) {
+            data_arena_ = static_cast<char *>(mem);
+            return;
+        }
+        huge_pages_ = "thp";
+    }
+    void *mem = mmap(nullptr, arena_bytes_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE,
+                     -1, 0);
+    if (mem == MAP_FAILED) {
+        throw UnixError();
+    }
+    data_arena_ = static_cast<char *>(mem);
+    // 内核未开启透明大页时madvise失败，不影响正确性
+    if (huge_pages_ == "thp" && madvise(data_arena_, arena_bytes_, MADV_HUGEPAGE) != 0) {
+        huge_pages_ = "none";
+    }
+}
 
 /**
  * @description: 从free_list或replacer中得到可淘汰帧页的 *frame_id
  * @return {bool} true: 可替换帧查找成功 , false: 可替换帧查找失败
+ * @param {BufferPoolPartition*} partition 在该分区内查找，调用者需持有分区的latch_
  * @param {frame_id_t*} frame_id 帧页id指针,返回成功找到的可替换帧id
  */
-bool BufferPoolManager::find_victim_page(frame_id_t* frame_id) {
+bool BufferPoolManager::find_victim_page(BufferPoolPartition *partition, frame_id_t* frame_id) {
     // Todo:
     // 1 使用BufferPoolManager::free_list_判断缓冲池是否已满需要淘汰页面
     // 1.1 未满获得frame
     // 1.2 已满使用lru_replacer中的方法选择淘汰页面
-    if (free_list_.empty()) {
-        return replacer_->victim(frame_id);
+    if (partition->free_list_.empty()) {
+        while (partition->replacer_->victim(frame_id)) {
+            // 后台刷脏线程固定帧时不经过replacer，跳过正在被写回的帧，写回完成后它会被重新放回replacer
+            if (pages_[*frame_id].pin_count_ == 0) return true;
+        }
+        return false;
     }
 
-    *frame_id = free_list_.front();
-    free_list_.pop_front();
+    *frame_id = partition->free_list_.front();
+    partition->free_list_.pop_front();
+    return true;
+}
+
+/**
+ * @description: 按访问策略得到可淘汰帧：优先复用策略在该分区的环中的下一个帧，
+ *               环未满或其中的帧不可复用时从free_list或replacer中取得一个帧，并将其加入环中
+ * @return {bool} true: 可替换帧查找成功 , false: 可替换帧查找失败
+ * @param {BufferPoolPartition*} partition 在该分区内查找，调用者需持有分区的latch_
+ * @param {frame_id_t*} frame_id 帧页id指针,返回成功找到的可替换帧id
+ * @param {PageId} page_id 将要读入该帧的页面
+ * @param {BufferAccessStrategy*} strategy 访问策略，为nullptr时与不带策略的find_victim_page相同
+ */
+bool BufferPoolManager::find_victim_page(BufferPoolPartition *partition, frame_id_t *frame_id, PageId page_id,
+                                         BufferAccessStrategy *strategy) {
+    if (strategy == nullptr) return find_victim_page(partition, frame_id);
+
+    auto &ring = strategy->rings_[get_partition_id(page_id)];
+    if (ring.slots.size() < strategy->ring_capacity_) {
+        if (!find_victim_page(partition, frame_id)) return false;
+        ring.slots.push_back({*frame_id, page_id});
+        return true;
+    }
+
+    auto &slot = ring.slots[ring.next];
+    ring.next = (ring.next + 1) % ring.slots.size();
+    auto page = pages_ + slot.frame_id;
+    // 环中的帧可能已在缩小缓冲池时被移出分区，此时不能再访问它
+    bool reusable = partition->is_active_frame(slot.frame_id) && page->id_ == slot.page_id && page->pin_count_ == 0;
+    // 脏页的日志尚未持久化时不能写回，将其留给缓冲池按正常的淘汰顺序处理
+    if (reusable && page->is_dirty() && log_manager_ != nullptr) {
+        reusable = page->get_page_lsn() < log_manager_->persist_lsn_.load();
+    }
+    if (reusable) {
+        // 帧中仍是本策略读入的页面且没有被使用，直接复用，不影响缓冲池中的其他页面
+        partition->replacer_->remove(slot.frame_id);
+        *frame_id = slot.frame_id;
+    } else if (!find_victim_page(partition, frame_id)) {
+        return false;
+    }
+    slot = {*frame_id, page_id};
     return true;
 }
 
 /**
  * @description: 更新页面数据, 如果为脏页则需写入磁盘，再更新为新页面，更新page元数据(data, is_dirty, page_id)和page table
- * @param {Page*} page 写回页指针
+ *               磁盘I/O期间不持有分区锁：帧先以新的page_id登记到页表并标记为I/O中，
+ *               其他线程访问该页面时只会在该帧上等待，访问其他页面则不受影响
+ * @param {BufferPoolPartition*} partition 帧所在的分区
+ * @param {unique_lock<mutex>&} lock 调用者持有的分区锁，函数返回时仍然持有
+ * @param {Page*} page 写回页指针，对应的帧已从free_list或replacer中取出
  * @param {PageId} new_page_id 新的page_id
  * @param {frame_id_t} new_frame_id 新的帧frame_id
+ * @param {bool} read_from_disk 为true时从磁盘读入新页面，否则将新页面初始化为空页面
  */
-void BufferPoolManager::update_page(Page *page, PageId new_page_id, frame_id_t new_frame_id) {
+void BufferPoolManager::update_page(BufferPoolPartition *partition, std::unique_lock<std::mutex> &lock, Page *page,
+                                    PageId new_page_id, frame_id_t new_frame_id, bool read_from_disk) {
     //Todo:
     // 1 如果是脏页，写回磁盘，并且把dirty置为false
     // 2 更新page table
     // 3 重置page的data，更新page id
+    PageId old_page_id = page->id_;
+    auto write_back_buf = prepare_frame(partition, page, new_page_id, new_frame_id);
+    lock.unlock();
+
+    try {
+        if (write_back_buf != nullptr) {
+            disk_manager_->write_page(old_page_id.fd, old_page_id.page_no, write_back_buf.get(), PAGE_SIZE);
+        }
+        page->reset_memory();
+        if (read_from_disk) {
+            disk_manager_->read_page(new_page_id.fd, new_page_id.page_no, page->data_, PAGE_SIZE);
+        } else {
+            // 新页面只在内存中清零，磁盘上对应的空间已由DiskManager预分配，页面标记为脏页，随正常写回落盘
+            page->set_page_lsn(INVALID_LSN);
+        }
+    } catch (...) {
+        lock.lock();
+        if (write_back_buf != nullptr) finish_write_back(partition, old_page_id);
+        finish_frame_io(partition, page, new_frame_id, false);
+        throw;
+    }
+
+    lock.lock();
+    if (write_back_buf != nullptr) finish_write_back(partition, old_page_id);
+    if (!read_from_disk) page->is_dirty_ = true;
+    finish_frame_io(partition, page, new_frame_id, true);
+}
+
+/**
+ * @description: 在分区锁内将帧切换为新页面：拷贝出脏页内容，更新页表，固定该帧并标记为I/O中
+ * @return {shared_ptr<char[]>} 旧页面为脏页时返回需要写回的内容，否则返回nullptr
+ * @param {BufferPoolPartition*} partition 帧所在的分区，调用者需持有分区的latch_
+ * @param {Page*} page 帧对应的页，已从free_list或replacer中取出
+ * @param {PageId} new_page_id 新的page_id
+ * @param {frame_id_t} new_frame_id 帧的frame_id
+ */
+std::shared_ptr<char[]> BufferPoolManager::prepare_frame(BufferPoolPartition *partition, Page *page,
+                                                         PageId new_page_id, frame_id_t new_frame_id) {
+    PageId old_page_id = page->id_;
+    if (page->prefetched_) {
+        num_prefetch_wasted_++;
+        page->prefetched_ = false;
+    }
+    std::shared_ptr<char[]> write_back_buf;
     if (page->is_dirty()) {
-        disk_manager_->write_page(page->id_.fd, page->id_.page_no, page->data_, PAGE_SIZE);
+        // 拷贝出脏页内容，在锁外写回；写回完成之前，读取该页面的线程需要等待，避免读到磁盘上的旧数据
+        write_back_buf = DiskManager::alloc_page_buffer();
+        memcpy(write_back_buf.get(), page->data_, PAGE_SIZE);
+        partition->writing_back_.insert(old_page_id);
         page->is_dirty_ = false;
     }
-    page_table_.erase(page->id_);
+    auto it = partition->page_table_.find(old_page_id);
+    if (it != partition->page_table_.end() && it->second == new_frame_id) partition->erase_page(old_page_id);
 
-    page->reset_memory();
-    disk_manager_->read_page(new_page_id.fd, new_page_id.page_no, page->data_, PAGE_SIZE);
-    if (new_frame_id != INVALID_FRAME_ID) page_table_[new_page_id] = new_frame_id;
+    partition->insert_page(new_page_id, new_frame_id);
+    partition->replacer_->pin(new_frame_id);
     page->id_ = new_page_id;
+    page->pin_count_ = 1;
+    page->io_in_progress_ = true;
+    return write_back_buf;
+}
+
+/**
+ * @description: 被淘汰页面写回完成，唤醒等待读取该页面的线程
+ * @param {BufferPoolPartition*} partition 页面所在的分区，调用者需持有分区的latch_
+ * @param {PageId} old_page_id 写回的页面
+ */
+void BufferPoolManager::finish_write_back(BufferPoolPartition *partition, PageId old_page_id) {
+    partition->writing_back_.erase(old_page_id);
+    partition->io_cv_.notify_all();
+}
+
+/**
+ * @description: 帧上的读入结束，唤醒等待该帧的线程；读入失败时帧不再对应任何页面，并放弃读入者持有的固定
+ * @param {BufferPoolPartition*} partition 帧所在的分区，调用者需持有分区的latch_
+ * @param {Page*} page 帧对应的页
+ * @param {frame_id_t} frame_id 帧的frame_id
+ * @param {bool} ok 读入是否成功
+ */
+void BufferPoolManager::finish_frame_io(BufferPoolPartition *partition, Page *page, frame_id_t frame_id, bool ok) {
+    if (!ok) {
+        // 等待该帧的线程醒来后会发现page_id已改变，放弃固定并重试
+        partition->erase_page(page->id_);
+        page->id_ = PageId{-1, INVALID_PAGE_ID};
+        page->prefetched_ = false;
+        release_frame(partition, page, frame_id);
+    }
+    page->io_in_progress_ = false;
+    page->io_cv_.notify_all();
+}
+
+/**
+ * @description: 为page_id准备异步读入：未命中时在所属分区中取得一个帧，生成写回旧页面和读入新页面的请求
+ * @return {Page*} keep_pin为true时返回已固定的页面（其读入可能仍在进行中）；
+ *                 无法异步读入（没有可用帧、页面正在写回）或keep_pin为false时返回nullptr
+ * @param {PageId} page_id 需要读入的页面
+ * @param {bool} keep_pin 为true时调用者持有页面的固定，否则读入完成后即取消固定，页面只留在缓冲池中
+ * @param {vector<AsyncIoRequest>&} requests 生成的I/O请求追加到其中
+ * @param {BufferAccessStrategy*} strategy 访问策略，为nullptr时从整个分区中淘汰帧
+ * @param {bool} evict 为false时只使用分区free_list中的帧，分区没有空闲帧时放弃读入，不淘汰已有页面
+ */
+Page *BufferPoolManager::start_async_fetch(PageId page_id, bool keep_pin, std::vector<AsyncIoRequest> &requests,
+                                           BufferAccessStrategy *strategy, bool evict) {
+    auto partition = get_partition(page_id);
+    std::lock_guard<std::mutex> lock{partition->latch_};
+    auto it = partition->page_table_.find(page_id);
+    if (it != partition->page_table_.end()) {
+        if (!keep_pin) return nullptr;
+        auto page = pages_ + it->second;
+        note_access(partition, page, it->second);
+        partition->replacer_->pin(it->second);
+        page->pin_count_++;
+        return page;
+    }
+    if (partition->writing_back_.count(page_id)) return nullptr;
+
+    frame_id_t frame_id = INVALID_FRAME_ID;
+    if (evict) {
+        if (!find_victim_page(partition, &frame_id, page_id, strategy)) return nullptr;
+    } else {
+        if (partition->free_list_.empty()) return nullptr;
+        frame_id = partition->free_list_.front();
+        partition->free_list_.pop_front();
+    }
+
+    auto page = pages_ + frame_id;
+    PageId old_page_id = page->id_;
+    auto write_back_buf = prepare_frame(partition, page, page_id, frame_id);
+    if (write_back_buf != nullptr) {
+        // 写回使用拷贝出的内容，与新页面的读入互不依赖，可以同时在途
+        requests.push_back({true, old_page_id.fd, old_page_id.page_no, write_back_buf.get(),
+                            [this, partition, old_page_id, write_back_buf](bool ok) {
+                                if (ok) {
+                                    std::lock_guard<std::mutex> lock{partition->latch_};
+                                    finish_write_back(partition, old_page_id);
+                                } else {
+                                    recover_failed_write_back(partition, old_page_id, write_back_buf.get());
+                                }
+                                finish_async_io();
+                            }});
+    }
+    requests.push_back({false, page_id.fd, page_id.page_no, page->data_,
+                        [this, partition, page, frame_id, keep_pin](bool ok) {
+                            {
+                                std::lock_guard<std::mutex> lock{partition->latch_};
+                                finish_frame_io(partition, page, frame_id, ok);
+                                if (ok && !keep_pin && --page->pin_count_ == 0) partition->replacer_->unpin(frame_id);
+                            }
+                            finish_async_io();
+                        }});
+    if (!keep_pin) {
+        page->prefetched_ = true;
+        num_prefetched_++;
+    }
+    std::lock_guard<std::mutex> async_lock{async_latch_};
+    num_async_io_ += write_back_buf != nullptr ? 2 : 1;
+    return keep_pin ? page : nullptr;
+}
+
+/**
+ * @description: 被淘汰脏页的异步写回失败时保证其修改不会丢失：先同步重试写回，仍然失败时把页面作为脏页放回分区，
+ *               之后淘汰或刷脏时再次写回；分区中暂时没有可用的帧时隔一段时间再次尝试。完成之前读取该页面的线程一直等待
+ * @param {BufferPoolPartition*} partition 页面所在的分区
+ * @param {PageId} page_id 写回失败的页面，仍在partition的writing_back_中
+ * @param {char*} data 页面的内容
+ */
+void BufferPoolManager::recover_failed_write_back(BufferPoolPartition *partition, PageId page_id, const char *data) {
+    while (true) {
+        bool ok = true;
+        try {
+            disk_manager_->write_page(page_id.fd, page_id.page_no, data, PAGE_SIZE);
+        } catch (RMDBError &e) {
+            ok = false;
+        }
+        {
+            std::lock_guard<std::mutex> lock{partition->latch_};
+            if (ok || reinstall_dirty_page(partition, page_id, data)) {
+                finish_write_back(partition, page_id);
+                return;
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(FLUSHER_INTERVAL_MS));
+    }
+}
+
+/**
+ * @description: 把写回失败的页面作为脏页放回分区中的空闲帧，或替换一个未固定的干净页面，不会引起新的写回
+ * @return {bool} 找到可用的帧并放回时返回true
+ * @param {BufferPoolPartition*} partition 页面所在的分区，调用者需持有分区的latch_
+ * @param {PageId} page_id 写回失败的页面
+ * @param {char*} data 页面的内容
+ */
+bool BufferPoolManager::reinstall_dirty_page(BufferPoolPartition *partition, PageId page_id, const char *data) {
+    frame_id_t frame_id = INVALID_FRAME_ID;
+    if (!partition->free_list_.empty()) {
+        frame_id = partition->free_list_.front();
+        partition->free_list_.pop_front();
+    } else {
+        std::vector<frame_id_t> dirty_frames;
+        frame_id_t victim;
+        while (frame_id == INVALID_FRAME_ID && partition->replacer_->victim(&victim)) {
+            // 与find_victim_page相同，跳过后台刷脏线程正在写回的帧；脏页需要写回才能替换，放回replacer中
+            if (pages_[victim].pin_count_ != 0) continue;
+            if (pages_[victim].is_dirty()) {
+                dirty_frames.push_back(victim);
+            } else {
+                frame_id = victim;
+            }
+        }
+        for (auto dirty_frame : dirty_frames) partition->replacer_->unpin(dirty_frame);
+        if (frame_id == INVALID_FRAME_ID) return false;
+    }
+
+    auto page = pages_ + frame_id;
+    prepare_frame(partition, page, page_id, frame_id);
+    memcpy(page->data_, data, PAGE_SIZE);
+    page->io_in_progress_ = false;
+    page->is_dirty_ = true;
+    page->pin_count_ = 0;
+    partition->replacer_->unpin(frame_id);
+    return true;
+}
+
+/**
+ * @description: 一个异步I/O的回调执行完毕，这是回调中最后一次访问缓冲池
+ */
+void BufferPoolManager::finish_async_io() {
+    std::lock_guard<std::mutex> lock{async_latch_};
+    if (--num_async_io_ == 0) async_cv_.notify_all();
+}
+
+/**
+ * @description: 等待已提交的异步I/O全部完成
+ */
+void BufferPoolManager::wait_async_io() {
+    std::unique_lock<std::mutex> lock{async_latch_};
+    async_cv_.wait(lock, [this] { return num_async_io_ == 0; });
+}
+
+/**
+ * @description: 放弃对一个已经不对应任何页面的帧的固定，最后一个放弃的线程负责将其放回free_list
+ * @param {BufferPoolPartition*} partition 帧所在的分区，调用者需持有分区的latch_
+ */
+void BufferPoolManager::release_frame(BufferPoolPartition *partition, Page *page, frame_id_t frame_id) {
+    if (--page->pin_count_ == 0) {
+        partition->replacer_->remove(frame_id);
+        partition->free_list_.push_back(frame_id);
+    }
 }
 
 /**
@@ -59,8 +454,9 @@ void BufferPoolManager::update_page(Page *page, PageId new_page_id, frame_id_t n
  *              如果页表不存在page_id（说明该page在磁盘中），则找缓冲池victim page，将其替换为磁盘中读取的page，pin_count置1。
  * @return {Page*} 若获得了需要的页则将其返回，否则返回nullptr
  * @param {PageId} page_id 需要获取的页的PageId
+ * @param {BufferAccessStrategy*} strategy 访问策略，为nullptr时未命中的页面从整个分区中淘汰帧
  */
-Page* BufferPoolManager::fetch_page(PageId page_id) {
+Page* BufferPoolManager::fetch_page(PageId page_id, BufferAccessStrategy *strategy) {
     //Todo:
     // 1.     从page_table_中搜寻目标页
     // 1.1    若目标页有被page_table_记录，则将其所在frame固定(pin)，并返回目标页。
@@ -69,24 +465,143 @@ Page* BufferPoolManager::fetch_page(PageId page_id) {
     // 3.     调用disk_manager_的read_page读取目标页到frame
     // 4.     固定目标页，更新pin_count_
     // 5.     返回目标页
-    std::lock_guard<std::mutex> lock{latch_};
-    if (page_table_.count(page_id)) {
-        auto frame_id = page_table_[page_id];
-        replacer_->pin(frame_id);
+    auto partition = get_partition(page_id);
+    std::unique_lock<std::mutex> lock{partition->latch_};
+    while (true) {
+        auto it = partition->page_table_.find(page_id);
+        if (it != partition->page_table_.end()) {
+            auto frame_id = it->second;
+            auto page = pages_ + frame_id;
+            note_access(partition, page, frame_id);
+            partition->replacer_->pin(frame_id);
+            page->pin_count_++;
+            // 其他线程正在读入该页面，只在该帧上等待
+            page->io_cv_.wait(lock, [page] { return !page->io_in_progress_; });
+            if (page->id_ == page_id) return page;
+            // 读入失败，放弃固定后重试
+            release_frame(partition, page, frame_id);
+            continue;
+        }
+        // 目标页刚被淘汰、仍在写回磁盘，等待写回完成后再读取
+        if (partition->writing_back_.count(page_id)) {
+            partition->io_cv_.wait(lock);
+            continue;
+        }
+
+        frame_id_t frame_id = INVALID_FRAME_ID;
+        if (!find_victim_page(partition, &frame_id, page_id, strategy)) return nullptr;
+
         auto page = pages_ + frame_id;
-        page->pin_count_++;
+        update_page(partition, lock, page, page_id, frame_id, true);
         return page;
     }
+}
 
-    frame_id_t frame_id = INVALID_FRAME_ID;
-    if (!find_victim_page(&frame_id)) return nullptr;
+/**
+ * @description: 批量获取页面：所有未命中页面的读入（以及被淘汰脏页的写回）一次性提交给异步I/O引擎，
+ *               使多个I/O同时在途，然后等待全部完成。返回的页面均已固定，使用完毕后需要逐个unpin_page
+ * @return {vector<Page*>} 与page_ids一一对应的页面，缓冲池中没有可用帧的位置为nullptr
+ * @param {vector<PageId>&} page_ids 需要获取的页面
+ */
+std::vector<Page *> BufferPoolManager::fetch_pages(const std::vector<PageId> &page_ids) {
+    std::vector<Page *> pages(page_ids.size(), nullptr);
+    std::vector<AsyncIoRequest> requests;
+    for (size_t i = 0; i < page_ids.size(); i++) {
+        pages[i] = start_async_fetch(page_ids[i], true, requests);
+    }
+    disk_manager_->submit_async_io(requests);
 
-    auto page = pages_ + frame_id;
-    update_page(page, page_id, frame_id);
+    for (size_t i = 0; i < page_ids.size(); i++) {
+        if (pages[i] != nullptr) {
+            auto partition = get_partition(page_ids[i]);
+            std::unique_lock<std::mutex> lock{partition->latch_};
+            auto page = pages[i];
+            page->io_cv_.wait(lock, [page] { return !page->io_in_progress_; });
+            if (page->id_ == page_ids[i]) continue;
+            // 读入失败，放弃固定后走同步路径重试
+            release_frame(partition, page, static_cast<frame_id_t>(page - pages_));
+        }
+        pages[i] = fetch_page(page_ids[i]);
+    }
+    return pages;
+}
 
-    replacer_->pin(frame_id);
-    page->pin_count_++;
-    return page;
+/**
+ * @description: 预读页面：为不在缓冲池中的页面提交异步读入后立即返回，不固定页面，
+ *               之后的fetch_page将直接命中或只需等待在途的读入。没有可用帧时放弃对应页面的预读
+ * @return {size_t} 实际提交读入的页面数
+ * @param {vector<PageId>&} page_ids 需要预读的页面
+ * @param {BufferAccessStrategy*} strategy 访问策略，为nullptr时从整个分区中淘汰帧
+ * @param {bool} evict 为false时只使用空闲帧，不淘汰已有页面
+ */
+size_t BufferPoolManager::prefetch_pages(const std::vector<PageId> &page_ids, BufferAccessStrategy *strategy,
+                                         bool evict) {
+    std::vector<AsyncIoRequest> requests;
+    for (auto &page_id : page_ids) {
+        start_async_fetch(page_id, false, requests, strategy, evict);
+    }
+    size_t num_reads = std::count_if(requests.begin(), requests.end(),
+                                     [](const AsyncIoRequest &request) { return !request.is_write; });
+    disk_manager_->submit_async_io(requests);
+    return num_reads;
+}
+
+/**
+ * @description: 顺序预读：扫描每访问一个新页面时调用。识别出对同一文件按页号递增的访问后，
+ *               异步预读其后的页面；已预读的页面剩余不足半个窗口时预读下一个窗口，窗口大小每次翻倍，
+ *               从READ_AHEAD_MIN_PAGES增长到READ_AHEAD_MAX_PAGES。访问不连续时重置窗口
+ * @param {PageId} page_id 即将访问的页面
+ * @param {page_id_t} end_page_no 文件中页号的上界（不含），预读不会超过该页号
+ * @param {BufferAccessStrategy*} strategy 扫描使用的访问策略，预读的页面同样放入其环中，
+ *                                         窗口不超过环的一半，避免预读的页面在被访问之前就被环复用
+ */
+void BufferPoolManager::read_ahead(PageId page_id, page_id_t end_page_no, BufferAccessStrategy *strategy) {
+    int max_window = READ_AHEAD_MAX_PAGES;
+    if (strategy != nullptr) {
+        max_window = std::max(1, std::min(max_window, static_cast<int>(strategy->get_ring_size() / 2)));
+    }
+    page_id_t begin = 0, end = 0;
+    {
+        std::lock_guard<std::mutex> lock{read_ahead_latch_};
+        auto &state = read_ahead_states_[page_id.fd];
+        if (page_id.page_no == state.last_page_no) return;
+        // 扫描可能跳过空页面，在已预读的范围内向后跳跃也视为顺序访问
+        bool sequential = page_id.page_no > state.last_page_no &&
+                          page_id.page_no <= std::max(state.last_page_no + 1, state.prefetched_end);
+        state.last_page_no = page_id.page_no;
+        if (!sequential) {
+            state.window = 0;
+            state.prefetched_end = page_id.page_no + 1;
+            return;
+        }
+        if (state.prefetched_end - page_id.page_no > state.window / 2) return;
+        state.window = std::min(state.window == 0 ? READ_AHEAD_MIN_PAGES : state.window * 2, max_window);
+        begin = std::max(state.prefetched_end, page_id.page_no + 1);
+        end = std::min(begin + state.window, end_page_no);
+        if (begin >= end) return;
+        state.prefetched_end = end;
+    }
+    std::vector<PageId> page_ids;
+    for (page_id_t page_no = begin; page_no < end; page_no++) {
+        page_ids.push_back(PageId{page_id.fd, page_no});
+    }
+    prefetch_pages(page_ids, strategy);
+}
+
+/**
+ * @description: 页面被访问、即将被固定时调用。若其由预读读入且是第一次被访问，则记为一次预读命中，
+ *               并丢弃预读时在置换器中留下的访问记录，使预读与第一次访问只算作一次访问，
+ *               否则LRU-K会把只被扫描过一次的页面当作热点页面，而优先淘汰尚未被访问的预读页面
+ * @param {BufferPoolPartition*} partition 页面所在的分区，调用者需持有分区的latch_
+ * @param {Page*} page 被访问的页面
+ * @param {frame_id_t} frame_id 页面所在的帧
+ */
+void BufferPoolManager::note_access(BufferPoolPartition *partition, Page *page, frame_id_t frame_id) {
+    if (page->prefetched_) {
+        num_prefetch_hits_++;
+        page->prefetched_ = false;
+        partition->replacer_->remove(frame_id);
+    }
 }
 
 /**
@@ -105,12 +620,14 @@ bool BufferPoolManager::unpin_page(PageId page_id, bool is_dirty) {
     // 2.2 若pin_count_大于0，则pin_count_自减一
     // 2.2.1 若自减后等于0，则调用replacer_的Unpin
     // 3 根据参数is_dirty，更改P的is_dirty_
-    std::lock_guard<std::mutex> lock{latch_};
-    if (!page_table_.count(page_id)) {
+    auto partition = get_partition(page_id);
+    std::lock_guard<std::mutex> lock{partition->latch_};
+    auto it = partition->page_table_.find(page_id);
+    if (it == partition->page_table_.end()) {
         return false;
     }
 
-    auto frame_id = page_table_[page_id];
+    auto frame_id = it->second;
     auto page = pages_ + frame_id;
     if (page->pin_count_ == 0) {
         std::cout << "@ "<< page->id_.page_no << std::endl;
@@ -118,7 +635,7 @@ bool BufferPoolManager::unpin_page(PageId page_id, bool is_dirty) {
     }
 
     page->pin_count_--;
-    if (page->pin_count_ == 0) replacer_->unpin(frame_id);
+    if (page->pin_count_ == 0) partition->replacer_->unpin(frame_id);
     page->is_dirty_ |= is_dirty;
 
     return true;
@@ -136,12 +653,21 @@ bool BufferPoolManager::flush_page(PageId page_id) {
     // 1.1 目标页P没有被page_table_记录 ，返回false
     // 2. 无论P是否为脏都将其写回磁盘。
     // 3. 更新P的is_dirty_
-    std::lock_guard<std::mutex> lock{latch_};
-    if (!page_table_.count(page_id)) {
-        return false;
+    auto partition = get_partition(page_id);
+    std::unique_lock<std::mutex> lock{partition->latch_};
+    Page *page = nullptr;
+    while (true) {
+        auto it = partition->page_table_.find(page_id);
+        if (it == partition->page_table_.end()) {
+            return false;
+        }
+        page = pages_ + it->second;
+        if (!page->flushing_) break;
+        // 等待后台刷脏线程写回完成，避免其写入的旧内容覆盖本次写回的内容
+        partition->io_cv_.wait(lock);
     }
-    auto frame_id = page_table_[page_id];
-    auto page = pages_ + frame_id;
+    // 页面尚未读入完成时，缓冲区中的内容不是有效数据，不能写回
+    if (page->io_in_progress_) return true;
     disk_manager_->write_page(page_id.fd, page_id.page_no, page->data_, PAGE_SIZE);
     page->is_dirty_ = false;
     return true;
@@ -156,30 +682,23 @@ Page* BufferPoolManager::new_page(PageId* page_id) {
     //Todo
     // 1.   获得一个可用的frame，若无法获得则返回nullptr
     // 2.   在fd对应的文件分配一个新的page_id
-    // 3.   将frame的数据写回磁盘
+    // 3.   将frame中被淘汰的脏页写回磁盘，新页面只在内存中清零，不立即写盘
     // 4.   固定frame，更新pin_count_
     // 5.   返回获得的page
-    std::lock_guard<std::mutex> lock{latch_};
-    frame_id_t frame_id = -1;
-    if (!find_victim_page(&frame_id)) return nullptr;
-
-    auto page = pages_ + frame_id;
-    if (page->is_dirty())
-        disk_manager_->write_page(page->id_.fd, page->id_.page_no, page->data_, PAGE_SIZE);
-    page_table_.erase(page->id_);
-
-
+    // 新页面所属的分区由其page_no决定，因此需要先分配page_no，再到对应分区中寻找可用帧
     page_id->page_no = disk_manager_->allocate_page(page_id->fd);
+    auto partition = get_partition(*page_id);
+    std::unique_lock<std::mutex> lock{partition->latch_};
+    frame_id_t frame_id = INVALID_FRAME_ID;
+    if (!find_victim_page(partition, &frame_id)) {
+        // 分配失败，归还刚刚分配的page_no，避免文件中出现空洞
+        disk_manager_->deallocate_last_page(page_id->fd, page_id->page_no);
+        page_id->page_no = INVALID_PAGE_ID;
+        return nullptr;
+    }
 
-    replacer_->pin(frame_id);
-    page->id_ = *page_id;
-    page->pin_count_++;
-    page->is_dirty_ = false;
-    page->reset_memory();
-    page->set_page_lsn(INVALID_LSN);
-    disk_manager_->write_page(page->id_.fd, page->id_.page_no, page->get_data(), PAGE_SIZE);
-
-    page_table_[*page_id] = frame_id;
+    auto page = pages_ + frame_id;
+    update_page(partition, lock, page, *page_id, frame_id, false);
     return page;
 }
 
@@ -193,22 +712,27 @@ bool BufferPoolManager::delete_page(PageId page_id) {
     // 1.   在page_table_中查找目标页，若不存在返回true
     // 2.   若目标页的pin_count不为0，则返回false
     // 3.   将目标页数据写回磁盘，从页表中删除目标页，重置其元数据，将其加入free_list_，返回true
-    std::lock_guard<std::mutex> lock{latch_};
-    if (!page_table_.count(page_id)) return true;
+    auto partition = get_partition(page_id);
+    std::lock_guard<std::mutex> lock{partition->latch_};
+    auto it = partition->page_table_.find(page_id);
+    if (it == partition->page_table_.end()) return true;
 
-    auto frame_id = page_table_[page_id];
+    auto frame_id = it->second;
     auto page = pages_ + frame_id;
     if (page->pin_count_ > 0) return false;
 
     disk_manager_->write_page(page_id.fd, page_id.page_no, page->data_, PAGE_SIZE);
     page->is_dirty_ = false;
-    page_table_.erase(page_id);
+    partition->erase_page(page_id);
 
     page->reset_memory();
     page->pin_count_ = 0;
     page->id_ = PageId{-1, INVALID_PAGE_ID};
+    page->prefetched_ = false;
 
-    free_list_.push_back(frame_id);
+    // 先将帧从置换器中移除再放回空闲链表，避免同一帧被分配两次
+    partition->replacer_->remove(frame_id);
+    partition->free_list_.push_back(frame_id);
     return true;
 }
 
@@ -217,18 +741,409 @@ bool BufferPoolManager::delete_page(PageId page_id) {
  * @param {int} fd 文件句柄
  */
 void BufferPoolManager::flush_all_pages(int fd) {
-    std::lock_guard<std::mutex> lock{latch_};
-    for (int frame_id = 0; frame_id < pool_size_; frame_id++) {
+    // 先等待预读等异步I/O完成，它们可能仍在读写该文件
+    wait_async_io();
+    // 从各分区的文件帧索引中取出该文件常驻的页面，无需扫描整个缓冲池
+    std::vector<std::pair<page_id_t, frame_id_t>> frames;
+    for (auto &partition_ptr : partitions_) {
+        auto partition = partition_ptr.get();
+        std::unique_lock<std::mutex> lock{partition->latch_};
+        // 等待该文件被淘汰页面的写回完成，保证函数返回后文件可以被安全关闭
+        partition->io_cv_.wait(lock, [partition, fd] {
+            return std::none_of(partition->writing_back_.begin(), partition->writing_back_.end(),
+                                [fd](const PageId &page_id) { return page_id.fd == fd; });
+        });
+        auto it = partition->file_frames_.find(fd);
+        if (it != partition->file_frames_.end()) frames.insert(frames.end(), it->second.begin(), it->second.end());
+    }
+    // 按页号顺序写回，使写回接近顺序I/O
+    std::sort(frames.begin(), frames.end());
+    for (auto &[page_no, frame_id] : frames) {
+        PageId page_id = {fd, page_no};
+        auto partition = get_partition(page_id);
+        std::unique_lock<std::mutex> lock{partition->latch_};
         auto page = pages_ + frame_id;
-        if (page->id_.fd != fd || page->id_.page_no == INVALID_PAGE_ID) continue;
+        partition->io_cv_.wait(lock, [partition, page, frame_id] {
+            return !partition->is_active_frame(frame_id) || !page->flushing_;
+        });
+        // 收集之后帧可能已被挪作他用，或在缩小缓冲池时被移出分区
+        if (!partition->is_active_frame(frame_id) || !(page->id_ == page_id) || page->io_in_progress_) continue;
 
-        disk_manager_->write_page(page->id_.fd, page->id_.page_no, page->get_data(), PAGE_SIZE);
+        disk_manager_->write_page(fd, page_no, page->get_data(), PAGE_SIZE);
         page->is_dirty_ = false;
 
         if (page->pin_count_) continue;
-        page_table_.erase(page->id_);
+        partition->erase_page(page_id);
         page->id_ = {-1, INVALID_PAGE_ID};
+        if (page->prefetched_) {
+            num_prefetch_wasted_++;
+            page->prefetched_ = false;
+        }
         page->reset_memory();
-        replacer_->unpin(frame_id);
+        partition->replacer_->unpin(frame_id);
+    }
+    // 文件可能随后被关闭，其fd会被重用，丢弃该文件的顺序预读状态
+    std::lock_guard<std::mutex> lock{read_ahead_latch_};
+    read_ahead_states_.erase(fd);
+}
+
+/**
+ * @description: 后台刷脏的一轮：将每个分区中即将被淘汰的脏页按页号顺序写回磁盘，
+ *               使每个分区的空闲帧与淘汰端的干净帧合计达到clean_target / num_partitions_个，
+ *               查询线程淘汰页面时就能直接使用干净的帧。日志尚未持久化的页面留到之后再写回
+ * @return {size_t} 本轮写回的页面个数
+ * @param {size_t} clean_target 整个缓冲池需要保持干净的帧的个数
+ */
+size_t BufferPoolManager::flush_tail_pages(size_t clean_target) {
+    struct FlushItem {
+        PageId page_id;
+        frame_id_t frame_id;
+        BufferPoolPartition *partition;
+        PageBuffer data;
+    };
+    std::vector<FlushItem> items;
+    size_t target = (clean_target + num_partitions_ - 1) / num_partitions_;
+    lsn_t persist_lsn = log_manager_ == nullptr ? INVALID_LSN : log_manager_->persist_lsn_.load();
+    for (auto &partition_ptr : partitions_) {
+        auto partition = partition_ptr.get();
+        std::lock_guard<std::mutex> lock{partition->latch_};
+        if (partition->free_list_.size() >= target) continue;
+        for (auto frame_id : partition->replacer_->next_victims(target - partition->free_list_.size())) {
+            auto page = pages_ + frame_id;
+            if (!page->is_dirty_ || page->pin_count_ > 0 || page->io_in_progress_ || page->flushing_) continue;
+            // WAL：修改该页面的日志持久化之后才能写回页面
+            if (log_manager_ != nullptr && page->get_page_lsn() >= persist_lsn) continue;
+            // 只增加pin_count_而不调用replacer的pin，不改变页面在置换器中的位置；写回期间页面可以被正常访问和修改
+            page->pin_count_++;
+            page->flushing_ = true;
+            page->is_dirty_ = false;
+            auto data = DiskManager::alloc_page_buffer();
+            memcpy(data.get(), page->data_, PAGE_SIZE);
+            items.push_back({page->id_, frame_id, partition, std::move(data)});
+        }
+    }
+
+    std::sort(items.begin(), items.end(), [](const FlushItem &a, const FlushItem &b) {
+        return a.page_id.fd != b.page_id.fd ? a.page_id.fd < b.page_id.fd : a.page_id.page_no < b.page_id.page_no;
+    });
+    size_t num_flushed = 0;
+    for (size_t i = 0; i < items.size();) {
+        // 同一文件中页号连续的页面合并为一次向量写
+        size_t j = i + 1;
+        while (j < items.size() && items[j].page_id.fd == items[i].page_id.fd &&
+               items[j].page_id.page_no == items[j - 1].page_id.page_no + 1) {
+            j++;
+        }
+        std::vector<const char *> bufs;
+        for (size_t k = i; k < j; k++) bufs.push_back(items[k].data.get());
+        bool ok = true;
+        try {
+            disk_manager_->write_pages(items[i].page_id.fd, items[i].page_id.page_no, bufs.data(),
+                                       static_cast<int>(j - i));
+            num_flushed += j - i;
+        } catch (RMDBError &e) {
+            ok = false;
+        }
+        for (size_t k = i; k < j; k++) {
+            auto partition = items[k].partition;
+            auto page = pages_ + items[k].frame_id;
+            std::lock_guard<std::mutex> lock{partition->latch_};
+            page->flushing_ = false;
+            if (!ok) page->is_dirty_ = true;
+            if (--page->pin_count_ == 0) partition->replacer_->unpin(items[k].frame_id);
+            partition->io_cv_.notify_all();
+        }
+        i = j;
+    }
+    return num_flushed;
+}
+
+/**
+ * @description: 启动后台刷脏线程，每隔FLUSHER_INTERVAL_MS毫秒执行一轮flush_tail_pages
+ * @param {size_t} clean_target 整个缓冲池需要保持干净的帧的个数
+ */
+void BufferPoolManager::start_flusher(size_t clean_target) {
+    stop_flusher();
+    flusher_stop_ = false;
+    flusher_ = std::thread([this, clean_target] {
+        std::unique_lock<std::mutex> lock{flusher_latch_};
+        while (!flusher_stop_) {
+            lock.unlock();
+            flush_tail_pages(clean_target);
+            lock.lock();
+            flusher_cv_.wait_for(lock, std::chrono::milliseconds(FLUSHER_INTERVAL_MS), [this] { return flusher_stop_; });
+        }
+    });
+}
+
+/**
+ * @description: 停止后台刷脏线程，未启动时直接返回
+ */
+void BufferPoolManager::stop_flusher() {
+    if (!flusher_.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock{flusher_latch_};
+        flusher_stop_ = true;
+    }
+    flusher_cv_.notify_all();
+    flusher_.join();
+}
+
+/**
+ * @description: 按热度从高到低列出缓冲池中常驻的页面，用于保存预热快照。各分区按置换器的淘汰顺序倒序排列，
+ *               被固定的帧以及CLOCK中访问位为1的帧不在淘汰顺序中，视为最热；各分区的列表轮流合并。
+ *               由预读读入、之后未被访问过的页面不计入
+ * @return {vector<PageId>} 常驻的页面，第一个最热
+ */
+std::vector<PageId> BufferPoolManager::get_hot_pages() {
+    std::vector<std::vector<PageId>> lists;
+    for (auto &partition_ptr : partitions_) {
+        auto partition = partition_ptr.get();
+        std::lock_guard<std::mutex> lock{partition->latch_};
+        auto order = partition->replacer_->next_victims(partition->num_frames_);
+        std::unordered_set<frame_id_t> in_order(order.begin(), order.end());
+        std::vector<frame_id_t> frames;
+        for (auto &[page_id, frame_id] : partition->page_table_) {
+            if (!in_order.count(frame_id)) frames.push_back(frame_id);
+        }
+        frames.insert(frames.end(), order.rbegin(), order.rend());
+        auto &list = lists.emplace_back();
+        for (auto frame_id : frames) {
+            auto page = pages_ + frame_id;
+            if (page->id_.page_no == INVALID_PAGE_ID || page->io_in_progress_ || page->prefetched_) continue;
+            list.push_back(page->id_);
+        }
+    }
+    std::vector<PageId> page_ids;
+    for (size_t i = 0, remaining = lists.size(); remaining > 0; i++) {
+        remaining = 0;
+        for (auto &list : lists) {
+            if (i < list.size()) page_ids.push_back(list[i]);
+            if (i + 1 < list.size()) remaining++;
+        }
     }
-}
\ No newline at end of file
+    return page_ids;
+}
+
+/**
+ * @description: 启动预热线程，按顺序分批预读page_ids中的页面，每批按文件和页号排序后提交，
+ *               批与批之间等待，使预读速率不超过pages_per_second。只使用空闲帧，不淘汰已有页面：
+ *               页面所在分区没有空闲帧时跳过该页面，所有分区都没有空闲帧时停止
+ * @param {vector<PageId>} page_ids 需要预热的页面，通常来自上次关闭时的get_hot_pages
+ * @param {size_t} pages_per_second 每秒最多预读的页面数
+ */
+void BufferPoolManager::start_warmup(std::vector<PageId> page_ids, size_t pages_per_second) {
+    stop_warmup();
+    warmer_stop_ = false;
+    num_warmed_ = 0;
+    auto interval = std::chrono::microseconds(1000000 * WARMUP_BATCH_PAGES / std::max<size_t>(1, pages_per_second));
+    warmer_ = std::thread([this, page_ids = std::move(page_ids), interval] {
+        size_t next = 0;
+        while (next < page_ids.size()) {
+            if (num_free_frames() == 0) break;
+            size_t num_pages = std::min(WARMUP_BATCH_PAGES, page_ids.size() - next);
+            std::vector<PageId> batch(page_ids.begin() + next, page_ids.begin() + next + num_pages);
+            std::sort(batch.begin(), batch.end(), [](const PageId &a, const PageId &b) {
+                return a.fd != b.fd ? a.fd < b.fd : a.page_no < b.page_no;
+            });
+            // 页面所在分区没有空闲帧时跳过该页面，其他分区仍可能有空闲帧
+            num_warmed_ += prefetch_pages(batch, nullptr, false);
+            next += num_pages;
+
+            std::unique_lock<std::mutex> lock{warmer_latch_};
+            if (warmer_cv_.wait_for(lock, interval, [this] { return warmer_stop_; })) break;
+        }
+    });
+}
+
+/**
+ * @description: 取消预热，等待预热线程退出；未启动时直接返回
+ */
+void BufferPoolManager::stop_warmup() {
+    if (!warmer_.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock{warmer_latch_};
+        warmer_stop_ = true;
+    }
+    warmer_cv_.notify_all();
+    warmer_.join();
+}
+
+/**
+ * @description: 统计所有分区中空闲帧的个数
+ */
+size_t BufferPoolManager::num_free_frames() {
+    size_t num = 0;
+    for (auto &partition : partitions_) {
+        std::lock_guard<std::mutex> lock{partition->latch_};
+        num += partition->free_list_.size();
+    }
+    return num;
+}
+
+/**
+ * @description: 在运行时调整缓冲池的帧数，各分区平均分配。扩大时新的帧直接加入空闲链表；
+ *               缩小时从每个分区编号最大的帧开始移出：空闲帧和干净帧直接移出，日志已持久化的脏页先写回再移出，
+ *               遇到被固定的帧时等待其被释放，超过BUFFER_POOL_RESIZE_TIMEOUT_MS毫秒后放弃
+ * @return {size_t} 调整后实际的帧数，缩小未能完成时大于pool_size
+ * @param {size_t} pool_size 目标帧数，不能小于分区数，也不能超过构造时指定的最大帧数
+ */
+size_t BufferPoolManager::resize(size_t pool_size) {
+    if (pool_size < num_partitions_ || pool_size > max_pool_size_) {
+        throw InternalError("buffer pool size must be between " + std::to_string(num_partitions_) + " and " +
+                            std::to_string(max_pool_size_) + " pages");
+    }
+    std::lock_guard<std::mutex> resize_lock{resize_latch_};
+    // 先将日志刷盘，使尽可能多的脏页可以在缩小时直接写回
+    if (log_manager_ != nullptr && pool_size < pool_size_) log_manager_->flush_log_to_disk();
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(BUFFER_POOL_RESIZE_TIMEOUT_MS);
+    while (true) {
+        bool done = true;
+        for (size_t i = 0; i < num_partitions_; ++i) {
+            auto partition = partitions_[i].get();
+            size_t num_frames = (i + 1) * pool_size / num_partitions_ - i * pool_size / num_partitions_;
+            if (num_frames > partition->num_frames_) {
+                grow_partition(partition, num_frames);
+            } else if (!shrink_partition(partition, num_frames)) {
+                done = false;
+            }
+        }
+        size_t total = 0;
+        for (auto &partition : partitions_) total += partition->num_frames_;
+        pool_size_ = total;
+        if (done || std::chrono::steady_clock::now() >= deadline) return total;
+        std::this_thread::sleep_for(std::chrono::milliseconds(FLUSHER_INTERVAL_MS));
+    }
+}
+
+/**
+ * @description: 解析缓冲池大小：不带单位时为帧数，带K、M、G单位时为字节数，例如"4G"
+ * @return {size_t} 对应的帧数
+ * @param {string&} value 要解析的字符串
+ */
+size_t BufferPoolManager::parse_pool_size(const std::string &value) {
+    size_t pos = 0;
+    unsigned long long num = 0;
+    try {
+        num = std::stoull(value, &pos);
+    } catch (std::exception &e) {
+        throw InternalError("invalid buffer pool size: " + value);
+    }
+    if (pos == value.size()) return num;
+    if (pos + 1 != value.size()) throw InternalError("invalid buffer pool size: " + value);
+    switch (toupper(value[pos])) {
+        case 'K': num <<= 10; break;
+        case 'M': num <<= 20; break;
+        case 'G': num <<= 30; break;
+        default: throw InternalError("invalid buffer pool size: " + value);
+    }
+    return num / PAGE_SIZE;
+}
+
+/**
+ * @description: 扩大分区：构造新的帧并将其加入空闲链表
+ * @param {BufferPoolPartition*} partition 要扩大的分区
+ * @param {size_t} num_frames 分区的目标帧数，不超过partition_capacity_
+ */
+void BufferPoolManager::grow_partition(BufferPoolPartition *partition, size_t num_frames) {
+    // 帧数只在持有resize_latch_时改变，新的帧在加入空闲链表之前不会被其他线程访问，可以在锁外构造
+    frame_id_t begin = partition->first_frame_id_ + static_cast<frame_id_t>(partition->num_frames_);
+    frame_id_t end = partition->first_frame_id_ + static_cast<frame_id_t>(num_frames);
+    for (frame_id_t frame_id = begin; frame_id < end; ++frame_id) {
+        new (pages_ + frame_id) Page(data_arena_ + static_cast<size_t>(frame_id) * PAGE_SIZE);
+    }
+    std::lock_guard<std::mutex> lock{partition->latch_};
+    for (frame_id_t frame_id = begin; frame_id < end; ++frame_id) {
+        partition->free_list_.push_back(frame_id);
+    }
+    partition->num_frames_ = num_frames;
+    partition->replacer_->resize(num_frames);
+}
+
+/**
+ * @description: 缩小分区：从编号最大的帧开始逐个移出，遇到无法移出的帧时停止
+ * @return {bool} 是否缩小到了目标帧数
+ * @param {BufferPoolPartition*} partition 要缩小的分区
+ * @param {size_t} num_frames 分区的目标帧数
+ */
+bool BufferPoolManager::shrink_partition(BufferPoolPartition *partition, size_t num_frames) {
+    // 每次持有分区锁时最多移出的帧数，避免长时间阻塞该分区上的其他操作
+    const size_t batch = 1024;
+    size_t old_num_frames = partition->num_frames_;
+    bool blocked = false;
+    while (!blocked && partition->num_frames_ > num_frames) {
+        std::lock_guard<std::mutex> lock{partition->latch_};
+        lsn_t persist_lsn = log_manager_ == nullptr ? INVALID_LSN : log_manager_->persist_lsn_.load();
+        size_t target = std::max(num_frames, partition->num_frames_ > batch ? partition->num_frames_ - batch : 0);
+        while (partition->num_frames_ > target) {
+            auto frame_id = partition->first_frame_id_ + static_cast<frame_id_t>(partition->num_frames_) - 1;
+            if (!drain_frame(partition, frame_id, persist_lsn)) {
+                blocked = true;
+                break;
+            }
+            partition->num_frames_--;
+        }
+        auto limit = partition->first_frame_id_ + static_cast<frame_id_t>(partition->num_frames_);
+        partition->free_list_.remove_if([limit](frame_id_t frame_id) { return frame_id >= limit; });
+        partition->replacer_->resize(partition->num_frames_);
+    }
+    // 被移出的帧不会再被访问，析构帧对象并将其内存归还给操作系统
+    release_frames(partition->first_frame_id_ + static_cast<frame_id_t>(partition->num_frames_),
+                   partition->first_frame_id_ + static_cast<frame_id_t>(old_num_frames));
+    return partition->num_frames_ == num_frames;
+}
+
+/**
+ * @description: 将帧从分区中移出：空闲帧和干净帧直接移出，脏页写回后移出
+ * @return {bool} 帧被固定、正在进行I/O或脏页的日志尚未持久化时无法移出，返回false
+ * @param {BufferPoolPartition*} partition 帧所在的分区，调用者需持有分区的latch_
+ * @param {frame_id_t} frame_id 要移出的帧
+ * @param {lsn_t} persist_lsn 已持久化的日志的上界
+ */
+bool BufferPoolManager::drain_frame(BufferPoolPartition *partition, frame_id_t frame_id, lsn_t persist_lsn) {
+    auto page = pages_ + frame_id;
+    if (page->pin_count_ > 0 || page->io_in_progress_ || page->flushing_) return false;
+    if (page->id_.page_no != INVALID_PAGE_ID) {
+        if (page->is_dirty_) {
+            // WAL：修改该页面的日志持久化之后才能写回页面
+            if (log_manager_ != nullptr && page->get_page_lsn() >= persist_lsn) return false;
+            disk_manager_->write_page(page->id_.fd, page->id_.page_no, page->data_, PAGE_SIZE);
+            page->is_dirty_ = false;
+        }
+        if (page->prefetched_) {
+            num_prefetch_wasted_++;
+            page->prefetched_ = false;
+        }
+        partition->erase_page(page->id_);
+        page->id_ = PageId{-1, INVALID_PAGE_ID};
+    }
+    // 空闲帧由调用者统一从free_list_中删除
+    partition->replacer_->remove(frame_id);
+    return true;
+}
+
+/**
+ * @description: 析构[begin, end)中的帧描述符，并将这些帧完整占用的内存页归还给操作系统，归还的数据在再次使用时为全0
+ */
+void BufferPoolManager::release_frames(frame_id_t begin, frame_id_t end) {
+    if (begin >= end) return;
+    for (frame_id_t frame_id = begin; frame_id < end; ++frame_id) {
+        pages_[frame_id].~Page();
+    }
+    // 帧描述符的大小不是内存页大小的整数倍，两端与相邻帧共享的内存页保留
+    static const uintptr_t os_page_size = sysconf(_SC_PAGESIZE);
+    auto first = reinterpret_cast<uintptr_t>(pages_ + begin);
+    auto last = reinterpret_cast<uintptr_t>(pages_ + end);
+    first = (first + os_page_size - 1) / os_page_size * os_page_size;
+    last = last / os_page_size * os_page_size;
+    if (first < last) madvise(reinterpret_cast<void *>(first), last - first, MADV_DONTNEED);
+
+    char *data_begin = data_arena_ + static_cast<size_t>(begin) * PAGE_SIZE;
+    size_t data_bytes = static_cast<size_t>(end - begin) * PAGE_SIZE;
+    if (huge_pages_ == "hugetlb") {
+        // 大页按整页预留，不归还，只清零
+        memset(data_begin, 0, data_bytes);
+    } else {
+        madvise(data_begin, data_bytes, MADV_DONTNEED);
+    }
+}
@@ -13,52 +13,165 @@ See the Mulan PSL v2 for more details. */
 #include <fcntl.h>
 #include <unistd.h>
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <condition_variable>
 #include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
-#include <shared_mutex>
 
 #include "disk_manager.h"
 #include "errors.h"
 #include "page.h"
+#include "replacer/clock_replacer.h"
+#include "replacer/lru_k_replacer.h"
 #include "replacer/lru_replacer.h"
 #include "replacer/replacer.h"
 
+class LogManager;
+
+/**
+ * @description: 缓冲池的一个分区。PageId经哈希后映射到唯一的分区，
+ * 每个分区独立维护自己的页表、空闲帧链表、置换器和锁，不同分区上的操作互不阻塞
+ */
+struct BufferPoolPartition {
+    std::unordered_map<PageId, frame_id_t, PageIdHash> page_table_; // 帧号和页面号的映射哈希表，用于根据页面的PageId定位该页面的帧编号
+    std::list<frame_id_t> free_list_;   // 本分区中空闲帧编号的链表
+    Replacer *replacer_ = nullptr;      // 本分区的置换策略
+    std::mutex latch_;                  // 保护本分区的页表、空闲链表以及所属帧的元数据
+    std::unordered_set<PageId, PageIdHash> writing_back_;  // 已被淘汰、正在锁外写回磁盘的页面
+    std::condition_variable io_cv_;     // writing_back_中的页面写回完成时通知
+    std::unordered_map<int, std::map<page_id_t, frame_id_t>> file_frames_;  // 每个文件在本分区中常驻的页面，与page_table_同步维护
+    frame_id_t first_frame_id_ = 0;     // 本分区的帧编号为[first_frame_id_, first_frame_id_ + num_frames_)
+    size_t num_frames_ = 0;             // 本分区当前的帧数，只在调整缓冲池大小时改变
+
+    ~BufferPoolPartition() { delete replacer_; }
+
+    /**
+     * @description: 在页表和文件帧索引中记录页面所在的帧
+     */
+    void insert_page(PageId page_id, frame_id_t frame_id) {
+        page_table_[page_id] = frame_id;
+        file_frames_[page_id.fd][page_id.page_no] = frame_id;
+    }
+
+    /**
+     * @description: 帧是否仍属于本分区；调整大小时被移出的帧不能再被访问，调用者需持有latch_
+     */
+    bool is_active_frame(frame_id_t frame_id) const {
+        return frame_id >= first_frame_id_ && frame_id < first_frame_id_ + static_cast<frame_id_t>(num_frames_);
+    }
+
+    /**
+     * @description: 从页表和文件帧索引中删除页面
+     */
+    void erase_page(PageId page_id) {
+        page_table_.erase(page_id);
+        auto it = file_frames_.find(page_id.fd);
+        if (it == file_frames_.end()) return;
+        it->second.erase(page_id.page_no);
+        if (it->second.empty()) file_frames_.erase(it);
+    }
+};
+
+/**
+ * @description: 一个文件的顺序预读状态，用于识别对该文件的顺序访问
+ */
+struct ReadAheadState {
+    page_id_t last_page_no = INVALID_PAGE_ID;   // 最近一次访问的页号
+    page_id_t prefetched_end = 0;               // 已经提交预读的页面的上界（不含）
+    int window = 0;                             // 当前预读窗口的页面数，为0表示尚未识别出顺序访问
+};
+
+/**
+ * @description: 预读的统计信息
+ */
+struct ReadAheadStats {
+    size_t prefetched;  // 预读读入的页面数
+    size_t hits;        // 预读读入的页面在被淘汰之前被访问的次数
+    size_t wasted;      // 预读读入的页面在被访问之前就被淘汰的次数
+};
+
+/*
+BufferAccessStrategy是批量访问策略：大表的顺序扫描、建索引时的全表扫描和批量删除等一次性访问大量页面的操作，
+未命中时不从整个缓冲池中淘汰页面，而是在一个私有的小环形缓冲区中轮转使用帧，避免冲掉其他查询的热点页面。
+帧只能容纳哈希到其所在分区的页面，因此每个分区各有一个环，总容量约为ring_size个帧。
+环中的帧被其他线程固定或已被缓冲池挪作他用时，改为从缓冲池中淘汰一个帧并用它替换环中的这一项。
+*/
+class BufferAccessStrategy {
+   public:
+    /**
+     * @param {size_t} num_partitions 缓冲池的分区数
+     * @param {size_t} ring_size 环形缓冲区的总帧数
+     */
+    BufferAccessStrategy(size_t num_partitions, size_t ring_size)
+        : ring_size_(ring_size), ring_capacity_(std::max<size_t>(1, ring_size / num_partitions)), rings_(num_partitions) {}
+
+    size_t get_ring_size() const { return ring_size_; }
+
+   private:
+    friend class BufferPoolManager;
+
+    struct RingSlot {
+        frame_id_t frame_id;    // 环中的帧
+        PageId page_id;         // 该帧由本策略读入的页面，帧中的页面已不是它时说明帧已被缓冲池挪作他用
+    };
+
+    struct Ring {
+        std::vector<RingSlot> slots;
+        size_t next = 0;        // 下一个被复用的位置
+    };
+
+    size_t ring_size_;
+    size_t ring_capacity_;      // 每个分区的环的容量
+    std::vector<Ring> rings_;   // 每个分区一个环，由对应分区的latch_保护
+};
+
 class BufferPoolManager {
 private:
-    size_t pool_size_;      // buffer_pool中可容纳页面的个数，即帧的个数
-    Page *pages_;           // buffer_pool中的Page对象数组，在构造空间中申请内存空间，在析构函数中释放，大小为BUFFER_POOL_SIZE
-    std::unordered_map<PageId, frame_id_t, PageIdHash> page_table_; // 帧号和页面号的映射哈希表，用于根据页面的PageId定位该页面的帧编号
-    std::list<frame_id_t> free_list_;   // 空闲帧编号的链表
+    std::atomic<size_t> pool_size_;     // buffer_pool中可容纳页面的个数，即帧的个数，可以在运行时调整
+    size_t max_pool_size_;  // 可以调整到的最大帧数
+    Page *pages_;           // buffer_pool中的帧描述符数组，按max_pool_size_预留虚拟地址空间，只有使用中的帧占用物理内存
+    size_t reserved_bytes_; // pages_预留的字节数
+    char *data_arena_;      // 所有帧的数据，第i帧的数据位于data_arena_ + i * PAGE_SIZE，同样按max_pool_size_预留
+    size_t arena_bytes_;    // data_arena_预留的字节数
+    std::string huge_pages_;                // data_arena_实际使用的内存页类型，见BUFFER_POOL_HUGE_PAGES
+    size_t num_partitions_; // 分区个数，第i个分区负责帧[i * partition_capacity_, i * partition_capacity_ + 分区当前的帧数)
+    size_t partition_capacity_;             // 每个分区最多的帧数
+    std::mutex resize_latch_;               // 保证同一时刻只有一个线程调整缓冲池大小
+    std::vector<std::unique_ptr<BufferPoolPartition>> partitions_;
     DiskManager *disk_manager_;
-    Replacer *replacer_;    // buffer_pool的置换策略，当前赛题中为LRU置换策略
-    std::mutex latch_;      // 用于共享数据结构的并发控制
-    std::shared_mutex rw_lock;
+    std::mutex async_latch_;                // 保护num_async_io_
+    std::condition_variable async_cv_;      // 所有异步I/O完成时通知
+    size_t num_async_io_ = 0;               // 已提交、回调尚未执行完的异步I/O个数
+    LogManager *log_manager_ = nullptr;     // 后台刷脏时用于检查WAL顺序，为空时不检查
+    std::thread flusher_;                   // 后台刷脏线程
+    std::mutex flusher_latch_;              // 保护flusher_stop_
+    std::condition_variable flusher_cv_;    // 通知后台刷脏线程退出
+    bool flusher_stop_ = false;
+    std::thread warmer_;                    // 预热线程
+    std::mutex warmer_latch_;               // 保护warmer_stop_
+    std::condition_variable warmer_cv_;     // 通知预热线程退出
+    bool warmer_stop_ = false;
+    std::atomic<size_t> num_warmed_{0};     // 预热提交读入的页面数
+    std::mutex read_ahead_latch_;           // 保护read_ahead_states_
+    std::unordered_map<int, ReadAheadState> read_ahead_states_;    // 每个文件的顺序预读状态
+    std::atomic<size_t> num_prefetched_{0}; // 以下三个为预读的统计信息，含义见ReadAheadStats
+    std::atomic<size_t> num_prefetch_hits_{0};
+    std::atomic<size_t> num_prefetch_wasted_{0};
 
 public:
-    BufferPoolManager(size_t pool_size, DiskManager *disk_manager)
-            : pool_size_(pool_size), disk_manager_(disk_manager) {
-        // 为buffer pool分配一块连续的内存空间
-        pages_ = new Page[pool_size_];
-        // 可以被Replacer改变
-        if (REPLACER_TYPE.compare("LRU"))
-            replacer_ = new LRUReplacer(pool_size_);
-        else if (REPLACER_TYPE.compare("CLOCK"))
-            replacer_ = new LRUReplacer(pool_size_);
-        else {
-            replacer_ = new LRUReplacer(pool_size_);
-        }
-        // 初始化时，所有的page都在free_list_中
-        for (size_t i = 0; i < pool_size_; ++i) {
-            free_list_.emplace_back(static_cast<frame_id_t>(i));  // static_cast转换数据类型
-        }
-    }
+    BufferPoolManager(size_t pool_size, DiskManager *disk_manager, size_t num_partitions = 1,
+                      const std::string &replacer_type = REPLACER_TYPE, size_t max_pool_size = 0,
+                      const std::string &huge_pages = BUFFER_POOL_HUGE_PAGES);
 
-    ~BufferPoolManager() {
-        delete[] pages_;
-        delete replacer_;
-    }
+    ~BufferPoolManager();
 
     /**
      * @description: 将目标页面标记为脏页
@@ -66,8 +179,50 @@ public:
      */
     static void mark_dirty(Page *page) { page->is_dirty_ = true; }
 
+    size_t get_pool_size() const { return pool_size_; }
+
+    size_t get_max_pool_size() const { return max_pool_size_; }
+
+    /**
+     * @description: 获取数据区实际使用的内存页类型，申请大页失败时与构造时指定的不同
+     */
+    const std::string &get_huge_pages() const { return huge_pages_; }
+
+    size_t get_num_partitions() const { return num_partitions_; }
+
+    /**
+     * @description: 设置日志管理器，后台刷脏线程只写回日志已经持久化的页面
+     * @param {LogManager*} log_manager 日志管理器
+     */
+    void set_log_manager(LogManager *log_manager) { log_manager_ = log_manager; }
+
+    /**
+     * @description: 为即将一次性访问num_pages个页面的批量操作创建访问策略
+     * @return {unique_ptr<BufferAccessStrategy>} 访问的页面数不超过缓冲池的1/4时不需要限制，返回nullptr
+     * @param {size_t} num_pages 将要访问的页面数
+     * @param {size_t} ring_size 环形缓冲区的帧数
+     */
+    std::unique_ptr<BufferAccessStrategy> make_access_strategy(size_t num_pages, size_t ring_size) const {
+        if (num_pages <= pool_size_ / 4) return nullptr;
+        return std::make_unique<BufferAccessStrategy>(num_partitions_, ring_size);
+    }
+
+    /**
+     * @description: 获取预读的统计信息
+     */
+    ReadAheadStats get_read_ahead_stats() const {
+        return {num_prefetched_.load(), num_prefetch_hits_.load(), num_prefetch_wasted_.load()};
+    }
+
 public:
-    Page *fetch_page(PageId page_id);
+    Page *fetch_page(PageId page_id, BufferAccessStrategy *strategy = nullptr);
+
+    std::vector<Page *> fetch_pages(const std::vector<PageId> &page_ids);
+
+    size_t prefetch_pages(const std::vector<PageId> &page_ids, BufferAccessStrategy *strategy = nullptr,
+                          bool evict = true);
+
+    void read_ahead(PageId page_id, page_id_t end_page_no, BufferAccessStrategy *strategy = nullptr);
 
     bool unpin_page(PageId page_id, bool is_dirty);
 
@@ -79,8 +234,74 @@ public:
 
     void flush_all_pages(int fd);
 
+    size_t flush_tail_pages(size_t clean_target);
+
+    void start_flusher(size_t clean_target = FLUSHER_CLEAN_TARGET);
+
+    void stop_flusher();
+
+    size_t resize(size_t pool_size);
+
+    std::vector<PageId> get_hot_pages();
+
+    void start_warmup(std::vector<PageId> page_ids, size_t pages_per_second = WARMUP_PAGES_PER_SECOND);
+
+    void stop_warmup();
+
+    /**
+     * @description: 获取预热已提交读入的页面数
+     */
+    size_t get_num_warmed_pages() const { return num_warmed_; }
+
+    static size_t parse_pool_size(const std::string &value);
+
 private:
-    bool find_victim_page(frame_id_t *frame_id);
+    /**
+     * @description: 获取page_id所属的分区
+     */
+    BufferPoolPartition *get_partition(const PageId &page_id) { return partitions_[get_partition_id(page_id)].get(); }
+
+    size_t get_partition_id(const PageId &page_id) const { return PageIdHash()(page_id) % num_partitions_; }
+
+    bool find_victim_page(BufferPoolPartition *partition, frame_id_t *frame_id);
+
+    bool find_victim_page(BufferPoolPartition *partition, frame_id_t *frame_id, PageId page_id,
+                          BufferAccessStrategy *strategy);
+
+    void update_page(BufferPoolPartition *partition, std::unique_lock<std::mutex> &lock, Page *page,
+                     PageId new_page_id, frame_id_t new_frame_id, bool read_from_disk);
+
+    void release_frame(BufferPoolPartition *partition, Page *page, frame_id_t frame_id);
+
+    std::shared_ptr<char[]> prepare_frame(BufferPoolPartition *partition, Page *page, PageId new_page_id,
+                                          frame_id_t new_frame_id);
+
+    void finish_write_back(BufferPoolPartition *partition, PageId old_page_id);
+
+    void recover_failed_write_back(BufferPoolPartition *partition, PageId page_id, const char *data);
+
+    bool reinstall_dirty_page(BufferPoolPartition *partition, PageId page_id, const char *data);
+
+    void finish_frame_io(BufferPoolPartition *partition, Page *page, frame_id_t frame_id, bool ok);
+
+    Page *start_async_fetch(PageId page_id, bool keep_pin, std::vector<AsyncIoRequest> &requests,
+                            BufferAccessStrategy *strategy = nullptr, bool evict = true);
+
+    void finish_async_io();
+
+    void note_access(BufferPoolPartition *partition, Page *page, frame_id_t frame_id);
+
+    void wait_async_io();
+
+    void grow_partition(BufferPoolPartition *partition, size_t num_frames);
+
+    bool shrink_partition(BufferPoolPartition *partition, size_t num_frames);
+
+    bool drain_frame(BufferPoolPartition *partition, frame_id_t frame_id, lsn_t persist_lsn);
+
+    void map_data_arena(const std::string &huge_pages);
+
+    void release_frames(frame_id_t begin, frame_id_t end);
 
-    void update_page(Page *page, PageId new_page_id, frame_id_t new_frame_id);
+    size_t num_free_frames();
 };
\ No newline at end of file
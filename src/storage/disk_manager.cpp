@@ -11,16 +11,93 @@ See the Mulan PSL v2 for more details. */
 #include "storage/disk_manager.h"
 
 #include <assert.h>    // for assert
+#include <limits.h>    // for IOV_MAX
 #include <string.h>    // for memset
 #include <sys/stat.h>  // for stat
 #include <sys/types.h>
 #include <cerrno>
-#include <unistd.h>    // for lseek
+#include <unistd.h>    // for lseek, pread, pwrite
+
+#include <algorithm>
+#include <vector>
 
 #include "defs.h"
 
+/**
+ * @description: 从文件的指定偏移量开始读写，直到处理完全部iov或遇到文件末尾；被信号中断时重试，短读写时继续处理剩余部分
+ * @return {ssize_t} 实际读写的字节数，出错时返回-1
+ * @param {bool} is_write 为true时写入文件，否则读取文件
+ * @param {int} fd 磁盘文件的文件句柄
+ * @param {iovec} *iov 内存缓冲区数组，调用过程中会被修改
+ * @param {int} iovcnt 缓冲区个数
+ * @param {off_t} off 在文件中的起始偏移量
+ */
+static ssize_t positional_io(bool is_write, int fd, struct iovec *iov, int iovcnt, off_t off) {
+    ssize_t total = 0;
+    while (iovcnt > 0) {
+        ssize_t n = is_write ? pwritev(fd, iov, iovcnt, off) : preadv(fd, iov, iovcnt, off);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        if (n == 0) break;
+        total += n;
+        off += n;
+        // 跳过已经完整处理的缓冲区，并调整部分处理的缓冲区
+        while (iovcnt > 0 && (size_t)n >= iov->iov_len) {
+            n -= iov->iov_len;
+            iov++;
+            iovcnt--;
+        }
+        if (iovcnt > 0) {
+            iov->iov_base = (char *)iov->iov_base + n;
+            iov->iov_len -= n;
+        }
+    }
+    return total;
+}
+
 DiskManager::DiskManager() { memset(fd2pageno_, 0, MAX_FD * (sizeof(std::atomic<page_id_t>) / sizeof(char))); }
 
+DiskManager::~DiskManager() = default;
+
+/**
+ * @description: O_DIRECT要求缓冲区地址、文件偏移量和读写长度都按块对齐，这里统一按PAGE_SIZE检查
+ */
+static bool is_aligned(const char *buf, size_t num_bytes, off_t off) {
+    return reinterpret_cast<uintptr_t>(buf) % PAGE_SIZE == 0 && num_bytes % PAGE_SIZE == 0 && off % PAGE_SIZE == 0;
+}
+
+/**
+ * @description: 以O_DIRECT打开的文件上不满足对齐要求的读写，如文件头的部分写入：经由对齐的中转缓冲区读写覆盖该范围的整页，
+ *               写入时先读出整页再修改其中的部分。只用于不在热路径上的少量读写
+ * @return {ssize_t} 实际读写的字节数，出错时返回-1
+ * @param {bool} is_write 为true时写入文件，否则读取文件
+ * @param {int} fd 磁盘文件的文件句柄
+ * @param {iovec} *iov 内存缓冲区
+ * @param {off_t} off 在文件中的起始偏移量
+ */
+static ssize_t unaligned_direct_io(bool is_write, int fd, const struct iovec *iov, off_t off) {
+    off_t begin = off / PAGE_SIZE * PAGE_SIZE;
+    off_t end = (off + iov->iov_len + PAGE_SIZE - 1) / PAGE_SIZE * PAGE_SIZE;
+    auto buf = DiskManager::alloc_page_buffer((end - begin) / PAGE_SIZE);
+    struct iovec bounce = {buf.get(), static_cast<size_t>(end - begin)};
+    ssize_t n = positional_io(false, fd, &bounce, 1, begin);
+    if (n < 0) return -1;
+    if (!is_write) {
+        // 文件末尾之后的部分视为未读到
+        size_t num_read = n > off - begin ? std::min<size_t>(n - (off - begin), iov->iov_len) : 0;
+        memcpy(iov->iov_base, buf.get() + (off - begin), num_read);
+        return num_read;
+    }
+    // 文件末尾之后的部分清零，写入后文件长度按页对齐
+    memset(buf.get() + n, 0, (end - begin) - n);
+    memcpy(buf.get() + (off - begin), iov->iov_base, iov->iov_len);
+    bounce = {buf.get(), static_cast<size_t>(end - begin)};
+    if (positional_io(true, fd, &bounce, 1, begin) != end - begin) return -1;
+    return iov->iov_len;
+}
+
 /**
  * @description: 将数据写入文件的指定磁盘页面中
  * @param {int} fd 磁盘文件的文件句柄
@@ -29,16 +106,14 @@ DiskManager::DiskManager() { memset(fd2pageno_, 0, MAX_FD * (sizeof(std::atomic<
  * @param {int} num_bytes 要写入磁盘的数据大小
  */
 void DiskManager::write_page(int fd, page_id_t page_no, const char *offset, int num_bytes) {
-    // Todo:
-    // 1.lseek()定位到文件头，通过(fd,page_no)可以定位指定页面及其在磁盘文件中的偏移量
-    // 2.调用write()函数
-    // 注意write返回值与num_bytes不等时 throw InternalError("DiskManager::write_page Error");
-//    std::lock_guard lock{ latch_ };
+    // 使用pwrite()在指定偏移量处写入，不修改fd的文件偏移量，多个线程可以并发读写同一文件
+    // 注意写入字节数与num_bytes不等时 throw InternalError("DiskManager::write_page Error");
     auto off =  (__int64_t) 1ll * page_no * num_bytes;
-    lseek(fd, off, SEEK_SET);
-    auto num_writen_bytes = write(fd, offset, num_bytes);
+    struct iovec iov = {const_cast<char *>(offset), (size_t)num_bytes};
+    auto num_writen_bytes = fd2direct_[fd] && !is_aligned(offset, num_bytes, off)
+                                ? unaligned_direct_io(true, fd, &iov, off)
+                                : positional_io(true, fd, &iov, 1, off);
     if (num_writen_bytes != num_bytes) {
-        extern int errno;
         std::cerr << errno << std::endl;
         throw InternalError("DiskManager::write_page Error");
     }
@@ -52,16 +127,14 @@ void DiskManager::write_page(int fd, page_id_t page_no, const char *offset, int
  * @param {int} num_bytes 读取的数据量大小
  */
 void DiskManager::read_page(int fd, page_id_t page_no, char *offset, int num_bytes) {
-    // Todo:
-    // 1.lseek()定位到文件头，通过(fd,page_no)可以定位指定页面及其在磁盘文件中的偏移量
-    // 2.调用read()函数
-    // 注意read返回值与num_bytes不等时，throw InternalError("DiskManager::read_page Error");
-//    std::lock_guard lock{ latch_ };
+    // 使用pread()在指定偏移量处读取，不修改fd的文件偏移量，多个线程可以并发读写同一文件
+    // 注意读取字节数与num_bytes不等时，throw InternalError("DiskManager::read_page Error");
     auto off =  (__int64_t) 1ll * page_no * num_bytes;
-    lseek(fd, off, SEEK_SET);
-    auto num_read_bytes = read(fd, offset, num_bytes);
+    struct iovec iov = {offset, (size_t)num_bytes};
+    auto num_read_bytes = fd2direct_[fd] && !is_aligned(offset, num_bytes, off)
+                              ? unaligned_direct_io(false, fd, &iov, off)
+                              : positional_io(false, fd, &iov, 1, off);
     if (num_read_bytes != num_bytes) {
-        extern int errno;
         std::cerr << "errno: "<< errno << std::endl;
         std::cerr << "read " << num_read_bytes << " / " << num_bytes << std::endl;
         std::cerr << fd << ", " << page_no << std::endl;
@@ -69,6 +142,122 @@ void DiskManager::read_page(int fd, page_id_t page_no, char *offset, int num_byt
     }
 }
 
+/**
+ * @description: 将内存中的多个页面通过一次pwritev()写入文件中连续的页面
+ * @param {int} fd 磁盘文件的文件句柄
+ * @param {page_id_t} start_page_no 写入的第一个页面的page_id
+ * @param {char} *const *pages 要写入的各页面数据，每个大小为PAGE_SIZE，内存中不必连续
+ * @param {int} num_pages 要写入的页面个数
+ */
+void DiskManager::write_pages(int fd, page_id_t start_page_no, const char *const *pages, int num_pages) {
+    if (fd2direct_[fd] && !std::all_of(pages, pages + num_pages, [](const char *page) {
+            return is_aligned(page, PAGE_SIZE, 0);
+        })) {
+        for (int i = 0; i < num_pages; i++) write_page(fd, start_page_no + i, pages[i], PAGE_SIZE);
+        return;
+    }
+    std::vector<struct iovec> iov(num_pages);
+    for (int i = 0; i < num_pages; i++) {
+        iov[i] = {const_cast<char *>(pages[i]), PAGE_SIZE};
+    }
+    auto off = (__int64_t) 1ll * start_page_no * PAGE_SIZE;
+    for (int i = 0; i < num_pages; i += IOV_MAX) {
+        int cnt = std::min(num_pages - i, IOV_MAX);
+        if (positional_io(true, fd, &iov[i], cnt, off + 1ll * i * PAGE_SIZE) != 1ll * cnt * PAGE_SIZE) {
+            std::cerr << errno << std::endl;
+            throw InternalError("DiskManager::write_pages Error");
+        }
+    }
+}
+
+/**
+ * @description: 通过一次preadv()读取文件中连续的多个页面，分别放入各自的内存缓冲区
+ * @param {int} fd 磁盘文件的文件句柄
+ * @param {page_id_t} start_page_no 读取的第一个页面的page_id
+ * @param {char} *const *pages 各页面的目标缓冲区，每个大小为PAGE_SIZE，内存中不必连续
+ * @param {int} num_pages 要读取的页面个数
+ */
+void DiskManager::read_pages(int fd, page_id_t start_page_no, char *const *pages, int num_pages) {
+    if (fd2direct_[fd] && !std::all_of(pages, pages + num_pages, [](const char *page) {
+            return is_aligned(page, PAGE_SIZE, 0);
+        })) {
+        for (int i = 0; i < num_pages; i++) read_page(fd, start_page_no + i, pages[i], PAGE_SIZE);
+        return;
+    }
+    std::vector<struct iovec> iov(num_pages);
+    for (int i = 0; i < num_pages; i++) {
+        iov[i] = {pages[i], PAGE_SIZE};
+    }
+    auto off = (__int64_t) 1ll * start_page_no * PAGE_SIZE;
+    for (int i = 0; i < num_pages; i += IOV_MAX) {
+        int cnt = std::min(num_pages - i, IOV_MAX);
+        if (positional_io(false, fd, &iov[i], cnt, off + 1ll * i * PAGE_SIZE) != 1ll * cnt * PAGE_SIZE) {
+            std::cerr << "errno: " << errno << std::endl;
+            std::cerr << fd << ", " << start_page_no << " + " << i << std::endl;
+            throw InternalError("DiskManager::read_pages Error");
+        }
+    }
+}
+
+/**
+ * @description: 申请按PAGE_SIZE对齐的内存，可直接用于O_DIRECT读写
+ * @return {PageBuffer} 大小为num_pages * PAGE_SIZE的缓冲区，内容未初始化
+ * @param {size_t} num_pages 页面个数
+ */
+PageBuffer DiskManager::alloc_page_buffer(size_t num_pages) {
+    auto buf = static_cast<char *>(aligned_alloc(PAGE_SIZE, num_pages * PAGE_SIZE));
+    if (buf == nullptr) {
+        throw std::bad_alloc();
+    }
+    return PageBuffer(buf);
+}
+
+/**
+ * @description: 启用异步I/O引擎，必须在没有异步请求在途时调用
+ * @param {string} &engine 引擎名称，可以为"io_uring"、"thread_pool"或"none"；io_uring不可用时退化为thread_pool
+ * @param {size_t} queue_depth io_uring的队列深度
+ */
+void DiskManager::enable_async_io(const std::string &engine, size_t queue_depth) {
+    io_engine_.reset();
+    if (engine == "none") return;
+    if (engine == "io_uring") {
+        try {
+            io_engine_ = std::make_unique<IoUringEngine>(queue_depth);
+            return;
+        } catch (UnixError &e) {
+            std::cerr << "io_uring is unavailable (" << e.what() << "), fall back to thread pool" << std::endl;
+        }
+    } else if (engine != "thread_pool") {
+        throw InternalError("unknown async io engine: " + engine);
+    }
+    io_engine_ = std::make_unique<ThreadPoolIoEngine>(this, ASYNC_IO_THREADS);
+}
+
+/**
+ * @description: 提交一批异步页面读写请求；未启用异步I/O时在当前线程中依次同步执行并调用回调
+ * @param {vector<AsyncIoRequest>&} requests 要提交的请求，提交后被清空
+ */
+void DiskManager::submit_async_io(std::vector<AsyncIoRequest> &requests) {
+    if (io_engine_ != nullptr) {
+        io_engine_->submit(requests);
+        return;
+    }
+    for (auto &request : requests) {
+        bool ok = true;
+        try {
+            if (request.is_write) {
+                write_page(request.fd, request.page_no, request.buf, PAGE_SIZE);
+            } else {
+                read_page(request.fd, request.page_no, request.buf, PAGE_SIZE);
+            }
+        } catch (RMDBError &e) {
+            ok = false;
+        }
+        request.callback(ok);
+    }
+    requests.clear();
+}
+
 /**
  * @description: 分配一个新的页号
  * @return {page_id_t} 分配的新页号
@@ -80,11 +269,52 @@ page_id_t DiskManager::allocate_page(int fd) {
         std::cerr << "fd: " << fd << std::endl;
     }
     assert(fd >= 0 && fd < MAX_FD);
-    return fd2pageno_[fd]++;
+    page_id_t page_no = fd2pageno_[fd]++;
+    reserve_pages(fd, page_no + 1);
+    return page_no;
+}
+
+/**
+ * @description: 保证文件在磁盘上至少有num_pages个页面的空间，不足时以FILE_EXTENT_PAGES为单位扩展文件。
+ * 扩展出的空间读取时全为0，因此新页面不必立即写回磁盘，由缓冲池在正常写回时落盘
+ * @param {int} fd 指定文件的文件句柄
+ * @param {page_id_t} num_pages 需要的页面个数
+ */
+void DiskManager::reserve_pages(int fd, page_id_t num_pages) {
+    if (num_pages <= fd2extent_end_[fd]) return;
+    std::lock_guard lock{extent_latch_};
+    page_id_t extent_end = fd2extent_end_[fd];
+    if (num_pages <= extent_end) return;
+    page_id_t new_extent_end = (num_pages + FILE_EXTENT_PAGES - 1) / FILE_EXTENT_PAGES * FILE_EXTENT_PAGES;
+    off_t off = 1ll * extent_end * PAGE_SIZE;
+    off_t len = 1ll * (new_extent_end - extent_end) * PAGE_SIZE;
+    // 不使用FALLOC_FL_KEEP_SIZE，文件大小随之增长，崩溃后读取尚未写回的新页面得到全0页面
+    if (fallocate(fd, 0, off, len) != 0) {
+        if (errno != EOPNOTSUPP) throw UnixError();
+        // 文件系统不支持fallocate时，由posix_fallocate写入0来扩展文件
+        int err = posix_fallocate(fd, off, len);
+        if (err != 0) {
+            errno = err;
+            throw UnixError();
+        }
+    }
+    fd2extent_end_[fd] = new_extent_end;
 }
 
 void DiskManager::deallocate_page(__attribute__((unused)) page_id_t page_id) {}
 
+/**
+ * @description: 归还刚刚通过allocate_page分配的页号，仅当其仍是文件中最后分配的页面时才能归还
+ * @return {bool} 归还成功返回true，若之后已有其他页面被分配则返回false
+ * @param {int} fd 指定文件的文件句柄
+ * @param {page_id_t} page_no 要归还的页号
+ */
+bool DiskManager::deallocate_last_page(int fd, page_id_t page_no) {
+    assert(fd >= 0 && fd < MAX_FD);
+    page_id_t expected = page_no + 1;
+    return fd2pageno_[fd].compare_exchange_strong(expected, page_no);
+}
+
 bool DiskManager::is_dir(const std::string& path) {
     struct stat st;
     return stat(path.c_str(), &st) == 0 && S_ISDIR(st.st_mode);
@@ -142,6 +372,7 @@ void DiskManager::destroy_file(const std::string &path) {
     // Todo:
     // 调用unlink()函数
     // 注意不能删除未关闭的文件
+    std::lock_guard lock{ latch_ };
     if (path2fd_.count(path)) {
         throw FileNotClosedError(path);
     }
@@ -165,13 +396,25 @@ int DiskManager::open_file(const std::string &path) {
     // Todo:
     // 调用open()函数，使用O_RDWR模式
     // 注意不能重复打开相同文件，并且需要更新文件打开列表
+    std::lock_guard lock{ latch_ };
     if (path2fd_.count(path)) {
         return this->path2fd_[path];
     }
-    auto fd = open(path.c_str(), O_RDWR);
+    // 日志文件按任意长度追加写，始终经过页缓存
+    bool direct = direct_io_ && path != LOG_FILE_NAME;
+    auto fd = open(path.c_str(), O_RDWR | (direct ? O_DIRECT : 0));
+    if (fd < 0 && direct && errno == EINVAL) {
+        // 文件系统不支持O_DIRECT（如tmpfs），退化为经过页缓存的I/O
+        direct = false;
+        fd = open(path.c_str(), O_RDWR);
+    }
     if (fd < 0) {
         throw FileNotFoundError(path);
     }
+    fd2direct_[fd] = direct;
+    struct stat stat_buf;
+    fstat(fd, &stat_buf);
+    fd2extent_end_[fd] = (stat_buf.st_size + PAGE_SIZE - 1) / PAGE_SIZE;
     fd2path_[fd] = path;
     path2fd_[path] = fd;
     return fd;
@@ -185,11 +428,13 @@ void DiskManager::close_file(int fd) {
     // Todo:
     // 调用close()函数
     // 注意不能关闭未打开的文件，并且需要更新文件打开列表
+    std::lock_guard lock{ latch_ };
     if (!fd2path_.count(fd)) {
         // 未打开文件，报错
         throw FileNotOpenError(fd);;
     }
     auto path = this->fd2path_[fd];
+    fd2direct_[fd] = false;
     close(fd);
     path2fd_.erase(path);
     fd2path_.erase(fd);
@@ -213,6 +458,7 @@ int DiskManager::get_file_size(const std::string &file_name) {
  * @param {int} fd 文件句柄
  */
 std::string DiskManager::get_file_name(int fd) {
+    std::lock_guard lock{ latch_ };
     if (!fd2path_.count(fd)) {
         throw FileNotOpenError(fd);
     }
@@ -225,10 +471,14 @@ std::string DiskManager::get_file_name(int fd) {
  * @param {string} &file_name 文件名
  */
 int DiskManager::get_file_fd(const std::string &file_name) {
-    if (!path2fd_.count(file_name)) {
-        return open_file(file_name);
+    {
+        std::lock_guard lock{ latch_ };
+        auto it = path2fd_.find(file_name);
+        if (it != path2fd_.end()) {
+            return it->second;
+        }
     }
-    return path2fd_[file_name];
+    return open_file(file_name);
 }
 
 
@@ -252,8 +502,7 @@ int DiskManager::read_log(char *log_data, int size, int offset) {
 
     size = std::min(size, file_size - offset);
     if(size == 0) return 0;
-    lseek(log_fd_, offset, SEEK_SET);
-    ssize_t bytes_read = read(log_fd_, log_data, size);
+    ssize_t bytes_read = pread(log_fd_, log_data, size, offset);
     assert(bytes_read == size);
     return bytes_read;
 }
@@ -276,4 +525,13 @@ void DiskManager::write_log(char *log_data, int size) {
     if (bytes_write != size) {
         throw UnixError();
     }
+}
+
+/**
+ * @description: 将已写入日志文件的内容同步到磁盘，日志文件还未打开时什么都不做
+ */
+void DiskManager::sync_log() {
+    if (log_fd_ != -1 && fdatasync(log_fd_) != 0) {
+        throw UnixError();
+    }
 }
\ No newline at end of file
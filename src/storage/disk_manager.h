@@ -12,16 +12,29 @@ See the Mulan PSL v2 for more details. */
 
 #include <fcntl.h>
 #include <sys/stat.h>
+#include <sys/uio.h>
 #include <unistd.h>
 
 #include <atomic>
 #include <fstream>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 
 #include "common/config.h"
 #include "errors.h"
+#include "storage/async_io.h"
+
+/**
+ * @description: 释放alloc_page_buffer申请的内存
+ */
+struct PageBufferDeleter {
+    void operator()(char *buf) const { free(buf); }
+};
+
+using PageBuffer = std::unique_ptr<char[], PageBufferDeleter>;
 
 /**
  * @description: DiskManager的作用主要是根据上层的需要对磁盘文件进行操作
@@ -30,16 +43,56 @@ class DiskManager {
 public:
     explicit DiskManager();
 
-    ~DiskManager() = default;
+    ~DiskManager();
 
     void write_page(int fd, page_id_t page_no, const char *offset, int num_bytes);
 
     void read_page(int fd, page_id_t page_no, char *offset, int num_bytes);
 
+    void write_pages(int fd, page_id_t start_page_no, const char *const *pages, int num_pages);
+
+    void read_pages(int fd, page_id_t start_page_no, char *const *pages, int num_pages);
+
+    static PageBuffer alloc_page_buffer(size_t num_pages = 1);
+
+    /*直接I/O*/
+    /**
+     * @description: 设置之后打开的表文件和索引文件是否使用O_DIRECT，已打开的文件不受影响
+     */
+    void set_direct_io(bool direct_io) { direct_io_ = direct_io; }
+
+    bool is_direct_io() const { return direct_io_; }
+
+    /**
+     * @description: 文件是否以O_DIRECT打开；文件系统不支持O_DIRECT时即使开启了直接I/O也返回false
+     * @param {int} fd 文件对应的文件句柄
+     */
+    bool is_direct_fd(int fd) { return fd2direct_[fd]; }
+
+    /*异步I/O*/
+    void enable_async_io(const std::string &engine = ASYNC_IO_ENGINE, size_t queue_depth = ASYNC_IO_QUEUE_DEPTH);
+
+    void submit_async_io(std::vector<AsyncIoRequest> &requests);
+
+    /**
+     * @description: 获得当前使用的异步I/O引擎名称，未启用异步I/O时返回"none"
+     */
+    const char *get_async_io_engine() const { return io_engine_ == nullptr ? "none" : io_engine_->name(); }
+
     page_id_t allocate_page(int fd);
 
     void deallocate_page(page_id_t page_id);
 
+    bool deallocate_last_page(int fd, page_id_t page_no);
+
+    /**
+     * @description: 获得文件在磁盘上已预分配的页面个数
+     * @param {int} fd 文件对应的文件句柄
+     */
+    page_id_t get_fd2extent_end(int fd) { return fd2extent_end_[fd]; }
+
+    void reserve_pages(int fd, page_id_t num_pages);
+
     /*目录操作*/
     bool is_dir(const std::string &path);
 
@@ -69,6 +122,8 @@ public:
 
     void write_log(char *log_data, int size);
 
+    void sync_log();
+
     void SetLogFd(int log_fd) { log_fd_ = log_fd; }
 
     int GetLogFd() { return log_fd_; }
@@ -93,8 +148,13 @@ private:
     // 文件打开列表，用于记录文件是否被打开
     std::unordered_map<std::string, int> path2fd_;  //<Page文件磁盘路径,Page fd>哈希表
     std::unordered_map<int, std::string> fd2path_;  //<Page fd,Page文件磁盘路径>哈希表
-//    std::mutex latch_;
+    std::mutex latch_;                              // 保护path2fd_和fd2path_；页面读写使用pread/pwrite，无需加锁
 
+    std::unique_ptr<AsyncIoEngine> io_engine_;    // 异步I/O引擎，为空时异步请求在提交线程中同步执行
     int log_fd_ = -1;                             // WAL日志文件的文件句柄，默认为-1，代表未打开日志文件
     std::atomic<page_id_t> fd2pageno_[MAX_FD]{};  // 文件中已经分配的页面个数，初始值为0
+    std::atomic<page_id_t> fd2extent_end_[MAX_FD]{};  // 文件在磁盘上已预分配的页面个数，新页面落在其中时无需扩展文件
+    std::mutex extent_latch_;                     // 保证同一时刻只有一个线程扩展文件
+    bool direct_io_ = DIRECT_IO;                  // 打开表文件和索引文件时是否使用O_DIRECT
+    std::atomic<bool> fd2direct_[MAX_FD]{};       // 文件是否以O_DIRECT打开，此时读写的缓冲区、偏移量和长度都需按块对齐
 };
\ No newline at end of file
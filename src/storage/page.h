@@ -10,6 +10,8 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include <condition_variable>
+
 #include "common/config.h"
 
 /**
@@ -54,7 +56,10 @@ class Page {
 
 public:
 
-    Page() { reset_memory(); }
+    /**
+     * @description: 创建帧描述符，data指向缓冲池数据区中该帧的PAGE_SIZE字节，数据区由缓冲池管理并已清零
+     */
+    explicit Page(char *data) : data_(data) {}
 
     ~Page() = default;
 
@@ -78,14 +83,26 @@ private:
     /** page的唯一标识符 */
     PageId id_;
 
-    /** The actual data that is stored within a page.
-     *  该页面在bufferPool中的偏移地址
-     */
-    char data_[PAGE_SIZE] = {};
+    /** The pin count of this page. */
+    int pin_count_ = 0;
 
     /** 脏页判断 */
     bool is_dirty_ = false;
 
-    /** The pin count of this page. */
-    int pin_count_ = 0;
+    /** 帧正在进行磁盘I/O（读入新页面），此时data_中的内容无效 */
+    bool io_in_progress_ = false;
+
+    /** 后台刷脏线程正在锁外写回该页面，期间其他写回需等待，避免较旧的内容覆盖较新的内容 */
+    bool flushing_ = false;
+
+    /** 页面由预读读入，且之后尚未被访问过，用于统计预读的命中与浪费 */
+    bool prefetched_ = false;
+
+    /** The actual data that is stored within a page.
+     *  指向缓冲池数据区中该帧的数据，地址按PAGE_SIZE对齐；元数据与数据分开存放，扫描帧的元数据时不会访问数据
+     */
+    char *data_;
+
+    /** 在该帧上等待I/O完成的线程使用的条件变量，与所在分区的latch_配合使用 */
+    std::condition_variable io_cv_;
 };
\ No newline at end of file
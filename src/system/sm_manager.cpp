@@ -98,10 +98,12 @@ void SmManager::open_db(const std::string &db_name) {
     for (auto &entry: db_.tabs_) {
         auto &tab = entry.second;
         fhs_.emplace(tab.name, rm_manager_->open_file(tab.name));
+        fhs_.at(tab.name)->set_oid(tab.oid);
         for (const auto &index: tab.indexes) {
             auto idx_name = ix_manager_->get_index_name(tab.name, index.cols);
             assert(ihs_.count(idx_name) == 0);
             ihs_.emplace(idx_name, ix_manager_->open_index(tab.name, index.cols));
+            ihs_.at(idx_name)->set_oid(index.oid);
         }
     }
 }
@@ -115,13 +117,71 @@ void SmManager::flush_meta() {
     ofs << db_;
 }
 
+/**
+ * @description: 把缓冲池中属于当前数据库的常驻页面按热度顺序写入预热快照，每行为"文件名 页号"，
+ *               最热的页面在前。文件句柄在重启后会变化，因此按文件名记录
+ */
+void SmManager::save_warmup_snapshot() {
+    std::unordered_map<int, std::string> fd2name;
+    for (auto &entry: fhs_) {
+        fd2name.emplace(entry.second->GetFd(), entry.first);
+    }
+    for (auto &entry: ihs_) {
+        fd2name.emplace(entry.second->get_fd(), entry.first);
+    }
+    std::ofstream ofs(WARMUP_SNAPSHOT_NAME);
+    for (auto &page_id: buffer_pool_manager_->get_hot_pages()) {
+        auto it = fd2name.find(page_id.fd);
+        if (it != fd2name.end()) {
+            ofs << it->second << ' ' << page_id.page_no << '\n';
+        }
+    }
+}
+
+/**
+ * @description: 读取上次正常关闭时保存的预热快照，在后台按热度顺序预读其中的页面。需要在恢复完成之后调用。
+ *               快照读取后即被删除，异常退出后重启不会使用过期的快照；已不存在的文件和超出文件大小的页面被跳过，
+ *               最多预读缓冲池大小个页面
+ */
+void SmManager::start_warmup() {
+    std::ifstream ifs(WARMUP_SNAPSHOT_NAME);
+    if (!ifs) {
+        return;
+    }
+    std::unordered_map<std::string, int> name2fd;
+    for (auto &entry: fhs_) {
+        name2fd.emplace(entry.first, entry.second->GetFd());
+    }
+    for (auto &entry: ihs_) {
+        name2fd.emplace(entry.first, entry.second->get_fd());
+    }
+    std::vector<PageId> page_ids;
+    std::string name;
+    page_id_t page_no;
+    while (page_ids.size() < buffer_pool_manager_->get_pool_size() && ifs >> name >> page_no) {
+        auto it = name2fd.find(name);
+        if (it == name2fd.end() || page_no < 0 || page_no >= disk_manager_->get_fd2pageno(it->second)) {
+            continue;
+        }
+        page_ids.push_back(PageId{it->second, page_no});
+    }
+    ifs.close();
+    unlink(WARMUP_SNAPSHOT_NAME.c_str());
+    if (!page_ids.empty()) {
+        buffer_pool_manager_->start_warmup(std::move(page_ids));
+    }
+}
+
 /**
  * @description: 关闭数据库并把数据落盘
  */
 void SmManager::close_db() {
     flush_meta();
+    buffer_pool_manager_->stop_warmup();
+    save_warmup_snapshot();
     db_.name_.clear();
     db_.tabs_.clear();
+    db_.next_oid_ = INVALID_OID + 1;
     for (auto &entry: fhs_) {
         rm_manager_->close_file(entry.second.get());
     }
@@ -196,8 +256,10 @@ void SmManager::create_table(const std::string &tab_name, const std::vector<ColD
 
     // Create table meta
     int curr_offset = 0;
+    std::vector<RmVarField> var_fields;
     TabMeta tab;
     tab.name = tab_name;
+    tab.oid = db_.alloc_oid();
     for (auto &col_def: col_defs) {
         ColMeta col = {.tab_name = tab_name,
                 .name = col_def.name,
@@ -205,15 +267,17 @@ void SmManager::create_table(const std::string &tab_name, const std::vector<ColD
                 .len = col_def.len,
                 .offset = curr_offset,
                 .index = false};
+        if (col_def.var_len) var_fields.push_back(RmVarField{curr_offset, col_def.len});
         curr_offset += col_def.len;
         tab.cols.push_back(col);
     }
     // Create & open record file
     int record_size = curr_offset;  // record_size就是col meta所占的大小（表的元数据也是以记录的形式进行存储的）
-    rm_manager_->create_file(tab_name, record_size);
+    rm_manager_->create_file(tab_name, record_size, var_fields);
     db_.tabs_[tab_name] = tab;
     fhs_[tab_name] = rm_manager_->open_file(tab_name);
     fhs_.emplace(tab_name, rm_manager_->open_file(tab_name));
+    fhs_.at(tab_name)->set_oid(tab.oid);
 
     flush_meta();
 }
@@ -303,23 +367,33 @@ void SmManager::create_index(const std::string &tab_name, const std::vector<std:
     ix_manager_->create_index(tab_name, cols);  // 这里调用了
     // Open index file
     auto ih = ix_manager_->open_index(tab_name, cols);
+    // 先分配对象号，填充索引时写入的日志才能在恢复时找到这个索引
+    oid_t oid = db_.alloc_oid();
+    ih->set_oid(oid);
     // 将所有已经存在的数据写入索引文件
     auto file_handle = fhs_.at(tab_name).get();
+    auto strategy = file_handle->make_access_strategy(BULK_READ_RING_SIZE);
     char *key = new char[len];
-    for (RmScan rm_scan(file_handle); !rm_scan.is_end(); rm_scan.next()) {
-        auto rec = file_handle->get_record(rm_scan.rid(), context);  // rid是record的存储位置，作为value插入到索引里
-        int key_offset = 0;
-        memset(key, 0, len);
-        for (auto &col: cols) {
-            memmove(key + key_offset, rec->data + col.offset, col.len);
-            key_offset += col.len;
+    // 按页面读取记录，每个页面只访问一次缓冲池；建索引时表上已加锁，不需要再加记录锁
+    RmPageScan page_scan(file_handle, strategy.get());
+    RmPageBatch batch;
+    while (page_scan.next_page(&batch)) {
+        for (size_t i = 0; i < batch.size(); i++) {
+            auto rec = batch.record(i);
+            int key_offset = 0;
+            memset(key, 0, len);
+            for (auto &col: cols) {
+                memmove(key + key_offset, rec + col.offset, col.len);
+                key_offset += col.len;
+            }
+            // record data里以各个属性的offset进行分隔，属性的长度为col len，record里面每个属性的数据作为key插入索引里
+            ih->insert_entry(key, batch.rid(i), context);  // rid是record的存储位置，作为value插入到索引里
         }
-        // record data里以各个属性的offset进行分隔，属性的长度为col len，record里面每个属性的数据作为key插入索引里
-        ih->insert_entry(key, rm_scan.rid(), context);
     }
     ih->flush();
     delete[] key;
     IndexMeta idx_meta;
+    idx_meta.oid = oid;
     idx_meta.cols = cols;
     idx_meta.col_tot_len = len;
     idx_meta.col_num = (int) col_names.size();
@@ -403,6 +477,44 @@ void SmManager::drop_index(const std::string &tab_name, const std::vector<ColMet
     }
 }
 
+/**
+ * @description: 在运行时修改配置项，目前支持buffer_pool_size
+ * @param {string&} knob_name 配置项名称
+ * @param {string&} value 配置项的值，buffer_pool_size的值为帧数或带K、M、G单位的字节数
+ * @param {Context*} context
+ */
+void SmManager::set_knob(const std::string &knob_name, const std::string &value, Context *context) {
+    if (knob_name != "buffer_pool_size") {
+        throw InternalError("unknown knob: " + knob_name);
+    }
+    size_t pool_size = BufferPoolManager::parse_pool_size(value);
+    size_t actual = buffer_pool_manager_->resize(pool_size);
+    if (actual != pool_size) {
+        throw InternalError("buffer pool only shrank to " + std::to_string(actual) +
+                            " pages, the remaining frames are pinned or dirty");
+    }
+}
+
+/**
+ * @description: 根据目录中的对象ID获取表的数据文件，用于恢复时解析日志中的对象ID
+ * @return {RmFileHandle*} 表的数据文件，表已被删除时返回nullptr
+ * @param {oid_t} oid 表的对象ID
+ */
+RmFileHandle *SmManager::get_file_handle(oid_t oid) {
+    auto tab = db_.get_table(oid);
+    return tab == nullptr ? nullptr : fhs_.at(tab->name).get();
+}
+
+/**
+ * @description: 根据目录中的对象ID获取索引文件，用于恢复时解析日志中的对象ID
+ * @return {IxIndexHandle*} 索引文件，索引已被删除时返回nullptr
+ * @param {oid_t} oid 索引的对象ID
+ */
+IxIndexHandle *SmManager::get_index_handle(oid_t oid) {
+    auto index = db_.get_index(oid);
+    return index == nullptr ? nullptr : ihs_.at(ix_manager_->get_index_name(index->tab_name, index->cols)).get();
+}
+
 //insert -> delete
 void SmManager::rollback_insert(const std::string &tab_name, const Rid &rid, Context *context) {
     auto tab = db_.get_table(tab_name);
@@ -22,6 +22,7 @@ struct ColDef {
     std::string name;  // Column name
     ColType type;      // Type of column
     int len;           // Length of column
+    bool var_len = false;   // 是否为变长字段（VARCHAR），表中有变长字段时数据文件使用槽页格式
 };
 
 /* 系统管理器，负责元数据管理和DDL语句的执行 */
@@ -64,6 +65,10 @@ public:
 
     void flush_meta();
 
+    void save_warmup_snapshot();
+
+    void start_warmup();
+
     void show_tables(Context *context);
 
     void desc_table(const std::string &tab_name, Context *context);
@@ -80,6 +85,12 @@ public:
 
     void drop_index(const std::string &tab_name, const std::vector<ColMeta> &col_names, Context *context);
 
+    void set_knob(const std::string &knob_name, const std::string &value, Context *context);
+
+    RmFileHandle *get_file_handle(oid_t oid);
+
+    IxIndexHandle *get_index_handle(oid_t oid);
+
     // Transaction rollback management
     /**
      * @brief rollback the insert operation
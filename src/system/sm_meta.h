@@ -42,12 +42,13 @@ struct ColMeta {
 /* 索引元数据 */
 struct IndexMeta {
     std::string tab_name;           // 索引所属表名称
+    oid_t oid = INVALID_OID;        // 索引的对象ID，日志中用它标识索引
     int col_tot_len;                // 索引字段长度总和
     int col_num;                    // 索引字段数量
     std::vector<ColMeta> cols;      // 索引包含的字段
 
     friend std::ostream &operator<<(std::ostream &os, const IndexMeta &index) {
-        os << index.tab_name << " " << index.col_tot_len << " " << index.col_num;
+        os << index.tab_name << " " << index.oid << " " << index.col_tot_len << " " << index.col_num;
         for (auto &col: index.cols) {
             os << "\n" << col;
         }
@@ -55,7 +56,7 @@ struct IndexMeta {
     }
 
     friend std::istream &operator>>(std::istream &is, IndexMeta &index) {
-        is >> index.tab_name >> index.col_tot_len >> index.col_num;
+        is >> index.tab_name >> index.oid >> index.col_tot_len >> index.col_num;
         for (int i = 0; i < index.col_num; ++i) {
             ColMeta col;
             is >> col;
@@ -68,6 +69,7 @@ struct IndexMeta {
 /* 表元数据 */
 struct TabMeta {
     std::string name;                   // 表名称
+    oid_t oid = INVALID_OID;            // 表的对象ID，日志中用它标识表
     std::vector<ColMeta> cols;          // 表包含的字段
     std::vector<IndexMeta> indexes;     // 表上建立的索引
 
@@ -75,6 +77,7 @@ struct TabMeta {
 
     TabMeta(const TabMeta &other) {
         name = other.name;
+        oid = other.oid;
         cols = other.cols;
         indexes = other.indexes;
     }
@@ -150,7 +153,7 @@ struct TabMeta {
     }
 
     friend std::ostream &operator<<(std::ostream &os, const TabMeta &tab) {
-        os << tab.name << '\n' << tab.cols.size() << '\n';
+        os << tab.name << ' ' << tab.oid << '\n' << tab.cols.size() << '\n';
         for (auto &col: tab.cols) {
             os << col << '\n';  // col是ColMeta类型，然后调用重载的ColMeta的操作符<<
         }
@@ -163,7 +166,7 @@ struct TabMeta {
 
     friend std::istream &operator>>(std::istream &is, TabMeta &tab) {
         size_t n;
-        is >> tab.name >> n;
+        is >> tab.name >> tab.oid >> n;
         for (size_t i = 0; i < n; i++) {
             ColMeta col;
             is >> col;
@@ -187,6 +190,7 @@ class DbMeta {
 private:
     std::string name_;                      // 数据库名称
     std::map<std::string, TabMeta> tabs_;   // 数据库中包含的表
+    oid_t next_oid_ = INVALID_OID + 1;      // 下一个分配给表或索引的对象ID，对象删除后其ID不再复用
 
 public:
     // DbMeta(std::string name) : name_(name) {}
@@ -208,9 +212,33 @@ public:
         return pos->second;
     }
 
+    /* 为新建的表或索引分配对象ID */
+    oid_t alloc_oid() {
+        if (next_oid_ == INVALID_OID) throw InternalError("DbMeta::alloc_oid: object ids exhausted");
+        return next_oid_++;
+    }
+
+    /* 获取对象ID为oid的表的元数据，不存在时返回nullptr */
+    const TabMeta *get_table(oid_t oid) const {
+        for (auto &entry: tabs_) {
+            if (entry.second.oid == oid) return &entry.second;
+        }
+        return nullptr;
+    }
+
+    /* 获取对象ID为oid的索引的元数据，不存在时返回nullptr */
+    const IndexMeta *get_index(oid_t oid) const {
+        for (auto &entry: tabs_) {
+            for (auto &index: entry.second.indexes) {
+                if (index.oid == oid) return &index;
+            }
+        }
+        return nullptr;
+    }
+
     // 重载操作符 <<
     friend std::ostream &operator<<(std::ostream &os, const DbMeta &db_meta) {
-        os << db_meta.name_ << '\n' << db_meta.tabs_.size() << '\n';
+        os << db_meta.name_ << ' ' << db_meta.next_oid_ << '\n' << db_meta.tabs_.size() << '\n';
         for (auto &entry: db_meta.tabs_) {
             os << entry.second << '\n';
         }
@@ -219,7 +247,7 @@ public:
 
     friend std::istream &operator>>(std::istream &is, DbMeta &db_meta) {
         size_t n;
-        is >> db_meta.name_ >> n;
+        is >> db_meta.name_ >> db_meta.next_oid_ >> n;
         for (size_t i = 0; i < n; i++) {
             TabMeta tab;
             is >> tab;
@@ -59,8 +59,9 @@ void TransactionManager::commit(Transaction *txn, LogManager *log_manager) {
     auto lsn = log_manager->add_log_to_buffer(&commit_rec);
     txn->set_prev_lsn(lsn);
     auto end_rec = EndLogRecord(txn->get_transaction_id(), txn->get_prev_lsn());
-    log_manager->add_log_to_buffer(&end_rec);
-    log_manager->flush_log_to_disk();
+    lsn = log_manager->add_log_to_buffer(&end_rec);
+    // 与其他同时提交的事务一起刷盘
+    log_manager->wait_for_flush(lsn);
 
     unpin_pages(txn);
 
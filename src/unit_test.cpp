@@ -13,12 +13,20 @@ See the Mulan PSL v2 for more details. */
 #define private public
 
 #include "record/rm.h"
+#include "recovery/log_manager.h"
+#include "recovery/log_recovery.h"
 #include "storage/buffer_pool_manager.h"
+#include "transaction/transaction_manager.h"
+
+#include <fcntl.h>     // for open
+#include <sys/mman.h>  // for mincore
+#include <unistd.h>    // for truncate
 
 #undef private
 
 #include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
@@ -27,14 +35,18 @@ See the Mulan PSL v2 for more details. */
 #include <memory>
 #include <random>
 #include <set>
+#include <sstream>
 #include <string>
 #include <thread>  // NOLINT
 #include <unordered_map>
 #include <vector>
 
 #include "gtest/gtest.h"
+#include "replacer/clock_replacer.h"
+#include "replacer/lru_k_replacer.h"
 #include "replacer/lru_replacer.h"
 #include "storage/disk_manager.h"
+#include "system/sm_meta.h"
 
 const std::string TEST_DB_NAME = "BufferPoolManagerTest_db";  // 以数据库名作为根目录
 const std::string TEST_FILE_NAME = "basic";                   // 测试文件的名字
@@ -231,6 +243,150 @@ TEST(LRUReplacerTest, SampleTest) {
     EXPECT_EQ(4, value);
 }
 
+TEST(LRUKReplacerTest, SampleTest) {
+    LRUKReplacer lru_k_replacer(7, 2);
+
+    // Scenario: frames 1~5 are accessed once, frame 6 is accessed twice.
+    for (int frame_id = 1; frame_id <= 6; frame_id++) {
+        lru_k_replacer.pin(frame_id);
+        lru_k_replacer.unpin(frame_id);
+    }
+    lru_k_replacer.pin(6);
+    lru_k_replacer.unpin(6);
+    EXPECT_EQ(6, lru_k_replacer.Size());
+
+    // Scenario: frames with less than k accesses have infinite backward k-distance and go first, oldest first.
+    int value;
+    lru_k_replacer.victim(&value);
+    EXPECT_EQ(1, value);
+    lru_k_replacer.victim(&value);
+    EXPECT_EQ(2, value);
+
+    // Scenario: a second access of frame 3 moves it behind the frames that are accessed only once.
+    lru_k_replacer.pin(3);
+    lru_k_replacer.unpin(3);
+    lru_k_replacer.victim(&value);
+    EXPECT_EQ(4, value);
+    lru_k_replacer.victim(&value);
+    EXPECT_EQ(5, value);
+
+    // Scenario: among frames with k accesses, the one with the earliest k-th most recent access goes first.
+    lru_k_replacer.pin(6);
+    EXPECT_EQ(1, lru_k_replacer.Size());
+    lru_k_replacer.victim(&value);
+    EXPECT_EQ(3, value);
+    EXPECT_FALSE(lru_k_replacer.victim(&value));
+
+    // Scenario: repeated accesses to the same frame without other accesses in between count only once.
+    lru_k_replacer.unpin(6);
+    for (int i = 0; i < 10; i++) {
+        lru_k_replacer.pin(1);
+        lru_k_replacer.unpin(1);
+    }
+    lru_k_replacer.victim(&value);
+    EXPECT_EQ(1, value);
+    lru_k_replacer.victim(&value);
+    EXPECT_EQ(6, value);
+    EXPECT_EQ(0, lru_k_replacer.Size());
+}
+
+TEST(ClockReplacerTest, SampleTest) {
+    ClockReplacer clock_replacer(7, 10);
+
+    // Scenario: unpin six frames, their reference bits are set.
+    for (int frame_id = 11; frame_id <= 16; frame_id++) {
+        clock_replacer.unpin(frame_id);
+    }
+    clock_replacer.unpin(11);
+    EXPECT_EQ(6, clock_replacer.Size());
+
+    // Scenario: the first sweep clears all reference bits, then frames are evicted in clock order.
+    int value;
+    clock_replacer.victim(&value);
+    EXPECT_EQ(11, value);
+    clock_replacer.victim(&value);
+    EXPECT_EQ(12, value);
+
+    // Scenario: pinned frames are skipped, a re-referenced frame gets a second chance.
+    clock_replacer.pin(13);
+    clock_replacer.pin(14);
+    clock_replacer.unpin(14);
+    EXPECT_EQ(3, clock_replacer.Size());
+    clock_replacer.victim(&value);
+    EXPECT_EQ(15, value);
+    clock_replacer.victim(&value);
+    EXPECT_EQ(16, value);
+    clock_replacer.victim(&value);
+    EXPECT_EQ(14, value);
+    EXPECT_FALSE(clock_replacer.victim(&value));
+}
+
+/**
+ * 对不同的置换策略模拟同一个访问序列并统计命中率：对少量热点页面的随机访问中穿插对大量冷页面的顺序扫描
+ */
+TEST(ReplacerTest, HitRatioBenchmark) {
+    const size_t pool_size = 256;
+    const int num_hot_pages = 192;
+    const int num_cold_pages = 4096;
+    const int num_rounds = 20;
+    const int hot_accesses_per_round = 2000;
+
+    auto run = [&](Replacer *replacer) {
+        std::unordered_map<int, frame_id_t> page_table;
+        std::vector<int> frame_to_page(pool_size, -1);
+        std::list<frame_id_t> free_list;
+        for (size_t i = 0; i < pool_size; i++) free_list.push_back(static_cast<frame_id_t>(i));
+        size_t hits = 0, hot_hits = 0, accesses = 0, hot_accesses = 0;
+
+        auto access = [&](int page_no, bool hot) {
+            accesses++;
+            hot_accesses += hot;
+            auto it = page_table.find(page_no);
+            frame_id_t frame_id;
+            if (it != page_table.end()) {
+                hits++;
+                hot_hits += hot;
+                frame_id = it->second;
+            } else {
+                if (!free_list.empty()) {
+                    frame_id = free_list.front();
+                    free_list.pop_front();
+                } else {
+                    ASSERT_TRUE(replacer->victim(&frame_id));
+                    page_table.erase(frame_to_page[frame_id]);
+                }
+                page_table[page_no] = frame_id;
+                frame_to_page[frame_id] = page_no;
+            }
+            replacer->pin(frame_id);
+            replacer->unpin(frame_id);
+        };
+
+        std::mt19937 rng(0);
+        for (int round = 0; round < num_rounds; round++) {
+            for (int i = 0; i < hot_accesses_per_round; i++) access(static_cast<int>(rng() % num_hot_pages), true);
+            for (int page_no = 0; page_no < num_cold_pages; page_no++) access(num_hot_pages + page_no, false);
+        }
+        std::cout << "hit ratio: " << 1.0 * hits / accesses << ", hot page hit ratio: " << 1.0 * hot_hits / hot_accesses
+                  << std::endl;
+        return 1.0 * hot_hits / hot_accesses;
+    };
+
+    std::cout << "LRU    ";
+    LRUReplacer lru_replacer(pool_size);
+    double lru = run(&lru_replacer);
+    std::cout << "LRU-K  ";
+    LRUKReplacer lru_k_replacer(pool_size, 2);
+    double lru_k = run(&lru_k_replacer);
+    std::cout << "CLOCK  ";
+    ClockReplacer clock_replacer(pool_size);
+    double clock = run(&clock_replacer);
+
+    // 顺序扫描会冲掉LRU和CLOCK中的热点页面，LRU-K能够把热点页面留在缓冲池中
+    EXPECT_GT(lru_k, lru);
+    EXPECT_GT(lru_k, clock);
+}
+
 /** 注意：每个测试点只测试了单个文件！
  * 对于每个测试点，先创建和进入目录TEST_DB_NAME
  * 然后在此目录下创建和打开文件TEST_FILE_NAME，记录其文件描述符fd */
@@ -426,6 +582,1149 @@ TEST_F(BufferPoolManagerConcurrencyTest, ConcurrencyTest) {
     std::cout << "test passed\n";
 }
 
+TEST_F(BufferPoolManagerConcurrencyTest, PartitionTest) {
+    const int num_threads = 8;
+    const int num_pages = 64;
+    const size_t num_partitions = 8;
+
+    int fd = BufferPoolManagerConcurrencyTest::fd_;
+    auto disk_manager = BufferPoolManagerConcurrencyTest::disk_manager_.get();
+    // 每个分区的帧数不少于线程数，保证任意时刻被固定的页面都能在所属分区中找到帧
+    auto bpm = std::make_unique<BufferPoolManager>(num_threads * num_partitions, disk_manager, num_partitions);
+    EXPECT_EQ(num_partitions, bpm->get_num_partitions());
+
+    // 所有线程创建的页面总数远超缓冲池的帧数，页面需要在分区内被换出再读回
+    std::vector<std::thread> threads;
+    for (int tid = 0; tid < num_threads; tid++) {
+        threads.emplace_back([&bpm, fd]() {
+            std::vector<PageId> page_ids;
+            for (int i = 0; i < num_pages; i++) {
+                PageId page_id = {.fd = fd, .page_no = INVALID_PAGE_ID};
+                auto page = bpm->new_page(&page_id);
+                ASSERT_NE(nullptr, page);
+                snprintf(page->get_data(), PAGE_SIZE, "%d", page_id.page_no);
+                EXPECT_TRUE(bpm->unpin_page(page_id, true));
+                page_ids.push_back(page_id);
+            }
+            for (auto &page_id : page_ids) {
+                auto page = bpm->fetch_page(page_id);
+                ASSERT_NE(nullptr, page);
+                EXPECT_EQ(std::to_string(page_id.page_no), page->get_data());
+                EXPECT_TRUE(bpm->unpin_page(page_id, false));
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    bpm->flush_all_pages(fd);
+}
+
+TEST_F(BufferPoolManagerConcurrencyTest, FlushFileTest) {
+    const int num_pages = 32;
+    int fd = BufferPoolManagerConcurrencyTest::fd_;
+    auto disk_manager = BufferPoolManagerConcurrencyTest::disk_manager_.get();
+    const std::string other_file = TEST_FILE_NAME_CCUR + "_other";
+    if (disk_manager->is_file(other_file)) disk_manager->destroy_file(other_file);
+    disk_manager->create_file(other_file);
+    int other_fd = disk_manager->open_file(other_file);
+    auto bpm = std::make_unique<BufferPoolManager>(4 * num_pages, disk_manager, 4);
+
+    // 两个文件的页面交错常驻在缓冲池中
+    for (int i = 0; i < num_pages; i++) {
+        for (int file : {fd, other_fd}) {
+            PageId page_id = {.fd = file, .page_no = INVALID_PAGE_ID};
+            auto page = bpm->new_page(&page_id);
+            ASSERT_NE(nullptr, page);
+            snprintf(page->get_data(), PAGE_SIZE, "%d:%d", file, page_id.page_no);
+            EXPECT_TRUE(bpm->unpin_page(page_id, true));
+        }
+    }
+    // 固定的页面被写回但仍然常驻
+    auto pinned = bpm->fetch_page({fd, 3});
+    ASSERT_NE(nullptr, pinned);
+
+    auto on_disk = [&](int file, int page_no) {
+        char buf[PAGE_SIZE];
+        disk_manager->read_page(file, page_no, buf, PAGE_SIZE);
+        return std::string(buf) == std::to_string(file) + ":" + std::to_string(page_no);
+    };
+    bpm->flush_all_pages(fd);
+    for (int i = 0; i < num_pages; i++) {
+        EXPECT_TRUE(on_disk(fd, i));
+        EXPECT_FALSE(on_disk(other_fd, i));
+    }
+    EXPECT_EQ(pinned, bpm->fetch_page({fd, 3}));
+    EXPECT_TRUE(bpm->unpin_page({fd, 3}, false));
+    EXPECT_TRUE(bpm->unpin_page({fd, 3}, false));
+
+    // 另一个文件的页面不受影响，仍可从缓冲池中读到修改后的内容
+    auto page = bpm->fetch_page({other_fd, 5});
+    ASSERT_NE(nullptr, page);
+    EXPECT_EQ(std::to_string(other_fd) + ":5", page->get_data());
+    EXPECT_TRUE(bpm->unpin_page({other_fd, 5}, false));
+    bpm->flush_all_pages(other_fd);
+    for (int i = 0; i < num_pages; i++) EXPECT_TRUE(on_disk(other_fd, i));
+    bpm->flush_all_pages(fd);
+    disk_manager->close_file(other_fd);
+}
+
+TEST_F(BufferPoolManagerConcurrencyTest, ReplacerTypeTest) {
+    int fd = BufferPoolManagerConcurrencyTest::fd_;
+    auto disk_manager = BufferPoolManagerConcurrencyTest::disk_manager_.get();
+
+    for (const std::string replacer_type : {"LRU", "LRU-K", "CLOCK"}) {
+        auto bpm = std::make_unique<BufferPoolManager>(8, disk_manager, 2, replacer_type);
+        std::vector<PageId> page_ids;
+        for (int i = 0; i < 32; i++) {
+            PageId page_id = {.fd = fd, .page_no = INVALID_PAGE_ID};
+            auto page = bpm->new_page(&page_id);
+            ASSERT_NE(nullptr, page);
+            snprintf(page->get_data(), PAGE_SIZE, "%d", page_id.page_no);
+            EXPECT_TRUE(bpm->unpin_page(page_id, true));
+            page_ids.push_back(page_id);
+        }
+        for (auto &page_id : page_ids) {
+            auto page = bpm->fetch_page(page_id);
+            ASSERT_NE(nullptr, page);
+            EXPECT_EQ(std::to_string(page_id.page_no), page->get_data());
+            EXPECT_TRUE(bpm->unpin_page(page_id, false));
+        }
+        bpm->flush_all_pages(fd);
+    }
+    EXPECT_THROW(BufferPoolManager(8, disk_manager, 1, "MRU"), InternalError);
+}
+
+TEST_F(BufferPoolManagerConcurrencyTest, ConcurrentFetchTest) {
+    const int num_threads = 8;
+    const int num_pages = 32;
+    const int num_runs = 2000;
+
+    int fd = BufferPoolManagerConcurrencyTest::fd_;
+    auto disk_manager = BufferPoolManagerConcurrencyTest::disk_manager_.get();
+    auto bpm = std::make_unique<BufferPoolManager>(num_threads, disk_manager);
+
+    for (int i = 0; i < num_pages; i++) {
+        PageId page_id = {.fd = fd, .page_no = INVALID_PAGE_ID};
+        auto page = bpm->new_page(&page_id);
+        ASSERT_NE(nullptr, page);
+        snprintf(page->get_data(), PAGE_SIZE, "%d", page_id.page_no);
+        EXPECT_TRUE(bpm->unpin_page(page_id, true));
+    }
+
+    // 页面数远多于帧数，多个线程会同时读入同一个页面、同时淘汰脏页，读到的内容必须始终正确
+    std::vector<std::thread> threads;
+    for (int tid = 0; tid < num_threads; tid++) {
+        threads.emplace_back([&bpm, fd, tid]() {
+            std::mt19937 rng(tid);
+            for (int r = 0; r < num_runs; r++) {
+                PageId page_id = {.fd = fd, .page_no = static_cast<int>(rng() % num_pages)};
+                auto page = bpm->fetch_page(page_id);
+                ASSERT_NE(nullptr, page);
+                EXPECT_EQ(std::to_string(page_id.page_no), page->get_data());
+                EXPECT_TRUE(bpm->unpin_page(page_id, true));
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    bpm->flush_all_pages(fd);
+}
+
+TEST_F(BigStorageTest, ConcurrentPositionalIOTest) {
+    const int num_threads = 8;
+    const int pages_per_thread = 64;
+    const int batch = 8;
+    int fd = BigStorageTest::fd_;
+    auto disk_manager = BigStorageTest::disk_manager_.get();
+
+    // 每个线程负责文件中互不重叠的一段页面，单页与多页读写交替进行，页面内容必须与写入时一致
+    auto fill = [](char *buf, int page_no, int round) {
+        memset(buf, 0, PAGE_SIZE);
+        snprintf(buf, PAGE_SIZE, "%d-%d", page_no, round);
+    };
+    std::vector<std::thread> threads;
+    for (int tid = 0; tid < num_threads; tid++) {
+        threads.emplace_back([&, tid]() {
+            int first = tid * pages_per_thread;
+            std::vector<std::vector<char>> bufs(batch, std::vector<char>(PAGE_SIZE));
+            std::vector<char *> ptrs;
+            for (auto &buf : bufs) {
+                ptrs.push_back(buf.data());
+            }
+            char expected[PAGE_SIZE];
+            for (int round = 0; round < 4; round++) {
+                for (int i = 0; i < pages_per_thread; i += batch) {
+                    for (int j = 0; j < batch; j++) {
+                        fill(ptrs[j], first + i + j, round);
+                    }
+                    if (round % 2 == 0) {
+                        disk_manager->write_pages(fd, first + i, ptrs.data(), batch);
+                    } else {
+                        for (int j = 0; j < batch; j++) {
+                            disk_manager->write_page(fd, first + i + j, ptrs[j], PAGE_SIZE);
+                        }
+                    }
+                }
+                for (int i = 0; i < pages_per_thread; i += batch) {
+                    disk_manager->read_pages(fd, first + i, ptrs.data(), batch);
+                    for (int j = 0; j < batch; j++) {
+                        fill(expected, first + i + j, round);
+                        EXPECT_EQ(0, memcmp(expected, ptrs[j], PAGE_SIZE));
+                        disk_manager->read_page(fd, first + i + j, ptrs[j], PAGE_SIZE);
+                        EXPECT_EQ(0, memcmp(expected, ptrs[j], PAGE_SIZE));
+                    }
+                }
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    // 读取超过文件末尾的页面应当报错
+    char *buf = new char[PAGE_SIZE];
+    EXPECT_THROW(disk_manager->read_pages(fd, num_threads * pages_per_thread, &buf, 1), InternalError);
+    delete[] buf;
+}
+
+TEST_F(BufferPoolManagerConcurrencyTest, AsyncFetchTest) {
+    const int num_threads = 4;
+    const int num_pages = 64;
+    const int batch = 8;
+
+    int fd = BufferPoolManagerConcurrencyTest::fd_;
+    auto disk_manager = BufferPoolManagerConcurrencyTest::disk_manager_.get();
+
+    for (const std::string engine : {"none", "thread_pool", "io_uring"}) {
+        disk_manager->enable_async_io(engine);
+        // 系统不支持io_uring时回退到线程池，线程池已经测试过，跳过这一轮
+        if (disk_manager->get_async_io_engine() != engine) continue;
+        // 帧数远小于页面数，批量读取时被淘汰的脏页与新页面的读入同时在途
+        auto bpm = std::make_unique<BufferPoolManager>(num_threads * batch * 2, disk_manager, 2);
+        std::vector<PageId> page_ids;
+        for (int i = 0; i < num_pages; i++) {
+            PageId page_id = {.fd = fd, .page_no = INVALID_PAGE_ID};
+            auto page = bpm->new_page(&page_id);
+            ASSERT_NE(nullptr, page);
+            snprintf(page->get_data(), PAGE_SIZE, "%d", page_id.page_no);
+            EXPECT_TRUE(bpm->unpin_page(page_id, true));
+            page_ids.push_back(page_id);
+        }
+
+        std::vector<std::thread> threads;
+        for (int tid = 0; tid < num_threads; tid++) {
+            threads.emplace_back([&bpm, &page_ids, tid]() {
+                std::mt19937 rng(tid);
+                for (int r = 0; r < 50; r++) {
+                    std::vector<PageId> ids;
+                    for (int i = 0; i < batch; i++) ids.push_back(page_ids[rng() % num_pages]);
+                    auto pages = bpm->fetch_pages(ids);
+                    for (int i = 0; i < batch; i++) {
+                        ASSERT_NE(nullptr, pages[i]);
+                        EXPECT_EQ(std::to_string(ids[i].page_no), pages[i]->get_data());
+                    }
+                    for (int i = 0; i < batch; i++) EXPECT_TRUE(bpm->unpin_page(ids[i], true));
+
+                    ids.clear();
+                    for (int i = 0; i < batch; i++) ids.push_back(page_ids[rng() % num_pages]);
+                    bpm->prefetch_pages(ids);
+                    for (auto &page_id : ids) {
+                        auto page = bpm->fetch_page(page_id);
+                        ASSERT_NE(nullptr, page);
+                        EXPECT_EQ(std::to_string(page_id.page_no), page->get_data());
+                        EXPECT_TRUE(bpm->unpin_page(page_id, false));
+                    }
+                }
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        // 预读超出文件末尾的页面会失败，不能影响缓冲池的状态
+        bpm->prefetch_pages({PageId{fd, num_pages + 100}});
+        bpm->flush_all_pages(fd);
+        EXPECT_EQ(engine, disk_manager->get_async_io_engine());
+    }
+    disk_manager->enable_async_io("none");
+}
+
+TEST_F(BufferPoolManagerConcurrencyTest, IoUringFailureTest) {
+    std::unique_ptr<IoUringEngine> engine;
+    try {
+        engine = std::make_unique<IoUringEngine>(ASYNC_IO_QUEUE_DEPTH);
+    } catch (UnixError &) {
+        GTEST_SKIP() << "io_uring is unavailable";
+    }
+
+    // 两个读请求分别读取两个管道，在管道中有数据之前一直在途
+    int pipes[2][2];
+    ASSERT_EQ(0, pipe(pipes[0]));
+    ASSERT_EQ(0, pipe(pipes[1]));
+    std::vector<char> buf(2 * PAGE_SIZE);
+    std::atomic<int> results[2] = {-1, -1};
+    std::vector<AsyncIoRequest> requests;
+    for (int i = 0; i < 2; i++) {
+        requests.push_back({false, pipes[i][0], 0, buf.data() + i * PAGE_SIZE,
+                            [&results, i](bool ok) { results[i] = ok; }});
+    }
+    engine->submit(requests);
+
+    // 等待完成事件的io_uring_enter出错后，在途的请求以失败完成，后台线程不会空转
+    int null_fd = open("/dev/null", O_RDONLY);
+    ASSERT_GE(null_fd, 0);
+    dup2(null_fd, engine->ring_fd_);
+    close(null_fd);
+    std::vector<char> data(PAGE_SIZE, 'a');
+    ASSERT_EQ(PAGE_SIZE, write(pipes[0][1], data.data(), PAGE_SIZE));
+    for (int i = 0; i < 1000 && results[1] == -1; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_NE(-1, results[0].load());
+    EXPECT_EQ(0, results[1].load());
+
+    // 之后提交的请求直接失败
+    int result = -1;
+    requests.push_back({false, pipes[1][0], 0, buf.data(), [&result](bool ok) { result = ok; }});
+    engine->submit(requests);
+    EXPECT_EQ(0, result);
+    engine.reset();
+    for (auto &p : pipes) {
+        close(p[0]);
+        close(p[1]);
+    }
+}
+
+TEST_F(BufferPoolManagerConcurrencyTest, AsyncWriteBackFailureTest) {
+    const int pool_size = 8;
+    int fd = BufferPoolManagerConcurrencyTest::fd_;
+    auto disk_manager = BufferPoolManagerConcurrencyTest::disk_manager_.get();
+    disk_manager->enable_async_io("thread_pool");
+    auto bpm = std::make_unique<BufferPoolManager>(pool_size, disk_manager, 1);
+    std::vector<PageId> page_ids;
+    for (int i = 0; i < 2 * pool_size; i++) {
+        PageId page_id = {.fd = fd, .page_no = INVALID_PAGE_ID};
+        auto page = bpm->new_page(&page_id);
+        ASSERT_NE(nullptr, page);
+        snprintf(page->get_data(), PAGE_SIZE, "%d", page_id.page_no);
+        EXPECT_TRUE(bpm->unpin_page(page_id, true));
+        page_ids.push_back(page_id);
+    }
+
+    // 把文件换成只读的文件描述符，预读时被淘汰的脏页写回失败，页面需要重新放回缓冲池而不是丢失
+    int saved_fd = dup(fd);
+    int read_only_fd = open(disk_manager->get_file_name(fd).c_str(), O_RDONLY);
+    ASSERT_GE(read_only_fd, 0);
+    ASSERT_EQ(fd, dup2(read_only_fd, fd));
+    close(read_only_fd);
+    bpm->prefetch_pages({page_ids.begin(), page_ids.begin() + pool_size / 2});
+    bpm->wait_async_io();
+    ASSERT_EQ(fd, dup2(saved_fd, fd));
+    close(saved_fd);
+
+    for (int i = pool_size; i < 2 * pool_size; i++) {
+        auto page = bpm->fetch_page(page_ids[i]);
+        ASSERT_NE(nullptr, page);
+        EXPECT_EQ(std::to_string(page_ids[i].page_no), page->get_data());
+        EXPECT_TRUE(bpm->unpin_page(page_ids[i], false));
+    }
+    bpm->flush_all_pages(fd);
+    for (auto &page_id : page_ids) {
+        char buf[PAGE_SIZE];
+        disk_manager->read_page(fd, page_id.page_no, buf, PAGE_SIZE);
+        EXPECT_EQ(std::to_string(page_id.page_no), buf);
+    }
+    disk_manager->enable_async_io("none");
+}
+
+TEST_F(BufferPoolManagerConcurrencyTest, ReadAheadTest) {
+    const int num_pages = 512;
+
+    int fd = BufferPoolManagerConcurrencyTest::fd_;
+    auto disk_manager = BufferPoolManagerConcurrencyTest::disk_manager_.get();
+    disk_manager->enable_async_io("io_uring");
+    std::vector<char> buf(PAGE_SIZE);
+    for (int i = 0; i < num_pages; i++) {
+        snprintf(buf.data(), PAGE_SIZE, "%d", i);
+        disk_manager->write_page(fd, i, buf.data(), PAGE_SIZE);
+    }
+    auto bpm = std::make_unique<BufferPoolManager>(256, disk_manager, 4);
+    auto scan = [&](const std::vector<int> &order) {
+        for (int page_no : order) {
+            PageId page_id = {fd, page_no};
+            bpm->read_ahead(page_id, num_pages);
+            auto page = bpm->fetch_page(page_id);
+            ASSERT_NE(nullptr, page);
+            EXPECT_EQ(std::to_string(page_no), page->get_data());
+            EXPECT_TRUE(bpm->unpin_page(page_id, false));
+        }
+    };
+
+    // 顺序扫描：预读窗口逐渐增大，预读的页面几乎都会被访问到
+    std::vector<int> order(num_pages);
+    for (int i = 0; i < num_pages; i++) order[i] = i;
+    scan(order);
+    auto stats = bpm->get_read_ahead_stats();
+    std::cout << "sequential: prefetched " << stats.prefetched << ", hits " << stats.hits << ", wasted "
+              << stats.wasted << std::endl;
+    EXPECT_GT(stats.prefetched, num_pages / 2);
+    EXPECT_GE(stats.hits + READ_AHEAD_MAX_PAGES, stats.prefetched);
+    EXPECT_EQ(0, stats.wasted);
+
+    // 随机访问不会触发预读
+    std::shuffle(order.begin(), order.end(), std::mt19937(0));
+    scan(order);
+    EXPECT_LE(bpm->get_read_ahead_stats().prefetched, stats.prefetched + READ_AHEAD_MIN_PAGES);
+
+    // 预读之后从未被访问就被淘汰的页面记为浪费
+    std::vector<PageId> page_ids;
+    for (int i = 0; i < num_pages; i++) page_ids.push_back(PageId{fd, i});
+    bpm->prefetch_pages(page_ids);
+    bpm->flush_all_pages(fd);
+    EXPECT_GT(bpm->get_read_ahead_stats().wasted, 0);
+    disk_manager->enable_async_io("none");
+}
+
+TEST_F(BufferPoolManagerConcurrencyTest, AccessStrategyTest) {
+    const int num_hot_pages = 64;
+    const int num_pages = 1024;
+
+    int fd = BufferPoolManagerConcurrencyTest::fd_;
+    auto disk_manager = BufferPoolManagerConcurrencyTest::disk_manager_.get();
+    std::vector<char> buf(PAGE_SIZE);
+    for (int i = 0; i < num_pages; i++) {
+        snprintf(buf.data(), PAGE_SIZE, "%d", i);
+        disk_manager->write_page(fd, i, buf.data(), PAGE_SIZE);
+    }
+    auto bpm = std::make_unique<BufferPoolManager>(256, disk_manager, 4);
+    EXPECT_EQ(nullptr, bpm->make_access_strategy(64, 32));
+
+    // 热点页面读入缓冲池后，修改其在磁盘上的内容：页面仍在缓冲池中时读到的是旧内容
+    auto load_hot_pages = [&]() {
+        for (int i = 0; i < num_hot_pages; i++) {
+            PageId page_id = {fd, i};
+            ASSERT_NE(nullptr, bpm->fetch_page(page_id));
+            bpm->unpin_page(page_id, false);
+            snprintf(buf.data(), PAGE_SIZE, "stale %d", i);
+            disk_manager->write_page(fd, i, buf.data(), PAGE_SIZE);
+        }
+    };
+    auto count_cached_hot_pages = [&]() {
+        int num_cached = 0;
+        for (int i = 0; i < num_hot_pages; i++) {
+            PageId page_id = {fd, i};
+            auto page = bpm->fetch_page(page_id);
+            num_cached += std::to_string(i) == page->get_data();
+            bpm->unpin_page(page_id, false);
+            snprintf(buf.data(), PAGE_SIZE, "%d", i);
+            disk_manager->write_page(fd, i, buf.data(), PAGE_SIZE);
+        }
+        return num_cached;
+    };
+    auto scan = [&](BufferAccessStrategy *strategy) {
+        for (int page_no = num_hot_pages; page_no < num_pages; page_no++) {
+            PageId page_id = {fd, page_no};
+            bpm->read_ahead(page_id, num_pages, strategy);
+            auto page = bpm->fetch_page(page_id, strategy);
+            ASSERT_NE(nullptr, page);
+            EXPECT_EQ(std::to_string(page_no), page->get_data());
+            bpm->unpin_page(page_id, page_no % 2 == 0);
+        }
+    };
+
+    // 使用环形缓冲区扫描大文件，热点页面全部留在缓冲池中
+    auto strategy = bpm->make_access_strategy(num_pages, 32);
+    ASSERT_NE(nullptr, strategy);
+    load_hot_pages();
+    scan(strategy.get());
+    EXPECT_EQ(num_hot_pages, count_cached_hot_pages());
+
+    // 不使用访问策略时，扫描会淘汰热点页面
+    bpm->flush_all_pages(fd);
+    load_hot_pages();
+    scan(nullptr);
+    EXPECT_GT(num_hot_pages, count_cached_hot_pages());
+    bpm->flush_all_pages(fd);
+}
+
+TEST_F(BufferPoolManagerConcurrencyTest, AsyncIoBenchmark) {
+    const int num_pages = 4096;
+    const int batch = 32;
+
+    int fd = BufferPoolManagerConcurrencyTest::fd_;
+    auto disk_manager = BufferPoolManagerConcurrencyTest::disk_manager_.get();
+    std::vector<char> buf(PAGE_SIZE);
+    for (int i = 0; i < num_pages; i++) {
+        snprintf(buf.data(), PAGE_SIZE, "%d", i);
+        disk_manager->write_page(fd, i, buf.data(), PAGE_SIZE);
+    }
+    disk_manager->set_fd2pageno(fd, num_pages);
+    std::vector<PageId> page_ids;
+    for (int i = 0; i < num_pages; i++) page_ids.push_back(PageId{fd, i});
+    std::shuffle(page_ids.begin(), page_ids.end(), std::mt19937(0));
+
+    // 每轮开始前将文件从操作系统的页缓存中清除，尽量让每次读取都真正访问磁盘
+    auto run = [&](const std::string &engine, bool batched) {
+        disk_manager->enable_async_io(engine);
+        auto bpm = std::make_unique<BufferPoolManager>(256, disk_manager, 4);
+        fsync(fd);
+        posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < num_pages; i += batch) {
+            std::vector<PageId> ids(page_ids.begin() + i, page_ids.begin() + i + batch);
+            std::vector<Page *> pages;
+            if (batched) {
+                pages = bpm->fetch_pages(ids);
+            } else {
+                for (auto &page_id : ids) pages.push_back(bpm->fetch_page(page_id));
+            }
+            for (int j = 0; j < batch; j++) {
+                ASSERT_NE(nullptr, pages[j]);
+                EXPECT_EQ(std::to_string(ids[j].page_no), pages[j]->get_data());
+                bpm->unpin_page(ids[j], false);
+            }
+        }
+        auto ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        std::cout << (batched ? "fetch_pages " : "fetch_page  ") << engine << ": " << ms << " ms" << std::endl;
+    };
+    run("none", false);
+    run("none", true);
+    run("thread_pool", true);
+    run("io_uring", true);
+    disk_manager->enable_async_io("none");
+}
+
+TEST_F(BufferPoolManagerConcurrencyTest, FlusherTest) {
+    const int num_pages = 64;
+    int fd = BufferPoolManagerConcurrencyTest::fd_;
+    auto disk_manager = BufferPoolManagerConcurrencyTest::disk_manager_.get();
+    auto log_manager = std::make_unique<LogManager>(disk_manager);
+    auto bpm = std::make_unique<BufferPoolManager>(num_pages, disk_manager, 1, "LRU");
+    bpm->set_log_manager(log_manager.get());
+
+    for (int i = 0; i < num_pages; i++) {
+        PageId page_id = {.fd = fd, .page_no = INVALID_PAGE_ID};
+        auto page = bpm->new_page(&page_id);
+        ASSERT_NE(nullptr, page);
+        page->set_page_lsn(i);
+        snprintf(page->get_data() + sizeof(lsn_t), PAGE_SIZE - sizeof(lsn_t), "%d", page_id.page_no);
+        EXPECT_TRUE(bpm->unpin_page(page_id, true));
+    }
+    auto on_disk = [&](int page_no) {
+        char buf[PAGE_SIZE];
+        disk_manager->read_page(fd, page_no, buf, PAGE_SIZE);
+        return std::string(buf + sizeof(lsn_t)) == std::to_string(page_no);
+    };
+
+    // 日志还没有持久化，任何页面都不能写回
+    log_manager->persist_lsn_ = 0;
+    EXPECT_EQ(0, bpm->flush_tail_pages(num_pages));
+    EXPECT_FALSE(on_disk(0));
+
+    // 只写回日志已持久化、且位于LRU尾部的页面
+    log_manager->persist_lsn_ = 8;
+    EXPECT_EQ(8, bpm->flush_tail_pages(16));
+    log_manager->persist_lsn_ = num_pages;
+    EXPECT_EQ(8, bpm->flush_tail_pages(16));
+    for (int i = 0; i < num_pages; i++) EXPECT_EQ(i < 16, on_disk(i));
+    EXPECT_EQ(0, bpm->flush_tail_pages(16));
+    EXPECT_EQ(num_pages - 16, bpm->flush_tail_pages(num_pages));
+    for (int i = 0; i < num_pages; i++) EXPECT_TRUE(on_disk(i));
+    bpm->flush_all_pages(fd);
+}
+
+TEST_F(BufferPoolManagerConcurrencyTest, GroupCommitTest) {
+    const int num_threads = 8;
+    const int commits_per_thread = 50;
+    auto disk_manager = BufferPoolManagerConcurrencyTest::disk_manager_.get();
+    if (disk_manager->is_file(LOG_FILE_NAME)) disk_manager->destroy_file(LOG_FILE_NAME);
+    auto log_manager = std::make_unique<LogManager>(disk_manager, std::chrono::microseconds(2000));
+
+    // 同时提交的事务共用一次刷盘，每个事务返回时自己的日志都已持久化
+    std::vector<std::thread> threads;
+    for (int tid = 0; tid < num_threads; tid++) {
+        threads.emplace_back([&, tid]() {
+            for (int i = 0; i < commits_per_thread; i++) {
+                CommitLogRecord rec(tid, INVALID_LSN);
+                auto lsn = log_manager->add_log_to_buffer(&rec);
+                log_manager->wait_for_flush(lsn);
+                EXPECT_GT(log_manager->persist_lsn_.load(), lsn);
+            }
+        });
+    }
+    for (auto &thread: threads) thread.join();
+
+    EXPECT_EQ(num_threads * commits_per_thread, log_manager->persist_lsn_.load());
+    EXPECT_GT(log_manager->get_group_flush_count(), 0);
+    EXPECT_LE(log_manager->get_group_flush_count(), num_threads * commits_per_thread / 2);
+
+    // 所有提交日志都已写入日志文件
+    char log[LOG_HEADER_SIZE];
+    int offset = 0;
+    int num_records = 0;
+    while (disk_manager->read_log(log, LOG_HEADER_SIZE, offset) > 0) {
+        LogRecord rec;
+        rec.deserialize(log);
+        EXPECT_EQ(LogRecordType::COMMIT, rec.log_type_);
+        offset += rec.log_tot_len_;
+        num_records++;
+    }
+    EXPECT_EQ(num_threads * commits_per_thread, num_records);
+}
+
+TEST_F(BufferPoolManagerConcurrencyTest, GroupCommitBatchTest) {
+    const int num_threads = 8;
+    auto disk_manager = BufferPoolManagerConcurrencyTest::disk_manager_.get();
+    if (disk_manager->is_file(LOG_FILE_NAME)) disk_manager->destroy_file(LOG_FILE_NAME);
+    std::unique_ptr<LogManager> log_manager;
+    auto commit = [&](txn_id_t tid) {
+        CommitLogRecord rec(tid, INVALID_LSN);
+        auto lsn = log_manager->add_log_to_buffer(&rec);
+        log_manager->wait_for_flush(lsn);
+        EXPECT_GT(log_manager->persist_lsn_.load(), lsn);
+    };
+
+    // 只有一个事务提交时，刷日志线程等满log_timeout才写入
+    auto timeout = std::chrono::microseconds(20000);
+    log_manager = std::make_unique<LogManager>(disk_manager, timeout, num_threads);
+    auto start = std::chrono::steady_clock::now();
+    commit(0);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, timeout);
+    EXPECT_EQ(1, log_manager->get_group_flush_count());
+
+    // 等待的事务达到批大小时立即写入，不再等待超时
+    timeout = std::chrono::microseconds(10000000);
+    log_manager = std::make_unique<LogManager>(disk_manager, timeout, num_threads);
+    start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (int tid = 0; tid < num_threads; tid++) {
+        threads.emplace_back(commit, tid);
+    }
+    for (auto &thread: threads) thread.join();
+    EXPECT_LT(std::chrono::steady_clock::now() - start, timeout / 2);
+    EXPECT_EQ(1, log_manager->get_group_flush_count());
+}
+
+TEST_F(BufferPoolManagerConcurrencyTest, GroupCommitFailureTest) {
+    auto disk_manager = BufferPoolManagerConcurrencyTest::disk_manager_.get();
+    if (disk_manager->is_file(LOG_FILE_NAME)) disk_manager->destroy_file(LOG_FILE_NAME);
+    auto log_manager = std::make_unique<LogManager>(disk_manager);
+    auto commit = [&](txn_id_t tid) {
+        CommitLogRecord rec(tid, INVALID_LSN);
+        log_manager->wait_for_flush(log_manager->add_log_to_buffer(&rec));
+    };
+    commit(0);
+
+    // 日志文件只读时写入失败，等待的事务都收到错误而不是一直等待，之后的提交和刷盘也都失败
+    int log_fd = disk_manager->GetLogFd();
+    int saved_fd = dup(log_fd);
+    int read_only_fd = open(LOG_FILE_NAME.c_str(), O_RDONLY);
+    ASSERT_GE(saved_fd, 0);
+    ASSERT_GE(read_only_fd, 0);
+    dup2(read_only_fd, log_fd);
+    std::vector<std::thread> threads;
+    std::atomic<int> num_failed{0};
+    for (int tid = 1; tid <= 4; tid++) {
+        threads.emplace_back([&, tid]() {
+            try {
+                commit(tid);
+            } catch (UnixError &) {
+                num_failed++;
+            }
+        });
+    }
+    for (auto &thread: threads) thread.join();
+    EXPECT_EQ(4, num_failed.load());
+    EXPECT_THROW(commit(5), UnixError);
+    EXPECT_THROW(log_manager->flush_log_to_disk(), UnixError);
+    EXPECT_EQ(1, log_manager->persist_lsn_.load());
+
+    dup2(saved_fd, log_fd);
+    close(saved_fd);
+    close(read_only_fd);
+    log_manager.reset();
+}
+
+TEST_F(BufferPoolManagerConcurrencyTest, LogBufferSwapTest) {
+    const int num_threads = 4;
+    const int records_per_thread = 600;
+    auto disk_manager = BufferPoolManagerConcurrencyTest::disk_manager_.get();
+    if (disk_manager->is_file(LOG_FILE_NAME)) disk_manager->destroy_file(LOG_FILE_NAME);
+    auto log_manager = std::make_unique<LogManager>(disk_manager);
+
+    // 多个线程并发追加日志，每次写满缓冲区都会交换缓冲区，另一个线程同时不断地刷盘
+    std::atomic<bool> done{false};
+    std::thread flusher([&]() {
+        while (!done.load()) log_manager->flush_log_to_disk();
+    });
+    std::vector<std::thread> threads;
+    for (int tid = 0; tid < num_threads; tid++) {
+        threads.emplace_back([&, tid]() {
+            char data[PAGE_SIZE];
+            for (int i = 0; i < records_per_thread; i++) {
+                if (i % 2 == 0) {
+                    memset(data, 'a' + tid, PAGE_SIZE);
+                    PageLogRecord rec(tid, INVALID_LSN, 1, i, data);
+                    rec.set_new_page(data);
+                    log_manager->add_log_to_buffer(&rec);
+                } else {
+                    CommitLogRecord rec(tid, INVALID_LSN);
+                    log_manager->add_log_to_buffer(&rec);
+                }
+            }
+        });
+    }
+    for (auto &thread: threads) thread.join();
+    done = true;
+    flusher.join();
+    log_manager->flush_log_to_disk();
+    EXPECT_EQ(num_threads * records_per_thread, log_manager->persist_lsn_.load());
+
+    // 日志文件中的日志号连续，每条日志都完整地写入了
+    std::vector<char> log(LOG_HEADER_SIZE + sizeof(size_t) + 2 * PAGE_SIZE);
+    int offset = 0;
+    lsn_t expected_lsn = 0;
+    std::vector<int> next_page_no(num_threads, 0);
+    while (disk_manager->read_log(log.data(), LOG_HEADER_SIZE, offset) > 0) {
+        LogRecord header;
+        header.deserialize(log.data());
+        EXPECT_EQ(expected_lsn++, header.lsn_);
+        ASSERT_LE(header.log_tot_len_, log.size());
+        ASSERT_EQ((int)header.log_tot_len_, disk_manager->read_log(log.data(), header.log_tot_len_, offset));
+        if (header.log_type_ == LogRecordType::PAGE_SET) {
+            PageLogRecord rec;
+            rec.deserialize(log.data());
+            ASSERT_LT(rec.log_tid_, num_threads);
+            EXPECT_EQ(next_page_no[rec.log_tid_], (int)rec.page_no);
+            next_page_no[rec.log_tid_] += 2;
+            EXPECT_EQ(std::string(PAGE_SIZE, 'a' + rec.log_tid_), std::string(rec.new_page, PAGE_SIZE));
+        } else {
+            EXPECT_EQ(LogRecordType::COMMIT, header.log_type_);
+        }
+        offset += header.log_tot_len_;
+    }
+    EXPECT_EQ(num_threads * records_per_thread, expected_lsn);
+}
+
+TEST_F(BufferPoolManagerConcurrencyTest, ConcurrentFlusherTest) {
+    const int num_threads = 4;
+    const int pages_per_thread = 32;
+    const int num_runs = 20000;
+
+    int fd = BufferPoolManagerConcurrencyTest::fd_;
+    auto disk_manager = BufferPoolManagerConcurrencyTest::disk_manager_.get();
+    auto bpm = std::make_unique<BufferPoolManager>(num_threads * 8, disk_manager, 2);
+    std::vector<PageId> page_ids;
+    for (int i = 0; i < num_threads * pages_per_thread; i++) {
+        PageId page_id = {.fd = fd, .page_no = INVALID_PAGE_ID};
+        ASSERT_NE(nullptr, bpm->new_page(&page_id));
+        EXPECT_TRUE(bpm->unpin_page(page_id, true));
+        page_ids.push_back(page_id);
+    }
+
+    // 后台刷脏线程与查询线程同时写回、淘汰、修改同一批页面，最终每个页面必须是最后一次写入的内容
+    bpm->start_flusher(num_threads * 4);
+    std::vector<std::vector<int>> last_round(num_threads, std::vector<int>(pages_per_thread, -1));
+    std::vector<std::thread> threads;
+    for (int tid = 0; tid < num_threads; tid++) {
+        threads.emplace_back([&, tid]() {
+            std::mt19937 rng(tid);
+            for (int r = 0; r < num_runs; r++) {
+                int idx = static_cast<int>(rng() % pages_per_thread);
+                auto page_id = page_ids[tid * pages_per_thread + idx];
+                auto page = bpm->fetch_page(page_id);
+                ASSERT_NE(nullptr, page);
+                if (last_round[tid][idx] >= 0) {
+                    EXPECT_EQ(std::to_string(last_round[tid][idx]), page->get_data() + sizeof(lsn_t));
+                }
+                snprintf(page->get_data() + sizeof(lsn_t), PAGE_SIZE - sizeof(lsn_t), "%d", r);
+                last_round[tid][idx] = r;
+                EXPECT_TRUE(bpm->unpin_page(page_id, true));
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    bpm->stop_flusher();
+    bpm->flush_all_pages(fd);
+    for (int tid = 0; tid < num_threads; tid++) {
+        for (int idx = 0; idx < pages_per_thread; idx++) {
+            if (last_round[tid][idx] < 0) continue;
+            char buf[PAGE_SIZE];
+            disk_manager->read_page(fd, page_ids[tid * pages_per_thread + idx].page_no, buf, PAGE_SIZE);
+            EXPECT_EQ(std::to_string(last_round[tid][idx]), buf + sizeof(lsn_t));
+        }
+    }
+}
+
+TEST_F(BufferPoolManagerConcurrencyTest, ResizeTest) {
+    EXPECT_EQ(100, BufferPoolManager::parse_pool_size("100"));
+    EXPECT_EQ(256, BufferPoolManager::parse_pool_size("1M"));
+    EXPECT_EQ(262144, BufferPoolManager::parse_pool_size("1g"));
+    EXPECT_THROW(BufferPoolManager::parse_pool_size("1T"), InternalError);
+    EXPECT_THROW(BufferPoolManager::parse_pool_size("abc"), InternalError);
+
+    int fd = BufferPoolManagerConcurrencyTest::fd_;
+    auto disk_manager = BufferPoolManagerConcurrencyTest::disk_manager_.get();
+    for (std::string replacer_type : {"LRU", "LRU-K", "CLOCK"}) {
+        auto bpm = std::make_unique<BufferPoolManager>(16, disk_manager, 4, replacer_type, 64);
+        EXPECT_EQ(16, bpm->get_pool_size());
+        EXPECT_EQ(64, bpm->get_max_pool_size());
+        EXPECT_THROW(bpm->resize(65), InternalError);
+
+        // 扩大后可以同时固定更多页面
+        EXPECT_EQ(64, bpm->resize(64));
+        std::vector<PageId> page_ids;
+        for (int i = 0; i < 64; i++) {
+            PageId page_id = {.fd = fd, .page_no = INVALID_PAGE_ID};
+            auto page = bpm->new_page(&page_id);
+            ASSERT_NE(nullptr, page);
+            snprintf(page->get_data(), PAGE_SIZE, "%d", page_id.page_no);
+            page_ids.push_back(page_id);
+        }
+        for (auto &page_id : page_ids) EXPECT_TRUE(bpm->unpin_page(page_id, true));
+
+        // 被固定的页面所在的帧无法移出，缩小只能部分完成
+        auto pinned = bpm->fetch_page(page_ids.back());
+        ASSERT_NE(nullptr, pinned);
+        size_t size = bpm->resize(8);
+        EXPECT_LT(8, size);
+        EXPECT_EQ(size, bpm->get_pool_size());
+        EXPECT_EQ(pinned, bpm->fetch_page(page_ids.back()));
+        EXPECT_TRUE(bpm->unpin_page(page_ids.back(), false));
+        EXPECT_TRUE(bpm->unpin_page(page_ids.back(), false));
+
+        // 脏页在移出前被写回，缩小之后仍能读到全部页面
+        EXPECT_EQ(8, bpm->resize(8));
+        for (auto &page_id : page_ids) {
+            auto page = bpm->fetch_page(page_id);
+            ASSERT_NE(nullptr, page);
+            EXPECT_EQ(std::to_string(page_id.page_no), page->get_data());
+            EXPECT_TRUE(bpm->unpin_page(page_id, false));
+        }
+        EXPECT_EQ(32, bpm->resize(32));
+        bpm->flush_all_pages(fd);
+    }
+
+    // 查询线程读写页面的同时调整缓冲池大小
+    const int num_threads = 4;
+    const int pages_per_thread = 64;
+    auto bpm = std::make_unique<BufferPoolManager>(64, disk_manager, 4, "LRU-K", 256);
+    std::vector<PageId> page_ids(num_threads * pages_per_thread);
+    for (auto &page_id : page_ids) {
+        page_id = {.fd = fd, .page_no = INVALID_PAGE_ID};
+        auto page = bpm->new_page(&page_id);
+        ASSERT_NE(nullptr, page);
+        snprintf(page->get_data(), PAGE_SIZE, "%d", page_id.page_no);
+        EXPECT_TRUE(bpm->unpin_page(page_id, true));
+    }
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> threads;
+    for (int tid = 0; tid < num_threads; tid++) {
+        threads.emplace_back([&, tid] {
+            while (!stop) {
+                for (int i = 0; i < pages_per_thread; i++) {
+                    auto &page_id = page_ids[tid * pages_per_thread + i];
+                    auto page = bpm->fetch_page(page_id);
+                    if (page == nullptr) continue;
+                    EXPECT_EQ(std::to_string(page_id.page_no), page->get_data());
+                    EXPECT_TRUE(bpm->unpin_page(page_id, true));
+                }
+            }
+        });
+    }
+    for (size_t size : {256, 16, 128, 32, 64}) {
+        bpm->resize(size);
+    }
+    stop = true;
+    for (auto &thread : threads) thread.join();
+    EXPECT_EQ(64, bpm->resize(64));
+    bpm->flush_all_pages(fd);
+}
+
+TEST_F(BufferPoolManagerConcurrencyTest, PreallocateTest) {
+    int fd = BufferPoolManagerConcurrencyTest::fd_;
+    auto disk_manager = BufferPoolManagerConcurrencyTest::disk_manager_.get();
+    auto file_pages = [&] { return disk_manager->get_file_size(TEST_FILE_NAME_CCUR) / PAGE_SIZE; };
+    auto bpm = std::make_unique<BufferPoolManager>(8, disk_manager, 1, "LRU");
+    EXPECT_EQ(0, file_pages());
+
+    // 第一个新页面使文件扩展一个extent，新页面只在内存中，读取磁盘得到全0页面
+    PageId page_id = {.fd = fd, .page_no = INVALID_PAGE_ID};
+    auto page = bpm->new_page(&page_id);
+    ASSERT_NE(nullptr, page);
+    EXPECT_EQ(FILE_EXTENT_PAGES, file_pages());
+    EXPECT_TRUE(page->is_dirty());
+    strcpy(page->get_data(), "lazy");
+    EXPECT_TRUE(bpm->unpin_page(page_id, true));
+    char buf[PAGE_SIZE];
+    disk_manager->read_page(fd, page_id.page_no, buf, PAGE_SIZE);
+    EXPECT_EQ(std::string(PAGE_SIZE, '\0'), std::string(buf, PAGE_SIZE));
+
+    // 新页面被淘汰时随正常写回落盘
+    for (int i = 1; i < FILE_EXTENT_PAGES + 1; i++) {
+        PageId new_page_id = {.fd = fd, .page_no = INVALID_PAGE_ID};
+        ASSERT_NE(nullptr, bpm->new_page(&new_page_id));
+        EXPECT_TRUE(bpm->unpin_page(new_page_id, false));
+    }
+    EXPECT_EQ(2 * FILE_EXTENT_PAGES, file_pages());
+    EXPECT_EQ(2 * FILE_EXTENT_PAGES, disk_manager->get_fd2extent_end(fd));
+    disk_manager->read_page(fd, page_id.page_no, buf, PAGE_SIZE);
+    EXPECT_STREQ("lazy", buf);
+    bpm->flush_all_pages(fd);
+
+    // 重新打开文件时根据文件大小恢复已预分配的页面个数
+    disk_manager->close_file(fd);
+    fd_ = disk_manager->open_file(TEST_FILE_NAME_CCUR);
+    EXPECT_EQ(2 * FILE_EXTENT_PAGES, disk_manager->get_fd2extent_end(fd_));
+}
+
+TEST_F(BufferPoolManagerConcurrencyTest, DataArenaTest) {
+    int fd = BufferPoolManagerConcurrencyTest::fd_;
+    auto disk_manager = BufferPoolManagerConcurrencyTest::disk_manager_.get();
+    EXPECT_THROW(BufferPoolManager(16, disk_manager, 1, "LRU", 0, "1G"), InternalError);
+    for (std::string huge_pages : {"none", "thp", "hugetlb"}) {
+        auto bpm = std::make_unique<BufferPoolManager>(64, disk_manager, 4, "LRU", 1024, huge_pages);
+        // 大页不可用时退化，hugetlb -> thp -> none
+        if (huge_pages == "none") {
+            EXPECT_EQ("none", bpm->get_huge_pages());
+        }
+
+        // 每帧的数据都按PAGE_SIZE对齐，且互不重叠
+        std::vector<PageId> page_ids;
+        std::set<char *> datas;
+        for (int i = 0; i < 64; i++) {
+            PageId page_id = {.fd = fd, .page_no = INVALID_PAGE_ID};
+            auto page = bpm->new_page(&page_id);
+            ASSERT_NE(nullptr, page);
+            EXPECT_EQ(0, reinterpret_cast<uintptr_t>(page->get_data()) % PAGE_SIZE);
+            datas.insert(page->get_data());
+            snprintf(page->get_data(), PAGE_SIZE, "%d", page_id.page_no);
+            page_ids.push_back(page_id);
+        }
+        EXPECT_EQ(64, datas.size());
+        for (auto &page_id : page_ids) EXPECT_TRUE(bpm->unpin_page(page_id, true));
+
+        // 缩小时写回并归还数据区的内存，再次扩大后重新读入
+        EXPECT_EQ(4, bpm->resize(4));
+        EXPECT_EQ(1024, bpm->resize(1024));
+        for (auto &page_id : page_ids) {
+            auto page = bpm->fetch_page(page_id);
+            ASSERT_NE(nullptr, page);
+            EXPECT_EQ(std::to_string(page_id.page_no), page->get_data());
+            EXPECT_TRUE(bpm->unpin_page(page_id, false));
+        }
+        bpm->flush_all_pages(fd);
+    }
+}
+
+TEST_F(BufferPoolManagerConcurrencyTest, DirectIoTest) {
+    auto disk_manager = BufferPoolManagerConcurrencyTest::disk_manager_.get();
+    disk_manager->close_file(fd_);
+    disk_manager->set_direct_io(true);
+    fd_ = disk_manager->open_file(TEST_FILE_NAME_CCUR);
+    int fd = fd_;
+    if (!disk_manager->is_direct_fd(fd)) {
+        GTEST_SKIP() << "O_DIRECT is not supported by the file system";
+    }
+
+    // 文件头等不对齐的部分读写经由中转缓冲区完成，页面中的其余内容保持不变
+    std::vector<char> buf(PAGE_SIZE + 1);
+    memset(buf.data(), 'a', PAGE_SIZE + 1);
+    disk_manager->write_page(fd, 0, buf.data() + 1, PAGE_SIZE);
+    disk_manager->write_page(fd, 0, "header", 6);
+    disk_manager->read_page(fd, 0, buf.data() + 1, PAGE_SIZE);
+    EXPECT_EQ("header" + std::string(PAGE_SIZE - 6, 'a'), std::string(buf.data() + 1, PAGE_SIZE));
+    char hdr[7] = {};
+    disk_manager->read_page(fd, 0, hdr, 6);
+    EXPECT_STREQ("header", hdr);
+
+    // 缓冲池的帧和写回缓冲区都已对齐，同步、异步和批量读写直接进行
+    const int num_pages = 128;
+    for (std::string engine : {"none", "io_uring"}) {
+        disk_manager->enable_async_io(engine);
+        disk_manager->set_fd2pageno(fd, 1);
+        auto bpm = std::make_unique<BufferPoolManager>(16, disk_manager, 2);
+        std::vector<PageId> page_ids;
+        for (int i = 1; i < num_pages; i++) {
+            PageId page_id = {.fd = fd, .page_no = INVALID_PAGE_ID};
+            auto page = bpm->new_page(&page_id);
+            ASSERT_NE(nullptr, page);
+            snprintf(page->get_data(), PAGE_SIZE, "%s %d", engine.c_str(), page_id.page_no);
+            EXPECT_TRUE(bpm->unpin_page(page_id, true));
+            page_ids.push_back(page_id);
+        }
+        bpm->flush_all_pages(fd);
+        for (size_t i = 0; i < page_ids.size(); i += 8) {
+            std::vector<PageId> ids(page_ids.begin() + i, page_ids.begin() + std::min(i + 8, page_ids.size()));
+            auto pages = bpm->fetch_pages(ids);
+            for (size_t j = 0; j < ids.size(); j++) {
+                ASSERT_NE(nullptr, pages[j]);
+                EXPECT_EQ(engine + " " + std::to_string(ids[j].page_no), pages[j]->get_data());
+                EXPECT_TRUE(bpm->unpin_page(ids[j], false));
+            }
+        }
+    }
+    disk_manager->enable_async_io("none");
+
+    // 不对齐的缓冲区批量读写时逐页中转
+    std::vector<char> bufs(2 * PAGE_SIZE + 1);
+    char *pages[2] = {bufs.data() + 1, bufs.data() + 1 + PAGE_SIZE};
+    disk_manager->read_pages(fd, 1, pages, 2);
+    EXPECT_STREQ("io_uring 1", pages[0]);
+    EXPECT_STREQ("io_uring 2", pages[1]);
+    disk_manager->write_pages(fd, 3, pages, 2);
+    disk_manager->read_page(fd, 4, buf.data() + 1, PAGE_SIZE);
+    EXPECT_STREQ("io_uring 2", buf.data() + 1);
+}
+
+TEST_F(BufferPoolManagerConcurrencyTest, DirectIoBenchmark) {
+    const int num_pages = 4096;
+    const int num_fetches = 8192;
+
+    auto disk_manager = BufferPoolManagerConcurrencyTest::disk_manager_.get();
+    std::vector<char> buf(PAGE_SIZE);
+    for (int i = 0; i < num_pages; i++) {
+        snprintf(buf.data(), PAGE_SIZE, "%d", i);
+        disk_manager->write_page(fd_, i, buf.data(), PAGE_SIZE);
+    }
+    disk_manager->set_fd2pageno(fd_, num_pages);
+
+    // 80%的访问落在20%的页面上
+    std::mt19937 rng(0);
+    std::vector<int> order(num_fetches);
+    for (auto &page_no : order) {
+        page_no = rng() % 5 < 4 ? rng() % (num_pages / 5) : rng() % num_pages;
+    }
+
+    // 统计文件在操作系统页缓存中的页面个数，即被重复缓存的内存
+    auto cached_pages = [&](int fd) {
+        size_t len = 1ul * num_pages * PAGE_SIZE;
+        void *addr = mmap(nullptr, len, PROT_READ, MAP_SHARED, fd, 0);
+        if (addr == MAP_FAILED) return 0;
+        std::vector<unsigned char> vec((len + getpagesize() - 1) / getpagesize());
+        int num = 0;
+        if (mincore(addr, len, vec.data()) == 0) {
+            for (auto v : vec) num += v & 1;
+        }
+        munmap(addr, len);
+        return num;
+    };
+
+    auto run = [&](bool direct, size_t pool_size) {
+        disk_manager->close_file(fd_);
+        disk_manager->set_direct_io(direct);
+        fd_ = disk_manager->open_file(TEST_FILE_NAME_CCUR);
+        fsync(fd_);
+        posix_fadvise(fd_, 0, 0, POSIX_FADV_DONTNEED);
+        auto bpm = std::make_unique<BufferPoolManager>(pool_size, disk_manager, 4);
+        auto start = std::chrono::steady_clock::now();
+        for (int page_no : order) {
+            PageId page_id = {fd_, page_no};
+            auto page = bpm->fetch_page(page_id);
+            ASSERT_NE(nullptr, page);
+            EXPECT_EQ(std::to_string(page_no), page->get_data());
+            bpm->unpin_page(page_id, false);
+        }
+        auto ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        std::cout << (direct && disk_manager->is_direct_fd(fd_) ? "direct  " : "buffered") << " pool/data 1/"
+                  << num_pages / pool_size << ": " << ms << " ms, page cache " << cached_pages(fd_) << " pages"
+                  << std::endl;
+    };
+    for (size_t pool_size : {num_pages / 16, num_pages / 4, num_pages / 1}) {
+        run(false, pool_size);
+        run(true, pool_size);
+    }
+}
+
+TEST_F(BufferPoolManagerConcurrencyTest, WarmupTest) {
+    const int num_pages = 256;
+
+    int fd = BufferPoolManagerConcurrencyTest::fd_;
+    auto disk_manager = BufferPoolManagerConcurrencyTest::disk_manager_.get();
+    std::vector<char> buf(PAGE_SIZE);
+    for (int i = 0; i < num_pages; i++) {
+        snprintf(buf.data(), PAGE_SIZE, "%d", i);
+        disk_manager->write_page(fd, i, buf.data(), PAGE_SIZE);
+    }
+    auto touch = [](BufferPoolManager *bpm, PageId page_id) {
+        auto page = bpm->fetch_page(page_id);
+        ASSERT_NE(nullptr, page);
+        EXPECT_EQ(std::to_string(page_id.page_no), page->get_data());
+        EXPECT_TRUE(bpm->unpin_page(page_id, false));
+    };
+
+    // 最近访问的页面最热，被固定的页面排在最前
+    auto bpm = std::make_unique<BufferPoolManager>(64, disk_manager, 1, "LRU");
+    for (int i = 0; i < num_pages; i++) touch(bpm.get(), PageId{fd, i});
+    auto pinned = bpm->fetch_page(PageId{fd, 0});
+    auto hot_pages = bpm->get_hot_pages();
+    ASSERT_EQ(64, hot_pages.size());
+    EXPECT_EQ(0, hot_pages[0].page_no);
+    for (int i = 1; i < 64; i++) EXPECT_EQ(num_pages - i, hot_pages[i].page_no);
+    bpm->unpin_page(pinned->get_page_id(), false);
+    bpm.reset();
+
+    // 按快照预热后，访问这些页面全部命中预读的页面
+    bpm = std::make_unique<BufferPoolManager>(64, disk_manager, 4);
+    bpm->start_warmup(hot_pages);
+    for (int i = 0; i < 1000 && bpm->get_num_warmed_pages() < hot_pages.size(); i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    bpm->stop_warmup();
+    EXPECT_EQ(hot_pages.size(), bpm->get_num_warmed_pages());
+    for (auto &page_id : hot_pages) touch(bpm.get(), page_id);
+    EXPECT_EQ(hot_pages.size(), bpm->get_read_ahead_stats().hits);
+    bpm.reset();
+
+    // 预热只使用空闲帧，限速时可以随时取消
+    bpm = std::make_unique<BufferPoolManager>(16, disk_manager, 1);
+    std::vector<PageId> page_ids;
+    for (int i = 0; i < num_pages; i++) page_ids.push_back(PageId{fd, i});
+    auto start = std::chrono::steady_clock::now();
+    bpm->start_warmup(page_ids, 1);
+    bpm->stop_warmup();
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(1));
+    EXPECT_LE(bpm->get_num_warmed_pages(), 16);
+    bpm->start_warmup(page_ids);
+    bpm->stop_warmup();
+    EXPECT_LE(bpm->get_num_warmed_pages(), 16);
+    bpm.reset();
+
+    // 页面集中在一个分区时，该分区没有空闲帧后跳过其余页面，不淘汰其中已有的页面，其他分区照常预热
+    bpm = std::make_unique<BufferPoolManager>(16, disk_manager, 4);
+    std::vector<PageId> resident, skewed, others;
+    for (int i = 0; i < num_pages; i++) {
+        PageId page_id{fd, i};
+        if (bpm->get_partition_id(page_id) != 0) {
+            if (others.size() < 4) others.push_back(page_id);
+        } else if (resident.size() < 4) {
+            resident.push_back(page_id);
+        } else {
+            skewed.push_back(page_id);
+        }
+    }
+    ASSERT_EQ(4, resident.size());
+    ASSERT_EQ(4, others.size());
+    ASSERT_GE(skewed.size(), 8);
+    for (auto &page_id : resident) touch(bpm.get(), page_id);
+    page_ids = skewed;
+    page_ids.insert(page_ids.end(), others.begin(), others.end());
+    bpm->start_warmup(page_ids);
+    for (int i = 0; i < 1000 && bpm->get_num_warmed_pages() < others.size(); i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    bpm->stop_warmup();
+    bpm->wait_async_io();
+    EXPECT_EQ(others.size(), bpm->get_num_warmed_pages());
+    auto partition = bpm->partitions_[0].get();
+    for (auto &page_id : resident) EXPECT_EQ(1, partition->page_table_.count(page_id));
+    for (auto &page_id : skewed) EXPECT_EQ(0, partition->page_table_.count(page_id));
+    for (auto &page_id : others) touch(bpm.get(), page_id);
+    EXPECT_EQ(others.size(), bpm->get_read_ahead_stats().hits);
+}
+
 // TODO: fix detected memory leaks found by Google Test
 TEST(StorageTest, SimpleTest) {
     srand((unsigned)time(nullptr));
@@ -568,6 +1867,40 @@ TEST(StorageTest, SimpleTest) {
     }
 }
 
+TEST(BitmapTest, WordSearchTest) {
+    // 位的编号顺序与磁盘上的格式一致：第0位是第0个字节的最高位
+    char bm[600];
+    Bitmap::init(bm, sizeof(bm));
+    Bitmap::set(bm, 0);
+    Bitmap::set(bm, 9);
+    EXPECT_EQ('\x80', bm[0]);
+    EXPECT_EQ('\x40', bm[1]);
+
+    std::mt19937 rng(0);
+    for (int max_n : {1, 7, 63, 64, 65, 200, 255, 256, 257, 1000, 4096, 4800}) {
+        // 稀疏、稠密和随机三种位图，与逐位查找的结果比较
+        for (int density : {1, 50, 99}) {
+            int num_bytes = (max_n + BITMAP_WIDTH - 1) / BITMAP_WIDTH;
+            Bitmap::init(bm, num_bytes);
+            int num_set = 0;
+            for (int i = 0; i < max_n; i++) {
+                if (static_cast<int>(rng() % 100) < density) {
+                    Bitmap::set(bm, i);
+                    num_set++;
+                }
+            }
+            EXPECT_EQ(num_set, Bitmap::count(bm, max_n));
+            for (bool bit : {false, true}) {
+                for (int curr = -1; curr < max_n; curr++) {
+                    int expected = curr + 1;
+                    while (expected < max_n && Bitmap::is_set(bm, expected) != bit) expected++;
+                    ASSERT_EQ(expected, Bitmap::next_bit(bit, bm, max_n, curr)) << max_n << " " << curr;
+                }
+            }
+        }
+    }
+}
+
 TEST(RecordManagerTest, SimpleTest) {
     srand((unsigned)time(nullptr));
 
@@ -662,3 +1995,578 @@ TEST(RecordManagerTest, SimpleTest) {
     rm_manager->close_file(file_handle.get());
     rm_manager->destroy_file(filename);
 }
+
+TEST(RecordManagerTest, FreeSpaceMapTest) {
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(256, disk_manager.get());
+    auto rm_manager = std::make_unique<RmManager>(disk_manager.get(), buffer_pool_manager.get());
+
+    std::string filename = "fsm.txt";
+    if (disk_manager->is_file(filename)) {
+        disk_manager->destroy_file(filename);
+    }
+    rm_manager->create_file(filename, 256);
+    auto file_handle = rm_manager->open_file(filename);
+    const int num_data_pages = 40;
+    int num_records_per_page = file_handle->file_hdr_.num_records_per_page;
+
+    std::unordered_map<Rid, std::string, rid_hash_t, rid_equal_t> mock;
+    std::vector<int> data_pages;
+    char write_buf[PAGE_SIZE];
+    for (int i = 0; i < num_data_pages * num_records_per_page; i++) {
+        rand_buf(file_handle->file_hdr_.record_size, write_buf);
+        Rid rid = file_handle->insert_record(write_buf, nullptr);
+        mock[rid] = std::string(write_buf, file_handle->file_hdr_.record_size);
+        if (data_pages.empty() || data_pages.back() != rid.page_no) data_pages.push_back(rid.page_no);
+    }
+    ASSERT_EQ(num_data_pages, (int)data_pages.size());
+    // 映射页也占用文件中的页面
+    int num_pages = file_handle->file_hdr_.num_pages;
+    EXPECT_EQ(num_data_pages + 2, num_pages);
+
+    // 删空中间的一半数据页，扫描时这些页面被跳过
+    std::unordered_set<int> emptied(data_pages.begin() + num_data_pages / 4, data_pages.begin() + num_data_pages * 3 / 4);
+    for (auto it = mock.begin(); it != mock.end();) {
+        if (emptied.count(it->first.page_no)) {
+            file_handle->delete_record(it->first, nullptr);
+            it = mock.erase(it);
+        } else {
+            it++;
+        }
+    }
+    auto check_fsm = [&]() {
+        for (int page_no : data_pages) {
+            EXPECT_EQ(emptied.count(page_no) == 0, file_handle->may_have_records(page_no)) << page_no;
+        }
+        check_equal(file_handle.get(), mock);
+    };
+    check_fsm();
+
+    // 空闲空间映射随文件持久化
+    rm_manager->close_file(file_handle.get());
+    file_handle = rm_manager->open_file(filename);
+    check_fsm();
+
+    // 删空的页面被重新利用，文件不再增长
+    for (size_t i = 0; i < emptied.size() * num_records_per_page; i++) {
+        rand_buf(file_handle->file_hdr_.record_size, write_buf);
+        Rid rid = file_handle->insert_record(write_buf, nullptr);
+        EXPECT_TRUE(emptied.count(rid.page_no));
+        mock[rid] = std::string(write_buf, file_handle->file_hdr_.record_size);
+    }
+    EXPECT_EQ(num_pages, file_handle->file_hdr_.num_pages);
+    emptied.clear();
+    check_fsm();
+
+    rm_manager->close_file(file_handle.get());
+    rm_manager->destroy_file(filename);
+}
+
+TEST(RecordManagerTest, LegacyHeaderTest) {
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(256, disk_manager.get());
+    auto rm_manager = std::make_unique<RmManager>(disk_manager.get(), buffer_pool_manager.get());
+
+    std::string filename = "legacy_hdr.txt";
+    if (disk_manager->is_file(filename)) {
+        disk_manager->destroy_file(filename);
+    }
+    // 旧版本的文件头只有前6个字段共24字节，建表后没有插入过记录的文件只有这24字节
+    rm_manager->create_file(filename, 16);
+    ASSERT_EQ(0, truncate(filename.c_str(), 6 * sizeof(int)));
+
+    auto file_handle = rm_manager->open_file(filename);
+    EXPECT_EQ(16, file_handle->file_hdr_.record_size);
+    EXPECT_EQ(1, file_handle->file_hdr_.num_pages);
+    EXPECT_EQ(RM_FSM_DISABLED, file_handle->file_hdr_.first_fsm_page_no);
+    EXPECT_EQ(RM_FORMAT_FIXED, file_handle->file_hdr_.format);
+
+    // 不维护空闲空间映射的文件仍然可以正常读写
+    std::unordered_map<Rid, std::string, rid_hash_t, rid_equal_t> mock;
+    char write_buf[PAGE_SIZE];
+    for (int i = 0; i < 2 * file_handle->file_hdr_.num_records_per_page; i++) {
+        rand_buf(file_handle->file_hdr_.record_size, write_buf);
+        Rid rid = file_handle->insert_record(write_buf, nullptr);
+        mock[rid] = std::string(write_buf, file_handle->file_hdr_.record_size);
+    }
+    check_equal(file_handle.get(), mock);
+    rm_manager->close_file(file_handle.get());
+    file_handle = rm_manager->open_file(filename);
+    EXPECT_EQ(RM_FSM_DISABLED, file_handle->file_hdr_.first_fsm_page_no);
+    check_equal(file_handle.get(), mock);
+
+    rm_manager->close_file(file_handle.get());
+    rm_manager->destroy_file(filename);
+}
+
+TEST(RecordManagerTest, PageScanTest) {
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(256, disk_manager.get());
+    auto rm_manager = std::make_unique<RmManager>(disk_manager.get(), buffer_pool_manager.get());
+
+    std::string filename = "page_scan.txt";
+    if (disk_manager->is_file(filename)) {
+        disk_manager->destroy_file(filename);
+    }
+    rm_manager->create_file(filename, 100);
+    auto file_handle = rm_manager->open_file(filename);
+    int record_size = file_handle->file_hdr_.record_size;
+    int num_records_per_page = file_handle->file_hdr_.num_records_per_page;
+
+    // 随机删除记录，使页面中的记录不连续
+    std::unordered_map<Rid, std::string, rid_hash_t, rid_equal_t> mock;
+    char write_buf[PAGE_SIZE];
+    for (int i = 0; i < 10 * num_records_per_page; i++) {
+        rand_buf(record_size, write_buf);
+        Rid rid = file_handle->insert_record(write_buf, nullptr);
+        mock[rid] = std::string(write_buf, record_size);
+    }
+    std::mt19937 rng(0);
+    for (auto it = mock.begin(); it != mock.end();) {
+        if (rng() % 3 == 0) {
+            file_handle->delete_record(it->first, nullptr);
+            it = mock.erase(it);
+        } else {
+            it++;
+        }
+    }
+
+    // 每个批次对应一个页面，slot递增，记录内容与逐条读取一致
+    RmPageScan page_scan(file_handle.get());
+    RmPageBatch batch;
+    size_t num_records = 0;
+    int last_page_no = RM_NO_PAGE;
+    while (page_scan.next_page(&batch)) {
+        EXPECT_GT(batch.page_no, last_page_no);
+        last_page_no = batch.page_no;
+        ASSERT_GT(batch.size(), 0);
+        for (size_t i = 0; i < batch.size(); i++) {
+            if (i > 0) {
+                EXPECT_LT(batch.slots[i - 1], batch.slots[i]);
+            }
+            ASSERT_EQ(1, mock.count(batch.rid(i)));
+            EXPECT_EQ(mock[batch.rid(i)], std::string(batch.record(i), record_size));
+        }
+        num_records += batch.size();
+    }
+    EXPECT_EQ(mock.size(), num_records);
+
+    num_records = 0;
+    for (RmScan scan(file_handle.get()); !scan.is_end(); scan.next()) {
+        EXPECT_EQ(mock[scan.rid()], std::string(scan.record(), scan.record_size()));
+        num_records++;
+    }
+    EXPECT_EQ(mock.size(), num_records);
+
+    rm_manager->close_file(file_handle.get());
+    rm_manager->destroy_file(filename);
+}
+
+TEST(RecordManagerTest, RecordViewTest) {
+    // 缓冲池只有8个frame，视图没有释放pin时，访问更多页面会因为没有可用的frame而失败
+    const size_t pool_size = 8;
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(pool_size, disk_manager.get());
+    auto rm_manager = std::make_unique<RmManager>(disk_manager.get(), buffer_pool_manager.get());
+
+    std::string filename = "record_view.txt";
+    if (disk_manager->is_file(filename)) {
+        disk_manager->destroy_file(filename);
+    }
+    rm_manager->create_file(filename, 100);
+    auto file_handle = rm_manager->open_file(filename);
+    int record_size = file_handle->file_hdr_.record_size;
+    int num_records_per_page = file_handle->file_hdr_.num_records_per_page;
+
+    std::vector<std::pair<Rid, std::string>> mock;
+    char write_buf[PAGE_SIZE];
+    for (int i = 0; i < 4 * (int)pool_size * num_records_per_page; i++) {
+        rand_buf(record_size, write_buf);
+        Rid rid = file_handle->insert_record(write_buf, nullptr);
+        mock.emplace_back(rid, std::string(write_buf, record_size));
+    }
+
+    // 视图的内容与记录一致，离开作用域后页面被unpin
+    for (auto &entry : mock) {
+        auto view = file_handle->get_record_view(entry.first, nullptr);
+        ASSERT_TRUE(view.valid());
+        EXPECT_EQ(record_size, view.size());
+        EXPECT_EQ(entry.second, std::string(view.data(), view.size()));
+    }
+
+    // 移动后只由目标视图持有pin；release后拷贝出的记录仍然有效
+    for (auto &entry : mock) {
+        auto view = file_handle->get_record_view(entry.first, nullptr);
+        RecordView moved = std::move(view);
+        EXPECT_FALSE(view.valid());
+        auto rec = moved.to_record();
+        moved.release();
+        EXPECT_FALSE(moved.valid());
+        EXPECT_EQ(entry.second, std::string(rec->data, rec->size));
+    }
+
+    // 同时持有多个视图
+    {
+        std::vector<RecordView> views;
+        for (size_t i = 0; i < pool_size; i++) {
+            views.push_back(file_handle->get_record_view(mock[i * num_records_per_page].first, nullptr));
+        }
+        for (size_t i = 0; i < pool_size; i++) {
+            EXPECT_EQ(mock[i * num_records_per_page].second, std::string(views[i].data(), views[i].size()));
+        }
+    }
+    for (auto &entry : mock) {
+        EXPECT_EQ(entry.second, std::string(file_handle->get_record(entry.first, nullptr)->data, record_size));
+    }
+
+    rm_manager->close_file(file_handle.get());
+    rm_manager->destroy_file(filename);
+}
+
+TEST(RecordManagerTest, SlottedPageTest) {
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(BUFFER_POOL_SIZE, disk_manager.get());
+    auto rm_manager = std::make_unique<RmManager>(disk_manager.get(), buffer_pool_manager.get());
+
+    std::string filename = "slotted_page.txt";
+    if (disk_manager->is_file(filename)) {
+        disk_manager->destroy_file(filename);
+    }
+    // int + VARCHAR(200) + int
+    const int var_len = 200;
+    const int record_size = 2 * sizeof(int) + var_len;
+    rm_manager->create_file(filename, record_size, {RmVarField{sizeof(int), var_len}});
+    auto file_handle = rm_manager->open_file(filename);
+    ASSERT_TRUE(file_handle->is_slotted());
+
+    auto make_record = [&](char *buf, int str_len) {
+        memset(buf, 0, record_size);
+        *reinterpret_cast<int *>(buf) = rand();
+        for (int i = 0; i < str_len; i++) buf[sizeof(int) + i] = 'a' + rand() % 26;
+        *reinterpret_cast<int *>(buf + sizeof(int) + var_len) = rand();
+    };
+
+    // 短字符串只占用实际长度，页面数远少于定长格式
+    const int num_records = 2000;
+    std::unordered_map<Rid, std::string, rid_hash_t, rid_equal_t> mock;
+    std::vector<Rid> rids;
+    char buf[PAGE_SIZE];
+    for (int i = 0; i < num_records; i++) {
+        make_record(buf, rand() % 20);
+        Rid rid = file_handle->insert_record(buf, nullptr);
+        mock[rid] = std::string(buf, record_size);
+        rids.push_back(rid);
+    }
+    int fixed_per_page = (PAGE_SIZE - 64) / record_size;
+    EXPECT_LT(file_handle->get_file_hdr().num_pages, num_records / fixed_per_page / 3);
+    check_equal(file_handle.get(), mock);
+
+    // 变长后原页面放不下的记录迁移到其他页面，记录号保持不变
+    for (int i = 0; i < num_records; i += 3) {
+        make_record(buf, var_len);
+        file_handle->update_record(rids[i], buf, nullptr);
+        mock[rids[i]] = std::string(buf, record_size);
+    }
+    check_equal(file_handle.get(), mock);
+    for (int i = 0; i < num_records; i += 3) {
+        EXPECT_EQ(mock[rids[i]], std::string(file_handle->get_record_view(rids[i], nullptr).data(), record_size));
+    }
+
+    // 删除记录，包括迁移后的记录
+    for (int i = 0; i < num_records; i += 2) {
+        file_handle->delete_record(rids[i], nullptr);
+        mock.erase(rids[i]);
+    }
+    check_equal(file_handle.get(), mock);
+
+    // 再次插入时复用删除后的空间，并在需要时整理页面
+    int num_pages = file_handle->get_file_hdr().num_pages;
+    for (int i = 0; i < num_records / 4; i++) {
+        make_record(buf, rand() % 40);
+        mock[file_handle->insert_record(buf, nullptr)] = std::string(buf, record_size);
+    }
+    EXPECT_EQ(num_pages, file_handle->get_file_hdr().num_pages);
+    check_equal(file_handle.get(), mock);
+
+    // 回滚时在指定位置插入记录
+    Rid rid = mock.begin()->first;
+    file_handle->delete_record(rid, nullptr);
+    make_record(buf, var_len);
+    file_handle->insert_record(rid, buf);
+    mock[rid] = std::string(buf, record_size);
+    check_equal(file_handle.get(), mock);
+
+    // 重新打开文件后格式信息仍然有效
+    rm_manager->close_file(file_handle.get());
+    file_handle = rm_manager->open_file(filename);
+    EXPECT_TRUE(file_handle->is_slotted());
+    check_equal(file_handle.get(), mock);
+
+    rm_manager->close_file(file_handle.get());
+    rm_manager->destroy_file(filename);
+}
+
+TEST(RecordManagerTest, BatchInsertTest) {
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(BUFFER_POOL_SIZE, disk_manager.get());
+    auto rm_manager = std::make_unique<RmManager>(disk_manager.get(), buffer_pool_manager.get());
+
+    const int record_size = 64;
+    for (bool slotted : {false, true}) {
+        std::string filename = "batch_insert.txt";
+        if (disk_manager->is_file(filename)) {
+            disk_manager->destroy_file(filename);
+        }
+        std::vector<RmVarField> var_fields;
+        if (slotted) var_fields.push_back(RmVarField{0, record_size / 2});
+        rm_manager->create_file(filename, record_size, var_fields);
+        auto file_handle = rm_manager->open_file(filename);
+
+        std::unordered_map<Rid, std::string, rid_hash_t, rid_equal_t> mock;
+        std::vector<std::vector<char>> data;
+        auto insert_batch = [&](int n) {
+            data.assign(n, std::vector<char>(record_size));
+            std::vector<char *> bufs;
+            for (auto &rec : data) {
+                rand_buf(record_size, rec.data());
+                bufs.push_back(rec.data());
+            }
+            auto rids = file_handle->insert_records(bufs, nullptr);
+            ASSERT_EQ(bufs.size(), rids.size());
+            for (int i = 0; i < n; i++) {
+                ASSERT_EQ(0u, mock.count(rids[i]));
+                mock[rids[i]] = std::string(bufs[i], record_size);
+            }
+        };
+
+        // 一批记录跨越多个页面
+        insert_batch(1000);
+        check_equal(file_handle.get(), mock);
+
+        // 删除后再次批量插入，先填满已有页面中的空闲位置
+        int num_pages = file_handle->get_file_hdr().num_pages;
+        std::vector<Rid> deleted;
+        for (auto &entry : mock) {
+            if (rand() % 2) deleted.push_back(entry.first);
+        }
+        for (auto &rid : deleted) {
+            file_handle->delete_record(rid, nullptr);
+            mock.erase(rid);
+        }
+        insert_batch(deleted.size());
+        EXPECT_EQ(num_pages, file_handle->get_file_hdr().num_pages);
+        check_equal(file_handle.get(), mock);
+
+        rm_manager->close_file(file_handle.get());
+        rm_manager->destroy_file(filename);
+    }
+}
+
+TEST(RecordManagerTest, ArenaTest) {
+    Arena arena(1024);
+
+    // 分配的内存按要求对齐，互不重叠
+    char *a = arena.allocate(10);
+    char *b = arena.allocate(100, 8);
+    EXPECT_EQ(0, reinterpret_cast<uintptr_t>(a) % alignof(std::max_align_t));
+    EXPECT_EQ(0, reinterpret_cast<uintptr_t>(b) % 8);
+    EXPECT_GE(b, a + 10);
+    memset(a, 'a', 10);
+    memset(b, 'b', 100);
+    EXPECT_EQ(1024, arena.bytes_reserved());
+
+    // 回退之后复用同一段内存，不再申请新的内存块
+    auto mark = arena.mark();
+    char *c = arena.allocate(500);
+    char *first = nullptr;
+    for (int i = 0; i < 100; i++) {
+        ArenaScope scope(arena);
+        char *row = arena.allocate(200);
+        if (first == nullptr) first = row;
+        EXPECT_EQ(first, row);
+        EXPECT_GE(row, c + 500);
+    }
+    arena.rewind(mark);
+    EXPECT_EQ(c, arena.allocate(500));
+    EXPECT_EQ(1024, arena.bytes_reserved());
+
+    // 放不下时使用新的内存块，超过块大小的分配单独占用一个内存块
+    char *d = arena.allocate(600);
+    char *e = arena.allocate(4096);
+    memset(d, 'd', 600);
+    memset(e, 'e', 4096);
+    EXPECT_EQ(1024 + 1024 + 4096, arena.bytes_reserved());
+    EXPECT_EQ(std::string(10, 'a'), std::string(a, 10));
+    EXPECT_EQ(std::string(100, 'b'), std::string(b, 100));
+    arena.reset();
+    EXPECT_EQ(a, arena.allocate(10));
+    EXPECT_EQ(1024 + 1024 + 4096, arena.bytes_reserved());
+
+    // arena中的记录拷贝出来之后不依赖arena
+    RmRecord rec(16, "0123456789abcdef", &arena);
+    RmRecord copy = rec;
+    RmRecord assigned;
+    assigned = rec;
+    memset(rec.data, 0, rec.size);
+    EXPECT_EQ("0123456789abcdef", std::string(copy.data, copy.size));
+    EXPECT_EQ("0123456789abcdef", std::string(assigned.data, assigned.size));
+}
+
+TEST(LogRecordTest, PageDeltaTest) {
+    char old_page[PAGE_SIZE];
+    char new_page[PAGE_SIZE];
+    for (int i = 0; i < PAGE_SIZE; i++) old_page[i] = static_cast<char>(i * 7);
+    memmove(new_page, old_page, PAGE_SIZE);
+
+    // 相距较近的修改合并为一个区间，相距较远的修改分为不同的区间
+    new_page[3] ^= 1;
+    new_page[6] ^= 1;
+    memset(new_page + 1000, 'x', 32);
+    new_page[PAGE_SIZE - 1] ^= 1;
+    PageDeltaLogRecord rec(1, INVALID_LSN, 7, 5, old_page, new_page, PAGE_SIZE);
+    ASSERT_EQ(3, rec.ranges.size());
+    EXPECT_EQ(3, rec.ranges[0].offset);
+    EXPECT_EQ(4, rec.ranges[0].len);
+    EXPECT_EQ(PAGE_SIZE - 1, rec.ranges[2].offset);
+
+    // 差异日志远小于同时包含修改前后两个完整页面的页面日志
+    PageLogRecord page_log(1, INVALID_LSN, 7, 5, old_page);
+    page_log.set_new_page(new_page);
+    EXPECT_LT(rec.log_tot_len_ * 20, page_log.log_tot_len_);
+
+    // 序列化后再反序列化，redo和undo分别得到修改后和修改前的内容
+    std::vector<char> buf(rec.log_tot_len_);
+    rec.serialize(buf.data());
+    PageDeltaLogRecord copy;
+    copy.deserialize(buf.data());
+    EXPECT_EQ(rec.log_tot_len_, copy.log_tot_len_);
+    EXPECT_EQ(7, copy.log_oid_);
+    EXPECT_EQ(5, copy.page_no);
+    ASSERT_EQ(rec.ranges.size(), copy.ranges.size());
+
+    char page[PAGE_SIZE];
+    memmove(page, old_page, PAGE_SIZE);
+    copy.redo(page);
+    EXPECT_EQ(0, memcmp(page, new_page, PAGE_SIZE));
+    copy.undo(page);
+    EXPECT_EQ(0, memcmp(page, old_page, PAGE_SIZE));
+
+    // 内容没有变化时不产生任何区间
+    PageDeltaLogRecord empty(1, INVALID_LSN, 7, 5, old_page, old_page, PAGE_SIZE);
+    EXPECT_TRUE(empty.ranges.empty());
+}
+
+TEST(LogRecordTest, ObjectIdTest) {
+    // 目录为表和索引分配的对象ID随元数据一起保存，删除对象后ID不会复用
+    DbMeta db;
+    std::stringstream empty_db("oid_db 1\n0\n");
+    empty_db >> db;
+    TabMeta tab;
+    tab.name = "oid_table";
+    tab.oid = db.alloc_oid();
+    ColMeta col = {.tab_name = "oid_table", .name = "id", .type = TYPE_INT, .len = 4, .offset = 0, .index = true};
+    tab.cols.push_back(col);
+    IndexMeta index;
+    index.tab_name = "oid_table";
+    index.oid = db.alloc_oid();
+    index.col_tot_len = 4;
+    index.col_num = 1;
+    index.cols.push_back(col);
+    tab.indexes.push_back(index);
+    db.SetTabMeta(tab.name, tab);
+    EXPECT_NE(INVALID_OID, tab.oid);
+    EXPECT_NE(tab.oid, index.oid);
+
+    std::stringstream ss;
+    ss << db;
+    DbMeta loaded;
+    ss >> loaded;
+    ASSERT_NE(nullptr, loaded.get_table(tab.oid));
+    EXPECT_EQ("oid_table", loaded.get_table(tab.oid)->name);
+    ASSERT_NE(nullptr, loaded.get_index(index.oid));
+    EXPECT_EQ("oid_table", loaded.get_index(index.oid)->tab_name);
+    EXPECT_EQ(nullptr, loaded.get_table(index.oid));
+    EXPECT_GT(loaded.alloc_oid(), index.oid);
+
+    // 日志记录在定长的日志头中携带对象ID，不再包含表名
+    char data[8] = "0123456";
+    RmRecord value(8, data);
+    Rid rid{3, 5};
+    InsertLogRecord rec(1, INVALID_LSN, value, rid, tab.oid);
+    EXPECT_EQ(LOG_HEADER_SIZE + sizeof(int) + 8 + sizeof(Rid) + sizeof(lsn_t), rec.log_tot_len_);
+    std::vector<char> buf(rec.log_tot_len_);
+    rec.serialize(buf.data());
+    InsertLogRecord copy;
+    copy.deserialize(buf.data());
+    EXPECT_EQ(tab.oid, copy.log_oid_);
+    EXPECT_EQ(rid, copy.rid_);
+    EXPECT_EQ(std::string(data, 8), std::string(copy.insert_value_.data, copy.insert_value_.size));
+}
+
+TEST(RecoveryTest, NewPageRedoTest) {
+    const std::string db_name = "recovery_test_db";
+    const int num_records = 10;
+    const std::vector<std::string> tables = {"fixed_tab", "slotted_tab"};
+    std::unordered_map<std::string, std::unordered_map<Rid, std::string, rid_hash_t, rid_equal_t>> mocks;
+
+    // 在新表中插入记录并提交，只有日志持久化，页面和文件头都不写回，模拟崩溃
+    auto disk_manager = std::make_unique<DiskManager>();
+    {
+        auto bpm = std::make_unique<BufferPoolManager>(256, disk_manager.get());
+        auto rm_manager = std::make_unique<RmManager>(disk_manager.get(), bpm.get());
+        auto ix_manager = std::make_unique<IxManager>(disk_manager.get(), bpm.get());
+        auto sm_manager = std::make_unique<SmManager>(disk_manager.get(), bpm.get(), rm_manager.get(), ix_manager.get());
+        if (sm_manager->is_dir(db_name)) sm_manager->drop_db(db_name);
+        sm_manager->create_db(db_name);
+        sm_manager->open_db(db_name);
+        sm_manager->create_table(tables[0], {{"id", TYPE_INT, 4}, {"s", TYPE_STRING, 16}}, nullptr);
+        sm_manager->create_table(tables[1], {{"id", TYPE_INT, 4}, {"s", TYPE_STRING, 16, true}}, nullptr);
+
+        LockManager lock_manager;
+        auto log_manager = std::make_unique<LogManager>(disk_manager.get());
+        TransactionManager txn_manager(&lock_manager, sm_manager.get(), bpm.get());
+        auto txn = txn_manager.begin(nullptr, log_manager.get());
+        Context context(&lock_manager, log_manager.get(), txn);
+        for (auto &table : tables) {
+            auto file_handle = sm_manager->fhs_.at(table).get();
+            for (int i = 0; i < num_records; i++) {
+                char buf[20] = {};
+                memcpy(buf, &i, sizeof(int));
+                snprintf(buf + sizeof(int), 16, "r%d", i);
+                Rid rid = file_handle->insert_record(buf, &context);
+                mocks[table][rid] = std::string(buf, sizeof(buf));
+            }
+        }
+        txn_manager.commit(txn, log_manager.get());
+        ASSERT_EQ(0, chdir(".."));
+    }
+
+    // 重新打开数据库并重做日志，新页面的页头必须由日志恢复
+    auto disk_manager2 = std::make_unique<DiskManager>();
+    auto bpm = std::make_unique<BufferPoolManager>(256, disk_manager2.get());
+    auto rm_manager = std::make_unique<RmManager>(disk_manager2.get(), bpm.get());
+    auto ix_manager = std::make_unique<IxManager>(disk_manager2.get(), bpm.get());
+    auto sm_manager = std::make_unique<SmManager>(disk_manager2.get(), bpm.get(), rm_manager.get(), ix_manager.get());
+    sm_manager->open_db(db_name);
+    RecoveryManager recovery(disk_manager2.get(), bpm.get(), sm_manager.get());
+    recovery.analyze();
+    recovery.redo();
+    recovery.undo();
+    for (auto &table : tables) {
+        auto file_handle = sm_manager->fhs_.at(table).get();
+        auto &mock = mocks[table];
+        Rid rid = mock.begin()->first;
+        auto page_handle = file_handle->fetch_page_handle(rid.page_no);
+        EXPECT_EQ(RM_NO_PAGE, page_handle.page_hdr->next_free_page_no) << table;
+        EXPECT_EQ(num_records, page_handle.page_hdr->num_records) << table;
+        if (file_handle->is_slotted()) {
+            EXPECT_GT(page_handle.slotted_hdr()->data_begin, RM_SLOT_DIR_OFFSET);
+            EXPECT_GT(page_handle.slotted_hdr()->free_bytes, 0);
+        }
+        bpm->unpin_page(page_handle.page->get_page_id(), false);
+        EXPECT_EQ(rid.page_no, file_handle->file_hdr_.first_free_page_no) << table;
+        check_equal(file_handle, mock);
+    }
+    sm_manager->close_db();
+    sm_manager->drop_db(db_name);
+}